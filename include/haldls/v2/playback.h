@@ -81,6 +81,14 @@ public:
 	std::vector<std::vector<instruction_word_type> > const& instruction_byte_blocks() const
 		SYMBOL_VISIBLE;
 
+	/**
+	 * Get estimated runtime of the program in FPGA clock cycles.
+	 * The estimate is the sum of all waits of the program, the execution time of all other
+	 * instructions is neglected.
+	 * @return Number of clock cycles
+	 */
+	hardware_time_type get_runtime_estimate() const SYMBOL_VISIBLE;
+
 	/**
 	 * Get information on whether the program stores valid executable instructions.
 	 * @return Boolean value
@@ -17,7 +17,6 @@ class OmnibusChipOverJTAG;
 } // namespace fisch::vx
 
 namespace lola::vx {
-class SynapseMatrix;
 class SynapseRow;
 } // namespace lola::vx
 
@@ -209,7 +208,6 @@ public:
 		void serialize(Archive& ar);
 		// used for direct member access without function calls
 		friend class SynapseQuad;
-		friend struct haldls::vx::detail::VisitPreorderImpl<lola::vx::SynapseMatrix>;
 		friend struct haldls::vx::detail::VisitPreorderImpl<lola::vx::SynapseRow>;
 
 		Weight m_weight;
@@ -244,7 +242,6 @@ private:
 	template <class Archive>
 	void serialize(Archive& ar) SYMBOL_VISIBLE;
 	// used for direct member access without function calls
-	friend struct haldls::vx::detail::VisitPreorderImpl<lola::vx::SynapseMatrix>;
 	friend struct haldls::vx::detail::VisitPreorderImpl<lola::vx::SynapseRow>;
 
 	halco::common::typed_array<Synapse, halco::hicann_dls::vx::EntryOnQuad> m_synapses;
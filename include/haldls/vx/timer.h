@@ -42,6 +42,12 @@ public:
 	 */
 	explicit Timer(Value value = Value()) SYMBOL_VISIBLE;
 
+	/**
+	 * Get timer value.
+	 * @return Value
+	 */
+	Value get() const SYMBOL_VISIBLE;
+
 	/**
 	 * Set timer value.
 	 * @param value Value to set
@@ -16,6 +16,13 @@ namespace haldls::vx GENPYBIND_TAG_HALDLS_VX {
 class GENPYBIND(visible) DifferentialWriteTrait
 {};
 
+/**
+ * Trait signalling derived-from container type may be written without producing any words, e.g.
+ * a sparse container without entries.
+ */
+class GENPYBIND(visible) SparseWriteTrait
+{};
+
 /**
  * Possible backends to target with PlaybackProgramBuilder::read/write.
  */
@@ -1,5 +1,8 @@
 #pragma once
+#include <utility>
+#include <vector>
 #include <boost/hana/adapt_struct.hpp>
+#include "halco/common/typed_array.h"
 #include "halco/common/typed_heap_array.h"
 #include "haldls/vx/common.h"
 #include "haldls/vx/synapse.h"
@@ -57,7 +60,7 @@ public:
 	friend std::ostream& operator<<(std::ostream& os, SynapseRow const& row) SYMBOL_VISIBLE;
 
 	GENPYBIND_MANUAL({
-		auto to_numpy_template = [parent](auto const& self) {
+		auto to_numpy_template = [](auto const& self) {
 			auto ret = pybind11::array_t<typename std::remove_reference<
 			    typename std::remove_cv<decltype(self)>::type>::type::value_type::value_type>(
 			    ::halco::hicann_dls::vx::SynapseOnSynapseRow::size);
@@ -71,7 +74,7 @@ public:
 			return ret;
 		};
 
-		auto from_numpy_template = [parent](
+		auto from_numpy_template = [](
 		                               auto& self,
 		                               pybind11::array_t<typename std::remove_reference<decltype(
 		                                   self)>::type::value_type::value_type> array) {
@@ -166,19 +169,30 @@ private:
 class GENPYBIND(visible) SynapseMatrix : public haldls::vx::DifferentialWriteTrait
 {
 public:
-	typedef std::false_type has_local_data;
 	typedef halco::hicann_dls::vx::SynramOnDLS coordinate_type;
+	typedef std::true_type is_leaf_node;
+
+	template <typename T>
+	using row_type = halco::common::typed_array<T, halco::hicann_dls::vx::SynapseOnSynapseRow>;
 
+	/**
+	 * Dense row-major matrix in a single heap allocation.
+	 * Rows are stored inline, which places all synapses of a matrix contiguously in memory.
+	 */
 	template <typename T>
-	using matrix_type = halco::common::typed_heap_array<
-	    halco::common::typed_heap_array<T, halco::hicann_dls::vx::SynapseOnSynapseRow>,
-	    halco::hicann_dls::vx::SynapseRowOnSynram>;
+	using matrix_type =
+	    halco::common::typed_heap_array<row_type<T>, halco::hicann_dls::vx::SynapseRowOnSynram>;
 
 	typedef haldls::vx::SynapseQuad::Synapse::Weight Weight GENPYBIND(visible);
 	typedef haldls::vx::SynapseQuad::Synapse::Address Address GENPYBIND(visible);
 	typedef haldls::vx::SynapseQuad::Synapse::TimeCalib TimeCalib GENPYBIND(visible);
 	typedef haldls::vx::SynapseQuad::Synapse::AmpCalib AmpCalib GENPYBIND(visible);
 
+	typedef row_type<Weight> _weights_row_type GENPYBIND(opaque);
+	typedef row_type<Address> _addresses_row_type GENPYBIND(opaque);
+	typedef row_type<TimeCalib> _time_calibs_row_type GENPYBIND(opaque);
+	typedef row_type<AmpCalib> _amp_calibs_row_type GENPYBIND(opaque);
+
 	typedef matrix_type<Weight> _weights_type GENPYBIND(opaque);
 	typedef matrix_type<Address> _addresses_type GENPYBIND(opaque);
 	typedef matrix_type<TimeCalib> _time_calibs_type GENPYBIND(opaque);
@@ -205,117 +219,322 @@ public:
 	GENPYBIND(stringstream)
 	friend std::ostream& operator<<(std::ostream& os, SynapseMatrix const& row) SYMBOL_VISIBLE;
 
+	/** Number of words of the matrix, those of all synapse quads in row-major order. */
+	static size_t constexpr config_size_in_words GENPYBIND(hidden) =
+	    haldls::vx::SynapseQuad::config_size_in_words *
+	    halco::hicann_dls::vx::SynapseQuadOnSynram::size;
+
+	/**
+	 * Get addresses of all synapse quads.
+	 * Read and write addresses are equal, they are not named addresses() to not collide with the
+	 * address matrix member.
+	 * @tparam AddressT Address type
+	 * @param coord Location of matrix
+	 * @return Addresses of quads in row-major order, two per quad
+	 */
+	template <typename AddressT>
+	static std::vector<AddressT> read_addresses(coordinate_type const& coord) SYMBOL_VISIBLE
+	    GENPYBIND(hidden);
+	template <typename AddressT>
+	static std::vector<AddressT> write_addresses(coordinate_type const& coord) SYMBOL_VISIBLE
+	    GENPYBIND(hidden);
+
+	/**
+	 * Encode all synapse quads in bulk.
+	 * The words are bit-exact to encoding every quad as haldls::vx::SynapseQuad, but are
+	 * generated directly from the matrices via lookup tables without quad temporaries.
+	 * @tparam WordT Word type
+	 * @return Words in order of write_addresses()
+	 */
+	template <typename WordT>
+	std::vector<WordT> encode() const SYMBOL_VISIBLE GENPYBIND(hidden);
+
+	/**
+	 * Decode all synapse quads in bulk.
+	 * @tparam WordT Word type
+	 * @param data Pointer to config_size_in_words contiguous words in order of read_addresses()
+	 */
+	template <typename WordT>
+	void decode(WordT const* data) SYMBOL_VISIBLE GENPYBIND(hidden);
+
 	GENPYBIND_MANUAL({
-		auto to_numpy_template = [parent](auto const& self) {
+		typedef ::halco::hicann_dls::vx::SynapseRowOnSynram _row_coordinate_type;
+		typedef ::halco::hicann_dls::vx::SynapseOnSynapseRow _column_coordinate_type;
+
+		// rows are contiguous, therefore the complete matrix is accessed via its first element
+		auto data_template = [](auto& self) {
+			typedef typename std::remove_reference<decltype(self)>::type::value_type::value_type
+			    _element_type;
+			typedef typename _element_type::value_type _raw_type;
+			static_assert(
+			    sizeof(_element_type) == sizeof(_raw_type) &&
+			        std::is_standard_layout<_element_type>::value,
+			    "Matrix elements need to be layout-compatible to their raw value.");
+			auto& first = self[_row_coordinate_type(0)][_column_coordinate_type(0)];
+			return reinterpret_cast<typename std::conditional<
+			    std::is_const<typename std::remove_reference<decltype(first)>::type>::value,
+			    _raw_type const, _raw_type>::type*>(&first);
+		};
+
+		auto to_numpy_template = [data_template](auto const& self) {
 			typedef typename std::remove_reference<typename std::remove_cv<decltype(self)>::type>::
 			    type::value_type::value_type::value_type value_type;
-			auto ret =
-			    pybind11::array_t<value_type>({::halco::hicann_dls::vx::SynapseOnSynapseRow::size,
-			                                   ::halco::hicann_dls::vx::SynapseRowOnSynram::size});
-			auto access = ret.template mutable_unchecked<2>();
-			for (auto row :
-			     ::halco::common::iter_all<::halco::hicann_dls::vx::SynapseRowOnSynram>()) {
-				for (auto col :
-				     ::halco::common::iter_all<::halco::hicann_dls::vx::SynapseOnSynapseRow>()) {
-					access(static_cast<size_t>(row.toEnum()), static_cast<size_t>(col.toEnum())) =
-					    self[row][col];
-				}
-			}
+			// copies contiguous matrix in a single pass
+			return pybind11::array_t<value_type>(
+			    {_row_coordinate_type::size, _column_coordinate_type::size}, data_template(self));
+		};
+
+		auto array_template = [data_template](auto const& self, pybind11::object owner) {
+			typedef typename std::remove_reference<typename std::remove_cv<decltype(self)>::type>::
+			    type::value_type::value_type::value_type value_type;
+			// read-only view sharing the memory of the matrix and keeping its owner alive
+			pybind11::array_t<value_type> ret(
+			    {_row_coordinate_type::size, _column_coordinate_type::size}, data_template(self),
+			    owner);
+			ret.attr("setflags")(pybind11::arg("write") = false);
 			return ret;
 		};
 
-		auto from_numpy_template = [parent](
-		                               auto& self,
-		                               pybind11::array_t<typename std::remove_reference<decltype(
-		                                   self)>::type::value_type::value_type::value_type>
-		                                   array) {
+		auto from_numpy_template = [data_template](auto& self, auto const& array) {
+			typedef typename std::remove_reference<decltype(self)>::type::value_type::value_type
+			    _element_type;
 			if (array.ndim() != 2) {
 				throw std::runtime_error("Number of dimensions to assign to matrix must be two.");
 			}
-			auto access = array.template mutable_unchecked<2>();
-			if (access.shape(0) != ::halco::hicann_dls::vx::SynapseRowOnSynram::size ||
-			    access.shape(1) != ::halco::hicann_dls::vx::SynapseOnSynapseRow::size) {
+			if (array.shape(0) != _row_coordinate_type::size ||
+			    array.shape(1) != _column_coordinate_type::size) {
 				throw std::runtime_error("Input shape does not match.");
 			}
-			for (auto row :
-			     ::halco::common::iter_all<::halco::hicann_dls::vx::SynapseRowOnSynram>()) {
-				for (auto col :
-				     ::halco::common::iter_all<::halco::hicann_dls::vx::SynapseOnSynapseRow>()) {
-					self[row][col] = typename std::remove_reference<decltype(self)>::type::
-					    value_type::value_type(access(
-					        static_cast<size_t>(row.toEnum()), static_cast<size_t>(col.toEnum())));
-				}
+			// validate range of all values before assigning any
+			auto const max = std::max_element(array.data(), array.data() + array.size());
+			static_cast<void>(_element_type(*max));
+			std::copy(array.data(), array.data() + array.size(), data_template(self));
+		};
+
+		auto row_to_numpy_template = [](auto const& self) {
+			typedef typename std::remove_reference<typename std::remove_cv<decltype(self)>::type>::
+			    type::value_type::value_type value_type;
+			pybind11::array_t<value_type> ret(_column_coordinate_type::size);
+			auto access = ret.mutable_unchecked();
+			for (auto coord : ::halco::common::iter_all<_column_coordinate_type>()) {
+				access[coord.toEnum()] = self[coord];
 			}
+			return ret;
 		};
 
-		{
-			auto attr = parent.attr("_weights_type");
-			auto ism = parent->py::is_method(attr);
+		auto row_from_numpy_template = [](
+		                                   auto& self,
+		                                   pybind11::array_t<typename std::remove_reference<
+		                                       decltype(self)>::type::value_type::value_type>
+		                                       array) {
+			if (array.ndim() != 1) {
+				throw std::runtime_error("Number of dimensions to assign to row must be one.");
+			}
+			if (array.size() != _column_coordinate_type::size) {
+				throw std::runtime_error("Input shape does not match.");
+			}
+			auto access = array.mutable_unchecked();
+			for (auto coord : ::halco::common::iter_all<_column_coordinate_type>()) {
+				self[coord] = typename std::remove_reference<decltype(self)>::type::value_type(
+				    access[coord.toEnum()]);
+			}
+		};
 
-			typedef ::lola::vx::SynapseMatrix::_weights_type _values_type;
-			attr.attr("to_numpy") = parent->py::cpp_function(
-			    [to_numpy_template](_values_type const& self) { return to_numpy_template(self); },
-			    ism);
-			attr.attr("from_numpy") = parent->py::cpp_function(
-			    [from_numpy_template](
-			        _values_type& self,
-			        pybind11::array_t<_values_type::value_type::value_type::value_type> array) {
-				    from_numpy_template(self, array);
-			    },
-			    ism);
-		}
-		{
-			auto attr = parent.attr("_addresses_type");
-			auto ism = parent->py::is_method(attr);
+#define LOLA_SYNAPSE_MATRIX_NUMPY(Name)                                                            \
+	{                                                                                              \
+		auto attr = parent.attr("_" #Name "_type");                                                \
+		auto ism = parent->py::is_method(attr);                                                    \
+                                                                                                   \
+		typedef ::lola::vx::SynapseMatrix::_##Name##_type _values_type;                            \
+		typedef _values_type::value_type::value_type::value_type _raw_type;                        \
+		attr.attr("to_numpy") = parent->py::cpp_function(                                          \
+		    [to_numpy_template](_values_type const& self) { return to_numpy_template(self); },     \
+		    ism);                                                                                  \
+		attr.attr("from_numpy") = parent->py::cpp_function(                                        \
+		    [from_numpy_template](                                                                 \
+		        _values_type& self,                                                                \
+		        pybind11::array_t<                                                                 \
+		            _raw_type, pybind11::array::c_style | pybind11::array::forcecast>              \
+		            array) { from_numpy_template(self, array); },                                  \
+		    ism);                                                                                  \
+		attr.attr("__array__") = parent->py::cpp_function(                                         \
+		    [array_template](                                                                      \
+		        pybind11::object self, pybind11::object dtype, pybind11::object /* copy */) {      \
+			    auto ret = array_template(self.cast<_values_type const&>(), self);                 \
+			    if (!dtype.is_none()) {                                                            \
+				    return pybind11::array(ret.attr("astype")(dtype));                             \
+			    }                                                                                  \
+			    return pybind11::array(ret);                                                       \
+		    },                                                                                     \
+		    ism, pybind11::arg("dtype") = pybind11::none(),                                        \
+		    pybind11::arg("copy") = pybind11::none());                                             \
+	}                                                                                              \
+	{                                                                                              \
+		auto attr = parent.attr("_" #Name "_row_type");                                            \
+		auto ism = parent->py::is_method(attr);                                                    \
+                                                                                                   \
+		typedef ::lola::vx::SynapseMatrix::_##Name##_row_type _values_type;                        \
+		attr.attr("to_numpy") = parent->py::cpp_function(                                          \
+		    [row_to_numpy_template](_values_type const& self) {                                    \
+			    return row_to_numpy_template(self);                                                \
+		    },                                                                                     \
+		    ism);                                                                                  \
+		attr.attr("from_numpy") = parent->py::cpp_function(                                        \
+		    [row_from_numpy_template](                                                             \
+		        _values_type& self,                                                                \
+		        pybind11::array_t<_values_type::value_type::value_type> array) {                   \
+			    row_from_numpy_template(self, array);                                              \
+		    },                                                                                     \
+		    ism);                                                                                  \
+	}
 
-			typedef ::lola::vx::SynapseMatrix::_addresses_type _values_type;
-			attr.attr("to_numpy") = parent->py::cpp_function(
-			    [to_numpy_template](_values_type const& self) { return to_numpy_template(self); },
-			    ism);
-			attr.attr("from_numpy") = parent->py::cpp_function(
-			    [from_numpy_template](
-			        _values_type& self,
-			        pybind11::array_t<_values_type::value_type::value_type::value_type> array) {
-				    from_numpy_template(self, array);
-			    },
-			    ism);
-		}
-		{
-			auto attr = parent.attr("_time_calibs_type");
-			auto ism = parent->py::is_method(attr);
+		LOLA_SYNAPSE_MATRIX_NUMPY(weights)
+		LOLA_SYNAPSE_MATRIX_NUMPY(addresses)
+		LOLA_SYNAPSE_MATRIX_NUMPY(time_calibs)
+		LOLA_SYNAPSE_MATRIX_NUMPY(amp_calibs)
+#undef LOLA_SYNAPSE_MATRIX_NUMPY
+	})
+};
 
-			typedef ::lola::vx::SynapseMatrix::_time_calibs_type _values_type;
-			attr.attr("to_numpy") = parent->py::cpp_function(
-			    [to_numpy_template](_values_type const& self) { return to_numpy_template(self); },
-			    ism);
-			attr.attr("from_numpy") = parent->py::cpp_function(
-			    [from_numpy_template](
-			        _values_type& self,
-			        pybind11::array_t<_values_type::value_type::value_type::value_type> array) {
-				    from_numpy_template(self, array);
-			    },
-			    ism);
-		}
-		{
-			auto attr = parent.attr("_amp_calibs_type");
-			auto ism = parent->py::is_method(attr);
+/**
+ * Location of a SynapseMatrixDelta, i.e. the synram the changes apply to.
+ * A separate coordinate type is needed since reads are selected by coordinate type and
+ * SynramOnDLS already selects the SynapseMatrix.
+ */
+struct GENPYBIND(inline_base("*")) SynapseMatrixDeltaOnDLS
+    : public halco::common::detail::RantWrapper<
+          SynapseMatrixDeltaOnDLS,
+          uint_fast16_t,
+          halco::hicann_dls::vx::SynramOnDLS::max,
+          halco::hicann_dls::vx::SynramOnDLS::min>
+{
+	constexpr explicit SynapseMatrixDeltaOnDLS(uintmax_t const val = 0)
+	    GENPYBIND(implicit_conversion) SYMBOL_VISIBLE : rant_t(val)
+	{}
 
-			typedef ::lola::vx::SynapseMatrix::_amp_calibs_type _values_type;
-			attr.attr("to_numpy") = parent->py::cpp_function(
-			    [to_numpy_template](_values_type const& self) { return to_numpy_template(self); },
-			    ism);
-			attr.attr("from_numpy") = parent->py::cpp_function(
-			    [from_numpy_template](
-			        _values_type& self,
-			        pybind11::array_t<_values_type::value_type::value_type::value_type> array) {
-				    from_numpy_template(self, array);
-			    },
-			    ism);
-		}
-	})
+	halco::hicann_dls::vx::SynramOnDLS toSynramOnDLS() const SYMBOL_VISIBLE
+	{
+		return halco::hicann_dls::vx::SynramOnDLS(value());
+	}
+};
+
+/**
+ * Sparse set of changes to the synapses of a synram.
+ * Changes are stored as sorted list of affected synapse quads, since a quad is the smallest unit
+ * written to the hardware and always comprises all four of its synapses.
+ * Writing the delta only emits the words of the affected quads instead of the complete matrix.
+ * Changes to single synapses are recorded relative to a known state of the synram, from which the
+ * unchanged synapses of an affected quad are taken.
+ */
+class GENPYBIND(visible) SynapseMatrixDelta
+    : public haldls::vx::DifferentialWriteTrait
+    , public haldls::vx::SparseWriteTrait
+{
+public:
+	typedef std::false_type has_local_data;
+	typedef SynapseMatrixDeltaOnDLS coordinate_type;
+
+	typedef haldls::vx::SynapseQuad::Synapse Synapse;
+	typedef std::vector<halco::hicann_dls::vx::SynapseQuadOnSynram> quads_type;
+
+	/** Default constructor without changes. */
+	SynapseMatrixDelta() SYMBOL_VISIBLE;
+
+	/**
+	 * Construct delta of all quads differing between two states of a synram.
+	 * @param base State before the change
+	 * @param target State after the change
+	 */
+	SynapseMatrixDelta(SynapseMatrix const& base, SynapseMatrix const& target) SYMBOL_VISIBLE;
+
+	/**
+	 * Set single synapse.
+	 * If the quad of the synapse is not yet affected by the delta, its other synapses are taken
+	 * from the given state.
+	 * @param base State of the synram the delta is applied to
+	 * @param row Row of synapse
+	 * @param column Column of synapse
+	 * @param value Synapse value
+	 */
+	void set(
+	    SynapseMatrix const& base,
+	    halco::hicann_dls::vx::SynapseRowOnSynram const& row,
+	    halco::hicann_dls::vx::SynapseOnSynapseRow const& column,
+	    Synapse const& value) SYMBOL_VISIBLE;
+
+	/**
+	 * Set complete quad.
+	 * @param coord Quad on synram
+	 * @param value Quad value
+	 */
+	void set(
+	    halco::hicann_dls::vx::SynapseQuadOnSynram const& coord,
+	    haldls::vx::SynapseQuad const& value) SYMBOL_VISIBLE;
+
+	/**
+	 * Get value of affected quad.
+	 * @param coord Quad on synram
+	 * @return Quad value
+	 * @throws std::out_of_range On quad not being affected by the delta
+	 */
+	haldls::vx::SynapseQuad get(halco::hicann_dls::vx::SynapseQuadOnSynram const& coord) const
+	    SYMBOL_VISIBLE;
+
+	/**
+	 * Get affected quads in ascending order, which is the order they are written in.
+	 * @return Quad coordinates
+	 */
+	quads_type get_quads() const SYMBOL_VISIBLE;
+
+	/**
+	 * Get number of affected quads.
+	 * @return Number of quads
+	 */
+	size_t size() const SYMBOL_VISIBLE;
+
+	/**
+	 * Get whether the delta contains no changes.
+	 * @return Boolean value
+	 */
+	bool empty() const SYMBOL_VISIBLE;
+
+	/** Drop all changes. */
+	void clear() SYMBOL_VISIBLE;
+
+	/**
+	 * Apply changes to matrix.
+	 * @param matrix Matrix to alter
+	 */
+	void apply(SynapseMatrix& matrix) const SYMBOL_VISIBLE;
+
+	bool operator==(SynapseMatrixDelta const& other) const SYMBOL_VISIBLE;
+	bool operator!=(SynapseMatrixDelta const& other) const SYMBOL_VISIBLE;
+
+	GENPYBIND(stringstream)
+	friend std::ostream& operator<<(std::ostream& os, SynapseMatrixDelta const& delta)
+	    SYMBOL_VISIBLE;
 
 private:
-	friend struct haldls::vx::detail::VisitPreorderImpl<SynapseMatrix>;
+	friend struct haldls::vx::detail::VisitPreorderImpl<SynapseMatrixDelta>;
+	friend class cereal::access;
+
+	template <typename Archive>
+	void serialize(Archive& ar) SYMBOL_VISIBLE;
+
+	typedef std::pair<halco::hicann_dls::vx::SynapseQuadOnSynram, haldls::vx::SynapseQuad>
+	    entry_type;
+
+	/**
+	 * Get entry of quad, inserted at sorted position with given value if not yet present.
+	 * @param coord Quad on synram
+	 * @param value Value of quad to use on insertion
+	 * @return Reference to entry
+	 */
+	entry_type& find_or_insert(
+	    halco::hicann_dls::vx::SynapseQuadOnSynram const& coord, haldls::vx::SynapseQuad value);
+
+	/** Affected quads sorted by coordinate. */
+	std::vector<entry_type> m_quads;
 };
 
 /**
@@ -411,44 +630,29 @@ struct BackendContainerTrait<lola::vx::SynapseMatrix>
 {};
 
 template <>
-struct VisitPreorderImpl<lola::vx::SynapseMatrix>
+struct BackendContainerTrait<lola::vx::SynapseMatrixDelta>
+    : public BackendContainerBase<
+          lola::vx::SynapseMatrixDelta,
+          fisch::vx::OmnibusChip,
+          fisch::vx::OmnibusChipOverJTAG>
+{};
+
+template <>
+struct VisitPreorderImpl<lola::vx::SynapseMatrixDelta>
 {
 	template <typename ContainerT, typename VisitorT>
 	static void call(
 	    ContainerT& config,
-	    lola::vx::SynapseMatrix::coordinate_type const& coord,
+	    lola::vx::SynapseMatrixDelta::coordinate_type const& coord,
 	    VisitorT&& visitor)
 	{
-		using halco::common::iter_all;
 		using namespace halco::hicann_dls::vx;
 
 		visitor(coord, config);
 
-		for (auto const row : iter_all<SynapseRowOnSynram>()) {
-			for (auto const quad : iter_all<SynapseQuadColumnOnDLS>()) {
-				haldls::vx::SynapseQuad quad_config;
-				for (auto const syn : iter_all<EntryOnQuad>()) {
-					SynapseOnSynapseRow const syn_on_row(syn, quad);
-					auto& syn_config = quad_config.m_synapses[syn];
-					syn_config.m_weight = config.weights[row][syn_on_row];
-					syn_config.m_address = config.addresses[row][syn_on_row];
-					syn_config.m_time_calib = config.time_calibs[row][syn_on_row];
-					syn_config.m_amp_calib = config.amp_calibs[row][syn_on_row];
-				}
-				visit_preorder(
-				    quad_config, SynapseQuadOnDLS(SynapseQuadOnSynram(quad, row), coord), visitor);
-				// only on alteration
-				if constexpr (!std::is_same<ContainerT, lola::vx::SynapseMatrix const>::value) {
-					for (auto const syn : iter_all<EntryOnQuad>()) {
-						SynapseOnSynapseRow const syn_on_row(syn, quad);
-						auto const& syn_config = quad_config.m_synapses[syn];
-						config.weights[row][syn_on_row] = syn_config.m_weight;
-						config.addresses[row][syn_on_row] = syn_config.m_address;
-						config.time_calibs[row][syn_on_row] = syn_config.m_time_calib;
-						config.amp_calibs[row][syn_on_row] = syn_config.m_amp_calib;
-					}
-				}
-			}
+		for (auto& [quad, quad_config] : config.m_quads) {
+			visit_preorder(
+			    quad_config, SynapseQuadOnDLS(quad, coord.toSynramOnDLS()), visitor);
 		}
 	}
 };
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "haldls/v2/common.h"
+#include "hate/visibility.h"
+
+namespace stadls {
+namespace v2 {
+
+/// \brief byte blocks of a program stored in a single contiguous buffer
+/// Block i spans the bytes [block_offsets[i], block_offsets[i + 1]), i.e. there is one more offset
+/// than blocks and the last offset equals the number of bytes.
+struct FlatProgramBytes
+{
+	typedef std::vector<haldls::v2::instruction_word_type> bytes_type;
+	typedef std::vector<bytes_type> blocks_type;
+
+	/// \brief creates empty program without blocks
+	FlatProgramBytes() SYMBOL_VISIBLE;
+	/// \brief copies blocks into contiguous buffer
+	explicit FlatProgramBytes(blocks_type const& blocks) SYMBOL_VISIBLE;
+
+	size_t num_blocks() const SYMBOL_VISIBLE;
+	haldls::v2::instruction_word_type const* block_data(size_t block) const SYMBOL_VISIBLE;
+	size_t block_size(size_t block) const SYMBOL_VISIBLE;
+
+	/// \brief copies blocks out of contiguous buffer
+	blocks_type to_blocks() const SYMBOL_VISIBLE;
+
+	bool operator==(FlatProgramBytes const& other) const SYMBOL_VISIBLE;
+	bool operator!=(FlatProgramBytes const& other) const SYMBOL_VISIBLE;
+
+	bytes_type bytes;
+	std::vector<uint64_t> block_offsets;
+};
+
+} // namespace v2
+} // namespace stadls
@@ -11,6 +11,7 @@
 #include "haldls/v2/playback.h"
 #include "hate/visibility.h"
 #include "hate/optional.h"
+#include "stadls/v2/flat_program_bytes.h"
 #include "stadls/v2/genpybind.h"
 
 namespace stadls {
@@ -47,6 +48,26 @@ std::shared_ptr<haldls::v2::PlaybackProgram> get_configure_program(haldls::v2::C
 class GENPYBIND(visible) LocalBoardControl
 {
 public:
+	/// \brief timing of program executions
+	struct GENPYBIND(visible) ExecuteStatistics
+	{
+		/// \brief number of executions since construction or last reset
+		size_t num_executions = 0;
+		/// \brief runtime predicted for the last execution, zero if unknown
+		std::chrono::microseconds last_predicted_runtime{0};
+		/// \brief time from start until the end of the last execution was observed
+		std::chrono::microseconds last_observed_runtime{0};
+		/// \brief upper bound of the time between the end of the last execution and its
+		///        observation, i.e. the time since the previous check of the execute flag
+		std::chrono::microseconds last_latency{0};
+		/// \brief number of checks of the execute flag in the last execution
+		size_t last_num_polls = 0;
+		/// \brief sum of latencies of all executions not overlapped with transfers
+		std::chrono::microseconds total_latency{0};
+		/// \brief learnt difference between observed runtime and runtime estimate of programs
+		std::chrono::microseconds runtime_correction{0};
+	};
+
 	/// \brief creates Flyspi communication object and calls soft_reset
 	LocalBoardControl(std::string const& usb_serial_number) SYMBOL_VISIBLE;
 
@@ -80,6 +101,10 @@ public:
 		std::vector<haldls::v2::ocp_word_type> const& board_words,
 		std::vector<std::vector<haldls::v2::instruction_word_type> > const& chip_program_bytes)
 		SYMBOL_VISIBLE;
+	void configure_static(
+		std::vector<haldls::v2::ocp_address_type> const& board_addresses,
+		std::vector<haldls::v2::ocp_word_type> const& board_words,
+		FlatProgramBytes const& chip_program_bytes) SYMBOL_VISIBLE GENPYBIND(hidden);
 	void configure_static(haldls::v2::Board const& board, haldls::v2::Chip const& chip)
 		SYMBOL_VISIBLE;
 
@@ -87,10 +112,19 @@ public:
 	///        registers
 	void transfer(std::vector<std::vector<haldls::v2::instruction_word_type> > const& program_bytes)
 		SYMBOL_VISIBLE;
+	/// \param runtime_estimate Estimated runtime in FPGA clock cycles used by execute(), if known
+	void transfer(
+		FlatProgramBytes const& program_bytes,
+		hate::optional<haldls::v2::hardware_time_type> runtime_estimate = hate::nullopt)
+		SYMBOL_VISIBLE GENPYBIND(hidden);
 	void transfer(std::shared_ptr<haldls::v2::PlaybackProgram> const& playback_program)
 	    SYMBOL_VISIBLE;
 
 	/// \brief toggle the execute flag and wait until turned off again
+	/// If the runtime of the transferred program is known, sleeps until shortly before its
+	/// predicted end and checks the execute flag continuously around it. The prediction is the
+	/// runtime estimate of the program corrected by an exponentially weighted average of the
+	/// deviation observed in previous executions.
 	void execute() SYMBOL_VISIBLE;
 
 	/// \brief toggle the execute flag and wait until turned off again
@@ -100,11 +134,20 @@ public:
 	/// \param max_wait Maximal wait time for execute flag to clear
 	/// \param expected_runtime Time to wait until first check of execute flag
 	///        and successive checks with exponentially increasing wait time
+	/// \param spin_window Time after expected_runtime during which the execute flag is
+	///        checked without waiting in between
 	void execute(
 	    std::chrono::microseconds min_wait_period,
 	    std::chrono::microseconds max_wait_period,
 	    std::chrono::microseconds max_wait,
-	    hate::optional<std::chrono::microseconds> expected_runtime = hate::nullopt) SYMBOL_VISIBLE;
+	    hate::optional<std::chrono::microseconds> expected_runtime = hate::nullopt,
+	    std::chrono::microseconds spin_window = std::chrono::microseconds(0)) SYMBOL_VISIBLE;
+
+	/// \brief timing of executions since construction or last reset
+	ExecuteStatistics const& get_execute_statistics() const SYMBOL_VISIBLE;
+
+	/// \brief resets timing statistics and learnt runtime correction
+	void reset_execute_statistics() SYMBOL_VISIBLE;
 
 	std::vector<haldls::v2::instruction_word_type> fetch() SYMBOL_VISIBLE;
 	void fetch(std::shared_ptr<haldls::v2::PlaybackProgram> const& playback_program) SYMBOL_VISIBLE;
@@ -117,8 +160,34 @@ public:
 	std::vector<haldls::v2::instruction_word_type> run(
 		std::vector<std::vector<haldls::v2::instruction_word_type> > const& program_byte)
 		SYMBOL_VISIBLE;
+	std::vector<haldls::v2::instruction_word_type> run(
+		FlatProgramBytes const& program_bytes,
+		hate::optional<haldls::v2::hardware_time_type> runtime_estimate = hate::nullopt)
+		SYMBOL_VISIBLE GENPYBIND(hidden);
 	void run(std::shared_ptr<haldls::v2::PlaybackProgram> const& playback_program) SYMBOL_VISIBLE;
 
+	/// \brief runs programs back to back alternating between two regions of the SDRAM
+	/// While a program is executed, the next program is transferred and the results of the
+	/// previous program are fetched. Programs not fitting into half of the SDRAM are run on their
+	/// own using the complete SDRAM, the results of all other programs have to fit into half of the
+	/// SDRAM. Executions overlapped with transfers don't contribute to the learnt runtime
+	/// correction and the total latency.
+	/// The programs are not associated to a PlaybackProgram, fetch(playback_program) therefore
+	/// fails afterwards.
+	/// \param program_bytes Programs to run, have to outlive the call
+	/// \param runtime_estimates Estimated runtime in FPGA clock cycles per program, if known
+	/// \param results Result bytes per program, appended in order of the programs after clearing.
+	/// On an exception, it holds the complete results of all programs preceding the failed one.
+	void run_many(
+		std::vector<FlatProgramBytes const*> const& program_bytes,
+		std::vector<hate::optional<haldls::v2::hardware_time_type> > const& runtime_estimates,
+		std::vector<std::vector<haldls::v2::instruction_word_type> >& results)
+		SYMBOL_VISIBLE GENPYBIND(hidden);
+	/// \brief runs programs back to back and decodes their results, see above
+	void run_many(
+		std::vector<std::shared_ptr<haldls::v2::PlaybackProgram> > const& playback_programs)
+		SYMBOL_VISIBLE;
+
 	/// \brief Run experiment on given board and chip
 	void run_experiment(
 	    haldls::v2::Board const& board,
@@ -128,6 +197,41 @@ public:
 	constexpr static char const* const env_name_board_id = "SLURM_FLYSPI_ID";
 
 private:
+	/// \brief transfers program bytes to the start of the SDRAM
+	template <typename ProgramBytes>
+	void transfer_blocks(ProgramBytes const& program_bytes);
+
+	template <typename ProgramBytes>
+	void run_pipelined(
+		std::vector<ProgramBytes const*> const& programs,
+		std::vector<hate::optional<haldls::v2::hardware_time_type> > const& runtime_estimates,
+		std::vector<std::vector<haldls::v2::instruction_word_type> >& results);
+
+	/// \brief runs programs [begin, end) fitting into half of the SDRAM back to back
+	template <typename ProgramBytes>
+	void run_overlapped(
+		std::vector<ProgramBytes const*> const& programs,
+		std::vector<hate::optional<haldls::v2::hardware_time_type> > const& runtime_estimates,
+		size_t begin,
+		size_t end,
+		std::vector<std::vector<haldls::v2::instruction_word_type> >& results);
+
+	/// \brief checks that the DLS is not in reset and sets the execute flag
+	void start_execution();
+
+	/// \brief waits until the execute flag is cleared, see execute()
+	/// \param overlapped Whether transfers were performed during the execution, which delay the
+	///        observation of its end. The observed runtime is not learnt then.
+	void wait_for_execution(bool overlapped = false);
+
+	/// \brief waits until the execute flag is cleared, see execute(...)
+	void wait_for_execution(
+	    std::chrono::microseconds min_wait_period,
+	    std::chrono::microseconds max_wait_period,
+	    std::chrono::microseconds max_wait,
+	    hate::optional<std::chrono::microseconds> expected_runtime,
+	    std::chrono::microseconds spin_window = std::chrono::microseconds(0));
+
 	class Impl;
 	std::unique_ptr<Impl> m_impl;
 }; // LocalBoardControl
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <optional>
 #include <string>
@@ -8,10 +9,12 @@
 
 #include "rcf-extensions/round-robin.h"
 
+#include "hate/optional.h"
 #include "hate/visibility.h"
 
 #include "stadls/v2/genpybind.h"
 #include "stadls/v2/local_board_control.h"
+#include "stadls/v2/wire_format.h"
 
 namespace SF {
 
@@ -26,12 +29,24 @@ typedef std::vector<haldls::v2::ocp_address_type> ocp_addresses_type;
 typedef std::vector<haldls::v2::ocp_word_type> ocp_words_type;
 typedef std::vector<std::vector<haldls::v2::instruction_word_type> > program_bytes_type;
 
+// Program bytes are transmitted as wire frames (see wire_format.h) written straight to the binary
+// stream of the archive and read from it directly into a single contiguous buffer per program.
+// Only binary cereal archives are supported.
 struct QuickQueueRequest
 {
 	ocp_addresses_type board_addresses;
 	ocp_words_type board_words;
-	program_bytes_type chip_program_bytes;
-	program_bytes_type playback_program_bytes;
+	FlatProgramBytes chip_program_bytes;
+	FlatProgramBytes playback_program_bytes;
+	// runtime estimate of the playback program in FPGA clock cycles, 0 if unknown
+	haldls::v2::hardware_time_type playback_program_runtime_estimate = 0;
+	// compression of program frames on serialization, not transmitted since frames are
+	// self-describing
+	WireCompression compression = WireCompression::none;
+
+	// runtime estimate of the playback program, empty if unknown
+	hate::optional<haldls::v2::hardware_time_type> get_playback_program_runtime_estimate() const
+		SYMBOL_VISIBLE;
 
 	template <class Archive>
 	void serialize(Archive& archive)
@@ -52,6 +67,58 @@ private:
 struct QuickQueueResponse
 {
 	std::vector<haldls::v2::instruction_word_type> result_bytes;
+	// compression of result frame on serialization, not transmitted
+	WireCompression compression = WireCompression::none;
+
+	template <class Archive>
+	void serialize(Archive& archive)
+	{
+		serialize_detail<Archive>(archive, typename std::is_same<Archive, SF::Archive>::type());
+	}
+
+private:
+	// Archive is SF::Archive
+	template <class Archive>
+	void serialize_detail(Archive& archive, std::true_type) SYMBOL_VISIBLE;
+
+	// Archive is from cereal
+	template <class Archive>
+	void serialize_detail(Archive& archive, std::false_type) SYMBOL_VISIBLE;
+};
+
+// Multiple experiments executed back to back by the worker within a single remote call.
+// Equal static configuration is only loaded once if enabled on the server, see
+// QuickQueueWorker::work().
+struct QuickQueueBatchRequest
+{
+	std::vector<QuickQueueRequest> requests;
+	// compressions the client accepts for the results
+	wire_capabilities_type accepted_compressions = local_wire_capabilities();
+
+	template <class Archive>
+	void serialize(Archive& archive)
+	{
+		serialize_detail<Archive>(archive, typename std::is_same<Archive, SF::Archive>::type());
+	}
+
+private:
+	// Archive is SF::Archive
+	template <class Archive>
+	void serialize_detail(Archive& archive, std::true_type) SYMBOL_VISIBLE;
+
+	// Archive is from cereal
+	template <class Archive>
+	void serialize_detail(Archive& archive, std::false_type) SYMBOL_VISIBLE;
+};
+
+// Responses of a batch in order of the requests.
+// Failed experiments have an empty response and a non-empty error message.
+struct QuickQueueBatchResponse
+{
+	std::vector<QuickQueueResponse> responses;
+	std::vector<std::string> error_messages;
+	// compressions the server accepts for subsequent requests
+	wire_capabilities_type capabilities = local_wire_capabilities();
 
 	template <class Archive>
 	void serialize(Archive& archive)
@@ -92,18 +159,50 @@ public:
 
 	std::optional<size_t> verify_user(std::string const& user_data) SYMBOL_VISIBLE;
 
-	QuickQueueResponse work(QuickQueueRequest const&) SYMBOL_VISIBLE;
+	// Execute all experiments of the batch in order.
+	// By default, the static configuration is loaded for every experiment. Only if reuse of the
+	// static configuration is enabled (see set_reuse_static_config()), consecutive experiments
+	// with equal static configuration are configured once and run pipelined, i.e. the next
+	// program is transferred and the previous results are fetched while a program is executed.
+	// Errors of single experiments are reported per item and do not abort the batch, except for
+	// an unresponsive FPGA, on which the worker is torn down and the error is propagated. An error
+	// of pipelined experiments is reported for the failed and all subsequent experiments of the
+	// pipeline, results of the preceding experiments are returned.
+	QuickQueueBatchResponse work(QuickQueueBatchRequest const&) SYMBOL_VISIBLE;
 
 	// run whenever there are no jobs to anymore
 	void teardown() SYMBOL_VISIBLE;
 
 	// Set or unset the worker into mock-mode.
 	// If in mock-mode, no communication with any hardware is attempted and
-	// empty results are returned.
+	// empty results are returned. Requests with empty playback programs fail as on hardware.
 	void set_mock_mode(bool mode_enable) SYMBOL_VISIBLE { m_mock_mode = mode_enable; };
 
+	// Enable or disable skipping the static configuration of board and chip if it is identical to
+	// the configuration loaded by the previous request, disabled by default.
+	// Only enable if playback programs do not alter the static configuration.
+	void set_reuse_static_config(bool enable) SYMBOL_VISIBLE { m_reuse_static_config = enable; };
+
+	// Number of times the static configuration was loaded, also counted in mock-mode.
+	size_t get_num_static_configurations() const SYMBOL_VISIBLE
+	{
+		return m_num_static_configurations;
+	};
+
 private:
 	// methods
+	QuickQueueResponse work_single(QuickQueueRequest const&);
+	// Run requests [begin, end) pipelined and store their results in responses.
+	// On an error, first_failed is the index of the first request without results.
+	void work_pipelined(
+		std::vector<QuickQueueRequest> const& requests,
+		size_t begin,
+		size_t end,
+		std::vector<QuickQueueResponse>& responses,
+		size_t& first_failed);
+	void configure_static(QuickQueueRequest const&);
+	// throws like the hardware on requests which can't be executed
+	void check_mock_request(QuickQueueRequest const&);
 	std::string get_slurm_jobname() { return "board_alloc_" + get_slurm_gres(); }
 	std::string get_slurm_gres() { return m_usb_serial; }
 	void get_slurm_allocation();
@@ -118,10 +217,18 @@ private:
 
 	bool m_mock_mode;
 
+	bool m_reuse_static_config;
+	// fingerprint of the static configuration currently loaded, empty if unknown
+	std::optional<uint64_t> m_static_config_fingerprint;
+	size_t m_num_static_configurations;
+
 }; // QuickQueueWorker
 
 // generate sechduling Quick Queue Server that operates on worker
-RR_GENERATE(QuickQueueWorker, QuickQueueServer)
+// The remote interface is named after the server. Batches replaced the single request of the
+// previous QuickQueueServer interface, the new name lets clients and servers of different versions
+// fail with an unknown interface error instead of misinterpreting each other's messages.
+RR_GENERATE(QuickQueueWorker, QuickQueueBatchServer)
 
 // TODO: Decide if pImpl is really needed here! --obreitwi, 06-03-18 14:12:45
 class GENPYBIND(visible) QuickQueueClient
@@ -145,6 +252,21 @@ public:
 		haldls::v2::Chip const& chip,
 		std::shared_ptr<haldls::v2::PlaybackProgram> const& playback_program) SYMBOL_VISIBLE;
 
+	/// \brief runs multiple experiments with a single remote call
+	/// Results are decoded into the playback programs of successful experiments. The static
+	/// configuration is only encoded once for consecutive experiments with equal board and chip.
+	/// The worker loads it for every experiment, including the settling time of the CapMem,
+	/// unless the server is started with --reuse-static-config. Loading it only on change
+	/// requires playback programs to not alter the static configuration, which the client can't
+	/// verify, therefore it is opt-in by the server operator.
+	/// \return Error message per experiment, empty on success
+	/// \throws std::runtime_error On number of boards, chips and programs not matching
+	std::vector<std::string> run_experiments(
+		std::vector<haldls::v2::Board> const& boards,
+		std::vector<haldls::v2::Chip> const& chips,
+		std::vector<std::shared_ptr<haldls::v2::PlaybackProgram> > const& playback_programs)
+		SYMBOL_VISIBLE;
+
 	static int const max_message_length = 1280 * 1024 * 1024;
 	static int const remote_call_timeout = 3600 * 1000;
 
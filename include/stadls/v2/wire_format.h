@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "haldls/v2/common.h"
+#include "hate/visibility.h"
+
+#include "stadls/v2/flat_program_bytes.h"
+
+namespace stadls {
+namespace v2 {
+
+/// \brief compression of the payload of a wire frame
+enum class WireCompression : uint8_t
+{
+	none = 0,
+	lz4 = 1
+};
+
+/// \brief bit mask of supported compressions, bit n is set if WireCompression(n) is supported
+typedef uint32_t wire_capabilities_type;
+
+/// \brief compressions supported by this build, uncompressed frames are always supported
+wire_capabilities_type local_wire_capabilities() SYMBOL_VISIBLE;
+
+/// \brief selects the fastest compression supported locally and by the peer
+/// \param peer_capabilities Compressions supported by the peer
+WireCompression negotiate_wire_compression(wire_capabilities_type peer_capabilities)
+	SYMBOL_VISIBLE;
+
+/// \brief appends bytes to the stream a frame is written to
+typedef std::function<void(uint8_t const* data, size_t size)> wire_writer_type;
+
+/// \brief reads exactly the given number of bytes from the stream a frame is read from
+/// Has to throw if the stream ends before.
+typedef std::function<void(uint8_t* data, size_t size)> wire_reader_type;
+
+/// \brief writes byte blocks as flat, length-prefixed frame directly to a stream
+/// Layout in host byte order: header (magic, version, compression, number of blocks, size of all
+/// blocks, size of payload), size of every block, payload.
+/// The payload is the concatenation of all blocks, compressed as a whole. If compression does not
+/// reduce the size or is not supported by this build, the payload is stored uncompressed and
+/// written straight from the buffer of program.
+/// \param program Byte blocks to write
+/// \param compression Requested compression of the payload
+/// \param writer Stream to write to
+void write_wire_frame(
+	FlatProgramBytes const& program,
+	WireCompression compression,
+	wire_writer_type const& writer) SYMBOL_VISIBLE;
+
+/// \brief writes bytes as frame of a single block directly to a stream
+void write_wire_frame(
+	std::vector<haldls::v2::instruction_word_type> const& bytes,
+	WireCompression compression,
+	wire_writer_type const& writer) SYMBOL_VISIBLE;
+
+/// \brief reads frame from a stream directly into the contiguous buffer of program
+/// Uncompressed payloads are read straight into the buffer, compressed ones are decompressed
+/// into it.
+/// \throws std::runtime_error On malformed frame or compression not supported by this build
+void read_wire_frame(wire_reader_type const& reader, FlatProgramBytes& program) SYMBOL_VISIBLE;
+
+/// \brief reads frame from a stream into bytes, blocks are concatenated
+/// \throws std::runtime_error On malformed frame or compression not supported by this build
+void read_wire_frame(
+	wire_reader_type const& reader,
+	std::vector<haldls::v2::instruction_word_type>& bytes) SYMBOL_VISIBLE;
+
+/// \brief encodes byte blocks as frame in memory, see write_wire_frame()
+std::vector<uint8_t> encode_wire_frame(
+	FlatProgramBytes const& program, WireCompression compression) SYMBOL_VISIBLE;
+
+/// \brief encodes bytes as frame of a single block in memory
+std::vector<uint8_t> encode_wire_frame(
+	std::vector<haldls::v2::instruction_word_type> const& bytes,
+	WireCompression compression) SYMBOL_VISIBLE;
+
+/// \brief decodes frame in memory directly into the contiguous buffer of program
+/// \throws std::runtime_error On malformed frame, trailing data or compression not supported by
+/// this build
+void decode_wire_frame(std::vector<uint8_t> const& frame, FlatProgramBytes& program)
+	SYMBOL_VISIBLE;
+
+/// \brief decodes frame in memory into bytes, blocks are concatenated
+/// \throws std::runtime_error On malformed frame, trailing data or compression not supported by
+/// this build
+void decode_wire_frame(
+	std::vector<uint8_t> const& frame,
+	std::vector<haldls::v2::instruction_word_type>& bytes) SYMBOL_VISIBLE;
+
+} // namespace v2
+} // namespace stadls
@@ -125,6 +125,9 @@ struct WriteAddressVisitor
 /// \code
 /// typedef std::false_type has_local_data;
 /// \endcode
+/// Containers with a large number of words can alternatively implement a `decode` member
+/// function that accepts a pointer to `config_size_in_words` contiguous words, which requires
+/// contiguous storage of the data.
 /// \see ReadAddressVisitor, which is used to extract the addresses to read the
 ///      configuration data from.
 template <typename T>
@@ -177,6 +180,18 @@ private:
 		(container.*decode)(slice<N>());
 	}
 
+	template <typename CoordinateT, typename ContainerT>
+	void decode(
+	    CoordinateT const&, ContainerT& container, void (ContainerT::*decode)(value_type const*))
+	{
+		size_t const size = ContainerT::config_size_in_words;
+		if (size > remaining())
+			throw std::runtime_error("end of buffer during decoding");
+
+		(container.*decode)(&*m_it);
+		std::advance(m_it, size);
+	}
+
 	template <size_t N>
 	auto slice() -> std::array<value_type, N>
 	{
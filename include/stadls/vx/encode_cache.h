@@ -0,0 +1,155 @@
+#pragma once
+#include <cstddef>
+
+#include "haldls/vx/container.h"
+#include "hate/type_list.h"
+#include "hate/visibility.h"
+#include "lola/vx/container.h"
+#include "stadls/vx/genpybind.h"
+
+namespace stadls::vx GENPYBIND_TAG_STADLS_VX {
+
+namespace detail {
+
+/**
+ * Configuration containers typically written with identical content into many programs, e.g. by
+ * the InitGenerator.
+ * Encoded words of these containers are memoized by the EncodeCache.
+ */
+typedef hate::type_list<
+    haldls::vx::ShiftRegister,
+    haldls::vx::DACChannel,
+    haldls::vx::DACControl,
+    haldls::vx::JTAGClockScaler,
+    haldls::vx::CapMemBlock,
+    haldls::vx::CapMemBlockConfig,
+    haldls::vx::CommonNeuronBackendConfig,
+    haldls::vx::CommonPADIBusConfig,
+    haldls::vx::CommonSTPConfig,
+    haldls::vx::ADPLL,
+    haldls::vx::PLLClockOutputBlock,
+    haldls::vx::PLLSelfTest,
+    haldls::vx::PhyConfigFPGA,
+    haldls::vx::CommonPhyConfigFPGA,
+    haldls::vx::PhyConfigChip,
+    haldls::vx::CommonPhyConfigChip,
+    haldls::vx::SystimeSyncBase,
+    haldls::vx::CommonSynramConfig,
+    haldls::vx::CADCConfig,
+    haldls::vx::EventRecordingConfig,
+    haldls::vx::CrossbarOutputConfig,
+    haldls::vx::CrossbarNode,
+    haldls::vx::SynapseBiasSelection,
+    haldls::vx::ReferenceGeneratorConfig,
+    haldls::vx::PadMultiplexerConfig,
+    haldls::vx::ReadoutSourceSelection,
+    haldls::vx::MADCControl,
+    haldls::vx::CommonCorrelationConfig,
+    lola::vx::DACChannelBlock,
+    lola::vx::DACControlBlock>
+    EncodeCacheableContainerList;
+
+} // namespace detail
+
+/**
+ * Memoization of addresses and words of containers written via PlaybackProgramBuilder::write().
+ * Entries are stored per thread and looked up by coordinate and container equality, repeated
+ * writes of identical configuration to the same location therefore skip encoding and copy the
+ * cached words into the program instead.
+ * Only containers in detail::EncodeCacheableContainerList are cached, differential writes are not
+ * cached. The cache is disabled by default, since its benefit depends on how often identical
+ * configuration is written, see the builder benchmarks.
+ */
+class GENPYBIND(visible) EncodeCache
+{
+public:
+	/**
+	 * Cache access statistics.
+	 */
+	struct GENPYBIND(visible) Statistics
+	{
+		/** Number of writes served from the cache. */
+		size_t hits = 0;
+		/** Number of writes encoded because no matching entry was present. */
+		size_t misses = 0;
+		/** Number of cached entries. */
+		size_t size = 0;
+	};
+
+	/** Default maximal number of cached entries. */
+	static constexpr size_t default_max_size = 4096;
+
+	/**
+	 * Enable or disable usage of the cache by subsequent writes, disabled by default.
+	 * @param value Boolean value
+	 */
+	static void set_enabled(bool value) SYMBOL_VISIBLE;
+
+	/**
+	 * Get whether usage of the cache is enabled.
+	 * @return Boolean value
+	 */
+	static bool get_enabled() SYMBOL_VISIBLE;
+
+	/**
+	 * Set maximal number of cached entries summed over all threads.
+	 * Once reached, further encoded containers are not inserted until the cache is cleared.
+	 * @param value Number of entries
+	 */
+	static void set_max_size(size_t value) SYMBOL_VISIBLE;
+
+	/**
+	 * Get maximal number of cached entries.
+	 * @return Number of entries
+	 */
+	static size_t get_max_size() SYMBOL_VISIBLE;
+
+	/**
+	 * Get access statistics.
+	 * @return Statistics
+	 */
+	static Statistics get_statistics() SYMBOL_VISIBLE;
+
+	/**
+	 * Reset hit and miss counters.
+	 */
+	static void reset_statistics() SYMBOL_VISIBLE;
+
+	/**
+	 * Drop all cached entries of all threads.
+	 * Entries of other threads are dropped on their next access to the cache.
+	 */
+	static void clear() SYMBOL_VISIBLE;
+
+	/**
+	 * Get generation of the cache, which is incremented by clear().
+	 * Typed cache storages drop their entries on change of the generation.
+	 * @return Generation
+	 */
+	static size_t get_generation() SYMBOL_VISIBLE GENPYBIND(hidden);
+
+	/**
+	 * Account for dropped entries of a typed cache storage.
+	 * @param num Number of entries
+	 * @param generation Generation the entries were inserted in
+	 */
+	static void release_entries(size_t num, size_t generation) SYMBOL_VISIBLE GENPYBIND(hidden);
+
+	/**
+	 * Try to account for a new entry.
+	 * @return Whether the entry may be inserted without exceeding the maximal size
+	 */
+	static bool reserve_entry() SYMBOL_VISIBLE GENPYBIND(hidden);
+
+	/**
+	 * Count a write served from the cache.
+	 */
+	static void count_hit() SYMBOL_VISIBLE GENPYBIND(hidden);
+
+	/**
+	 * Count a write not served from the cache.
+	 */
+	static void count_miss() SYMBOL_VISIBLE GENPYBIND(hidden);
+};
+
+} // namespace stadls::vx
@@ -6,7 +6,9 @@ namespace stadls::vx GENPYBIND_TAG_STADLS_VX {
 enum class GENPYBIND(visible) ExecutorBackend
 {
 	hardware,
-	simulation
+	simulation,
+	/** In-process backend answering reads with deterministic data without execution. */
+	mock
 };
 
 } // namespace stadls::vx
@@ -0,0 +1,145 @@
+#pragma once
+#include <future>
+#include <memory>
+#include <vector>
+
+#include "hate/visibility.h"
+#include "stadls/vx/executor_backend.h"
+#include "stadls/vx/genpybind.h"
+#include "stadls/vx/playback_program_executor.h"
+
+namespace stadls::vx GENPYBIND_TAG_STADLS_VX {
+
+class PlaybackProgram;
+
+/**
+ * Pool of executors distributing independent playback programs onto multiple backends.
+ * Programs are enqueued into a common work queue and executed by the first idle backend matching
+ * the program's executable restriction.
+ */
+class GENPYBIND(visible) ExecutorPool
+{
+public:
+	typedef PlaybackProgramExecutor::ip_t ip_t;
+	typedef PlaybackProgramExecutor::port_t port_t;
+
+	/**
+	 * Utilization statistics of a single backend of the pool.
+	 */
+	struct GENPYBIND(visible) Utilization
+	{
+		/** Type of backend. */
+		ExecutorBackend backend;
+		/** Number of programs executed on backend. */
+		size_t programs;
+		/** Time spent executing programs [s]. */
+		double busy_time;
+		/** Time since backend was added to the pool [s]. */
+		double total_time;
+
+		/**
+		 * Get fraction of time spent executing programs.
+		 * @return Fraction in [0, 1]
+		 */
+		double get_fraction() const SYMBOL_VISIBLE;
+	};
+
+	/**
+	 * Construct pool without backends.
+	 */
+	ExecutorPool() SYMBOL_VISIBLE;
+
+	/** Move constructor. */
+	ExecutorPool(ExecutorPool&& other) SYMBOL_VISIBLE;
+
+	/** Copy constructor not possible with IO connection. */
+	ExecutorPool(ExecutorPool const& other) = delete;
+
+	/**
+	 * Destruct pool executing all enqueued programs and closing connections to backends.
+	 */
+	~ExecutorPool() SYMBOL_VISIBLE;
+
+	/**
+	 * Add hardware backend to pool.
+	 * @param ip IP address of ARQ backend
+	 */
+	void connect_hardware(ip_t ip) SYMBOL_VISIBLE;
+
+	/**
+	 * Add simulator backend to pool.
+	 * @param ip IP address of simulator backend
+	 * @param port Port of simulator backend
+	 */
+	void connect_simulator(ip_t ip, port_t port) SYMBOL_VISIBLE;
+
+	/**
+	 * Add in-process mock backend to pool.
+	 */
+	void connect_mock() SYMBOL_VISIBLE;
+
+	/**
+	 * Add backends found in environment to pool.
+	 * All FPGAs listed in SLURM_FPGA_IPS are added as hardware backends, if there are none a
+	 * simulator backend is searched for like in PlaybackProgramExecutor::connect().
+	 * @throws std::runtime_error On no executor backend found
+	 */
+	void connect() SYMBOL_VISIBLE;
+
+	/**
+	 * Add already connected executor to pool.
+	 * @param executor Executor to add
+	 * @throws std::runtime_error On executor not being connected to a backend
+	 */
+	void add(PlaybackProgramExecutor&& executor) GENPYBIND(hidden) SYMBOL_VISIBLE;
+
+	/**
+	 * Execute all enqueued programs and disconnect from all backends.
+	 */
+	void disconnect() SYMBOL_VISIBLE;
+
+	/**
+	 * Get number of backends in pool.
+	 * @return Number of backends
+	 */
+	size_t size() const SYMBOL_VISIBLE;
+
+	/**
+	 * Enqueue program for execution on the first idle backend matching its executable
+	 * restriction.
+	 * The enqueued program shares its instruction stream, tickets and result data with the given
+	 * program and all its copies. Executions of programs sharing this data are therefore
+	 * serialized and neither the given program, its copies nor their tickets may be accessed
+	 * until the returned future is ready.
+	 * @param program PlaybackProgram to run
+	 * @return Future of the executed program holding the results, exceptions during execution
+	 * are rethrown on get()
+	 * @throws std::runtime_error On no backend in pool matching the executable restriction
+	 */
+	std::future<PlaybackProgram> run_async(PlaybackProgram const& program) GENPYBIND(hidden)
+	    SYMBOL_VISIBLE;
+
+	/**
+	 * Execute programs distributed over all backends and block until all are finished.
+	 * The results are accessible via the tickets of the given programs.
+	 * @param programs PlaybackPrograms to run
+	 */
+	void run(std::vector<PlaybackProgram> const& programs) SYMBOL_VISIBLE;
+
+	/**
+	 * Block until all enqueued programs have finished execution.
+	 */
+	void wait_all() SYMBOL_VISIBLE;
+
+	/**
+	 * Get utilization statistics for each backend in order of addition to the pool.
+	 * @return Utilization per backend
+	 */
+	std::vector<Utilization> get_utilization() const SYMBOL_VISIBLE;
+
+private:
+	struct Impl;
+	std::unique_ptr<Impl> m_impl;
+};
+
+} // namespace stadls::vx
@@ -0,0 +1,46 @@
+#pragma once
+#include <cstddef>
+#include <string>
+
+#include "hate/visibility.h"
+
+namespace stadls::vx::detail {
+
+/**
+ * Read-only memory mapping of a file, unmapped on destruction.
+ * Mappings are private, the pages of the file are shared via the page cache between all processes
+ * mapping the same file.
+ */
+class FileMapping
+{
+public:
+	/**
+	 * Map complete file.
+	 * @param filename Path of file to map
+	 * @throws std::runtime_error On file not readable or not mappable
+	 */
+	explicit FileMapping(std::string const& filename) SYMBOL_VISIBLE;
+
+	FileMapping(FileMapping const&) = delete;
+	FileMapping& operator=(FileMapping const&) = delete;
+
+	~FileMapping() SYMBOL_VISIBLE;
+
+	/**
+	 * Get begin of mapped memory.
+	 * @return Pointer to first byte or nullptr for an empty file
+	 */
+	char const* data() const SYMBOL_VISIBLE;
+
+	/**
+	 * Get size of mapped memory.
+	 * @return Size in bytes
+	 */
+	size_t size() const SYMBOL_VISIBLE;
+
+private:
+	char const* m_data;
+	size_t m_size;
+};
+
+} // namespace stadls::vx::detail
@@ -0,0 +1,56 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+#include "haldls/vx/event.h"
+#include "hate/visibility.h"
+#include "stadls/vx/genpybind.h"
+#include "stadls/vx/result_columns.h"
+#include "stadls/vx/spike_view.h"
+
+namespace stadls::vx GENPYBIND_TAG_STADLS_VX {
+
+class PlaybackProgram;
+
+/**
+ * Minimal total number of spikes for which merge_spikes() uses multiple threads if the thread
+ * count is selected automatically.
+ */
+constexpr size_t merge_spikes_parallel_threshold GENPYBIND(visible) = 1 << 20;
+
+/**
+ * Merge spike sequences sorted by FPGA time into a single sequence sorted by FPGA time.
+ * The FPGA time of every spike is shifted by the offset of its sequence, e.g. the start time of
+ * the respective experiment chunk. Spikes of equal shifted time are ordered by sequence index and
+ * keep their order within a sequence.
+ * A heap-based k-way merge is used, for multiple threads the time range is partitioned at
+ * quantiles of the largest sequence and the partitions are merged concurrently.
+ * @param spikes Spike sequences, each sorted by FPGA time
+ * @param time_offsets FPGA time offset per sequence, empty for no offsets
+ * @param thread_count Number of threads, zero selects the number of hardware threads if the total
+ * number of spikes reaches merge_spikes_parallel_threshold and a single thread otherwise
+ * @return Merged spikes in columnar layout
+ * @throws std::invalid_argument On number of offsets not matching number of sequences or a
+ * sequence not being sorted by FPGA time
+ */
+SpikeColumns merge_spikes(
+    std::vector<SpikeView> const& spikes,
+    std::vector<haldls::vx::FPGATime> const& time_offsets = {},
+    size_t thread_count = 0) SYMBOL_VISIBLE;
+
+/**
+ * Merge spikes of executed programs sorted by FPGA time into a single sequence sorted by FPGA
+ * time.
+ * @param programs Executed programs
+ * @param time_offsets FPGA time offset per program, empty for no offsets
+ * @param thread_count Number of threads, zero selects automatically
+ * @return Merged spikes in columnar layout
+ * @throws std::invalid_argument On number of offsets not matching number of programs, a program
+ * being nullptr or its spikes not being sorted by FPGA time
+ */
+SpikeColumns merge_spikes(
+    std::vector<PlaybackProgram const*> const& programs,
+    std::vector<haldls::vx::FPGATime> const& time_offsets = {},
+    size_t thread_count = 0) SYMBOL_VISIBLE;
+
+} // namespace stadls::vx
@@ -1,8 +1,11 @@
 #pragma once
 
 #include <cstdint>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <optional>
+#include <random>
 #include <string>
 #include <vector>
 
@@ -12,6 +15,9 @@
 #include "hate/visibility.h"
 #include "stadls/vx/executor_backend.h"
 #include "stadls/vx/genpybind.h"
+#include "stadls/vx/result_columns.h"
+#include "stadls/vx/spike_histogram.h"
+#include "stadls/vx/spike_view.h"
 #ifdef __GENPYBIND__
 #include "haldls/vx/container.h"
 #include "lola/vx/container.h"
@@ -20,11 +26,16 @@
 #include <pybind11/numpy.h>
 #include <pybind11/stl_bind.h>
 
+namespace cereal {
+class access;
+} // namespace cereal
+
 namespace stadls {
 namespace vx GENPYBIND_TAG_STADLS_VX {
 
 class PlaybackProgramExecutor;
 class PlaybackProgramBuilder;
+class ExecutorPool;
 
 /**
  * Sequential stream of executable instructions for the executor and result-container for event
@@ -82,24 +93,203 @@ public:
 
 		ContainerTicket(coordinate_type const& coord, ticket_impl_type const& ticket_impl) :
 		    m_coord(coord),
-		    m_ticket_impl(ticket_impl)
+		    m_ticket_impl(ticket_impl),
+		    m_cache(std::make_shared<Cache>())
 		{}
 
+		/**
+		 * Decode container data without using the cache.
+		 * @throws std::runtime_error On container data not available yet
+		 * @return Container data
+		 */
+		T decode() const;
+
+		/**
+		 * Decode container data from given words.
+		 * @tparam Data Word sequence type
+		 * @param data Words to decode
+		 * @return Container data
+		 */
+		template <typename Data>
+		T decode(Data const& data) const;
+
+		/**
+		 * Fill cache with container data decoded from pseudo-random words instead of executor
+		 * response data.
+		 * If the random words are not representable by the container, zero-initialized words are
+		 * decoded instead.
+		 * @param gen RNG
+		 * @param fpga_time Time annotation of the mocked response
+		 */
+		void mock_into_cache(std::mt19937& gen, fpga_time_type const& fpga_time) const;
+
+		/**
+		 * Decode container data into cache if available and not already cached.
+		 */
+		void decode_into_cache() const;
+
+		/**
+		 * Drop cached container data, e.g. when the program is executed again.
+		 */
+		void reset_cache() const;
+
+		/** Decoded container data shared between copies of the ticket. */
+		struct Cache
+		{
+			std::mutex mutex;
+			std::optional<T> value;
+			/** Time annotation overriding the one of the response data, set for mocked data. */
+			std::optional<fpga_time_type> fpga_time;
+		};
+
 		coordinate_type m_coord;
 		ticket_impl_type m_ticket_impl;
+		std::shared_ptr<Cache> m_cache;
 	}; // ContainerTicket
 
+	/**
+	 * Ticket for to-be-available data of multiple containers of the same type corresponding to a
+	 * single batched read instruction.
+	 * @tparam T Container type
+	 */
+	template <typename T>
+	class ContainerBatchTicket
+	{
+	public:
+		typedef typename T::coordinate_type coordinate_type;
+		typedef std::vector<coordinate_type> coordinates_type;
+
+		/**
+		 * Get data of all containers if available.
+		 * @throws std::runtime_error On container data not available yet
+		 * @return Container data in order of the coordinates
+		 */
+		std::vector<T> get() const SYMBOL_VISIBLE;
+
+		/**
+		 * Get whether data of all containers is available.
+		 * @return Boolean value
+		 */
+		bool valid() const SYMBOL_VISIBLE;
+
+		/**
+		 * Get coordinates corresponding to locations of (to-be) read container data.
+		 * @return Coordinate values
+		 */
+		GENPYBIND(getter_for(coordinates))
+		coordinates_type get_coordinates() const SYMBOL_VISIBLE;
+
+		/**
+		 * Get FPGA executor timestamp of last container response if time annotation is enabled.
+		 * If time annotation is not enabled, get message count since last time annotation or
+		 * from the beginning of the response stream.
+		 * @return FPGATime value
+		 */
+		GENPYBIND(getter_for(fpga_time))
+		fpga_time_type get_fpga_time() const SYMBOL_VISIBLE;
+
+		/**
+		 * Get number of containers in batch.
+		 * @return Size value
+		 */
+		size_t size() const SYMBOL_VISIBLE;
+
+	private:
+		typedef typename haldls::vx::detail::to_ticket_variant<
+		    typename haldls::vx::detail::BackendContainerTrait<T>::container_list>::type
+		    ticket_impl_type;
+
+		friend PlaybackProgramBuilder;
+
+		ContainerBatchTicket(
+		    coordinates_type const& coords,
+		    std::vector<size_t> const& word_offsets,
+		    ticket_impl_type const& ticket_impl) :
+		    m_coords(coords),
+		    m_word_offsets(word_offsets),
+		    m_ticket_impl(ticket_impl),
+		    m_cache(std::make_shared<Cache>())
+		{}
+
+		/**
+		 * Construct ticket of empty batch without read instruction.
+		 * The ticket is valid from the beginning and its cache is never reset.
+		 */
+		ContainerBatchTicket() :
+		    m_coords(), m_word_offsets{0}, m_ticket_impl(), m_cache(std::make_shared<Cache>())
+		{
+			m_cache->value.emplace();
+			m_cache->fpga_time.emplace();
+		}
+
+		/**
+		 * Decode data of all containers without using the cache.
+		 * @throws std::runtime_error On container data not available yet
+		 * @return Container data in order of the coordinates
+		 */
+		std::vector<T> decode() const;
+
+		/**
+		 * Decode data of all containers from given words.
+		 * @tparam Data Word sequence type
+		 * @param data Words to decode
+		 * @return Container data in order of the coordinates
+		 */
+		template <typename Data>
+		std::vector<T> decode(Data const& data) const;
+
+		/**
+		 * Fill cache with container data decoded from pseudo-random words instead of executor
+		 * response data.
+		 * If the random words are not representable by the containers, zero-initialized words
+		 * are decoded instead.
+		 * @param gen RNG
+		 * @param fpga_time Time annotation of the mocked response
+		 */
+		void mock_into_cache(std::mt19937& gen, fpga_time_type const& fpga_time) const;
+
+		/**
+		 * Decode container data into cache if available and not already cached.
+		 */
+		void decode_into_cache() const;
+
+		/**
+		 * Drop cached container data, e.g. when the program is executed again.
+		 */
+		void reset_cache() const;
+
+		/** Decoded container data shared between copies of the ticket. */
+		struct Cache
+		{
+			std::mutex mutex;
+			std::optional<std::vector<T>> value;
+			/** Time annotation overriding the one of the response data, set for mocked data. */
+			std::optional<fpga_time_type> fpga_time;
+		};
+
+		coordinates_type m_coords;
+		/** Offsets of container data in read words with additional trailing end offset. */
+		std::vector<size_t> m_word_offsets;
+		/** Backend ticket, empty for an empty batch. */
+		std::optional<ticket_impl_type> m_ticket_impl;
+		std::shared_ptr<Cache> m_cache;
+	}; // ContainerBatchTicket
+
 #ifdef __GENPYBIND__
 // Explicit instantiation of template class for all valid playback container types.
 #define PLAYBACK_CONTAINER(Name, Type)                                                             \
-	typedef PlaybackProgram::ContainerTicket<Type> ContainerTicket_##Name GENPYBIND(opaque);
+	typedef PlaybackProgram::ContainerTicket<Type> ContainerTicket_##Name GENPYBIND(opaque);       \
+	typedef PlaybackProgram::ContainerBatchTicket<Type> ContainerBatchTicket_##Name                \
+	    GENPYBIND(opaque);
 #include "haldls/vx/container.def"
 #endif // __GENPYBIND__
 
 #ifdef __GENPYBIND__
 // Explicit instantiation of template class for all valid playback container types.
 #define PLAYBACK_CONTAINER(Name, Type)                                                             \
-	typedef PlaybackProgram::ContainerTicket<Type> ContainerTicket_##Name GENPYBIND(opaque);
+	typedef PlaybackProgram::ContainerTicket<Type> ContainerTicket_##Name GENPYBIND(opaque);       \
+	typedef PlaybackProgram::ContainerBatchTicket<Type> ContainerBatchTicket_##Name                \
+	    GENPYBIND(opaque);
 #include "lola/vx/container.def"
 #endif // __GENPYBIND__
 
@@ -115,11 +305,13 @@ public:
 	    GENPYBIND(visible);
 
 	/**
-	 * Get vector of time-annotated spike events.
-	 * @return Vector of spike events
+	 * Get time-annotated spike events.
+	 * The spikes are converted from the backend representation once per execution, the returned
+	 * view and all further views share this storage without copy.
+	 * @return View of spike events
 	 */
 	GENPYBIND(getter_for(spikes))
-	spikes_type get_spikes() const SYMBOL_VISIBLE;
+	SpikeView get_spikes() const SYMBOL_VISIBLE;
 
 	/**
 	 * Get vector of time-annotated MADC sample events.
@@ -128,6 +320,38 @@ public:
 	GENPYBIND(getter_for(madc_samples))
 	madc_samples_type const& get_madc_samples() const SYMBOL_VISIBLE;
 
+	/**
+	 * Get time-annotated spike events in columnar layout.
+	 * The columns are constructed once per execution and shared by all further calls.
+	 * @return Spike columns
+	 */
+	GENPYBIND(getter_for(spike_columns))
+	SpikeColumns get_spike_columns() const SYMBOL_VISIBLE;
+
+	/**
+	 * Get time-annotated MADC sample events in columnar layout.
+	 * The columns are constructed once per execution and shared by all further calls.
+	 * @return MADC sample columns
+	 */
+	GENPYBIND(getter_for(madc_sample_columns))
+	MADCSampleColumns get_madc_sample_columns() const SYMBOL_VISIBLE;
+
+	/**
+	 * Attach histogram accumulating the spikes of every subsequent execution of the program.
+	 * The histogram is shared with copies of the program made after attaching and counts are
+	 * accumulated over executions until it is reset.
+	 * @param histogram Histogram to attach, nullptr detaches the current histogram
+	 */
+	GENPYBIND(setter_for(spike_histogram))
+	void set_spike_histogram(std::shared_ptr<SpikeHistogram> const& histogram) SYMBOL_VISIBLE;
+
+	/**
+	 * Get attached spike histogram.
+	 * @return Histogram or nullptr if none is attached
+	 */
+	GENPYBIND(getter_for(spike_histogram))
+	std::shared_ptr<SpikeHistogram> get_spike_histogram() const SYMBOL_VISIBLE;
+
 	/**
 	 * Get number of occurences of spike packing from chip.
 	 * @return Array of packing occurences
@@ -151,6 +375,15 @@ public:
 	GENPYBIND(getter_for(executable_restriction))
 	std::optional<ExecutorBackend> get_executable_restriction() const SYMBOL_VISIBLE;
 
+	/**
+	 * Decode data of all container tickets issued for this program in parallel and cache the
+	 * decoded containers.
+	 * Subsequent calls to get() of the tickets return a copy of the cached data.
+	 * Tickets without available data are skipped.
+	 * @param thread_count Number of decoding threads, zero selects the number of hardware threads
+	 */
+	void decode_all(size_t thread_count = 0) SYMBOL_VISIBLE;
+
 	GENPYBIND(stringstream)
 	friend std::ostream& operator<<(std::ostream& os, PlaybackProgram const& program)
 	    SYMBOL_VISIBLE;
@@ -158,6 +391,23 @@ public:
 	bool operator==(PlaybackProgram const& other) const SYMBOL_VISIBLE;
 	bool operator!=(PlaybackProgram const& other) const SYMBOL_VISIBLE;
 
+	/**
+	 * Save instruction stream and executable restriction to binary file.
+	 * Tickets issued for the program and result data are not saved.
+	 * @param filename Path of file to write
+	 * @throws std::runtime_error On file not writeable
+	 */
+	void save(std::string const& filename) const SYMBOL_VISIBLE;
+
+	/**
+	 * Load program saved via save().
+	 * The file is memory-mapped and deserialized directly from the mapping.
+	 * @param filename Path of file to read
+	 * @return Loaded program without tickets
+	 * @throws std::runtime_error On file not readable or not containing a saved program
+	 */
+	static PlaybackProgram load(std::string const& filename) SYMBOL_VISIBLE;
+
 	/**
 	 * Get spikes as 2D matrix, i.e. numpy array(s).
 	 *
@@ -192,20 +442,98 @@ public:
 private:
 	friend PlaybackProgramBuilder;
 	friend PlaybackProgramExecutor;
+	friend ExecutorPool;
+
+	friend class cereal::access;
+	template <typename Archive>
+	void save(Archive& ar) const SYMBOL_VISIBLE;
+	template <typename Archive>
+	void load(Archive& ar) SYMBOL_VISIBLE;
+
+	/**
+	 * Type-erased deferred decoding of a container ticket issued for the program.
+	 */
+	struct DeferredDecode
+	{
+		std::function<void()> decode;
+		std::function<void()> reset;
+		std::function<void(std::mt19937&)> mock;
+	};
+
+	typedef std::vector<DeferredDecode> deferred_decodes_type;
+
+	/**
+	 * Response data of an execution on the mock backend shared between copies of the program.
+	 */
+	struct MockState
+	{
+		/** Spikes echoed for spike packs written to the chip. */
+		spikes_type spikes;
+		/** Whether the last execution happened on the mock backend. */
+		bool active = false;
+	};
+
+	/**
+	 * Result data converted from the backend representation on first access shared between copies
+	 * of the program.
+	 */
+	struct ResultCache
+	{
+		std::mutex mutex;
+		/** Converted spikes, nullptr if not yet converted. */
+		std::shared_ptr<spikes_type const> spikes;
+		/** Spikes in columnar layout, nullptr if not yet converted. */
+		std::shared_ptr<SpikeColumns::Storage const> spike_columns;
+		/** MADC samples in columnar layout, nullptr if not yet converted. */
+		std::shared_ptr<MADCSampleColumns::Storage const> madc_sample_columns;
+	};
 
 	/**
 	 * Construct PlaybackProgram from implementation.
 	 * Used in PlaybackProgramBuilder
 	 * @param program_impl Implementation playback program
 	 * @param executable_restriction Build-imposed restrictions on executor
+	 * @param deferred_decodes Deferred decoding of tickets issued during build
+	 * @param mock_state Mock response data recorded during build
 	 */
 	PlaybackProgram(
 	    std::shared_ptr<fisch::vx::PlaybackProgram> const& program_impl,
-	    std::optional<ExecutorBackend> executable_restriction) SYMBOL_VISIBLE;
+	    std::optional<ExecutorBackend> executable_restriction,
+	    std::shared_ptr<deferred_decodes_type> const& deferred_decodes,
+	    std::shared_ptr<MockState> const& mock_state) SYMBOL_VISIBLE;
+
+	/**
+	 * Drop cached decoded data of all tickets, used before (re-)execution of the program.
+	 */
+	void reset_decoded() SYMBOL_VISIBLE;
+
+	/**
+	 * Fill all tickets with deterministic pseudo-random data, used by the mock backend.
+	 * @param gen RNG
+	 */
+	void mock_responses(std::mt19937& gen) SYMBOL_VISIBLE;
+
+	/**
+	 * Expose spikes recorded during build as spike response, used by the mock backend.
+	 */
+	void mock_spike_echo() SYMBOL_VISIBLE;
+
+	/**
+	 * Accumulate spikes of the last execution into the attached histogram if present.
+	 */
+	void accumulate_spike_histogram() const SYMBOL_VISIBLE;
 
 	std::shared_ptr<fisch::vx::PlaybackProgram> m_program_impl;
 
 	std::optional<ExecutorBackend> m_executable_restriction;
+
+	std::shared_ptr<deferred_decodes_type> m_deferred_decodes;
+
+	std::shared_ptr<MockState> m_mock_state;
+
+	std::shared_ptr<ResultCache> m_result_cache;
+
+	std::shared_ptr<SpikeHistogram> m_spike_histogram;
 };
 
 } // namespace vx
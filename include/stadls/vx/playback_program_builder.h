@@ -16,6 +16,8 @@
 // needed for python wrapping
 #include "fisch/vx/playback_program_builder.h"
 
+#include <pybind11/numpy.h>
+
 namespace fisch::vx {
 class PlaybackProgramBuilder;
 } // namespace fisch::vx
@@ -24,6 +26,7 @@ namespace stadls {
 namespace vx GENPYBIND_TAG_STADLS_VX {
 
 class PlaybackProgram;
+class SpikeTrainFile;
 
 /**
  * Sequential PlaybackProgram builder.
@@ -51,6 +54,57 @@ public:
 	    typename haldls::vx::Timer::coordinate_type const& coord,
 	    haldls::vx::Timer::Value time) SYMBOL_VISIBLE;
 
+	/**
+	 * Add instructions to inject spike train into the chip.
+	 * For every distinct time a wait instruction on the timer is added, co-temporal spikes are
+	 * packed into as few spike packs as possible, i.e. SpikePack3ToChip with one SpikePack2ToChip
+	 * or SpikePack1ToChip for the remaining spikes.
+	 * @param times Non-decreasing timer values of spikes
+	 * @param labels Labels of spikes
+	 * @throws std::runtime_error On sizes not matching or times not being sorted
+	 */
+	void write_spike_train(
+	    std::vector<haldls::vx::Timer::Value> const& times,
+	    std::vector<haldls::vx::SpikeLabel> const& labels) SYMBOL_VISIBLE;
+
+	/**
+	 * Add instructions to inject spike train into the chip.
+	 * @param times Non-decreasing timer values of spikes
+	 * @param labels Labels of spikes
+	 * @param size Number of spikes
+	 * @throws std::runtime_error On times not being sorted
+	 */
+	void write_spike_train(uint64_t const* times, uint16_t const* labels, size_t size)
+	    SYMBOL_VISIBLE GENPYBIND(hidden);
+
+	GENPYBIND_MANUAL({
+		typedef pybind11::array_t<uint64_t, pybind11::array::c_style | pybind11::array::forcecast>
+		    _times_type;
+		typedef pybind11::array_t<uint16_t, pybind11::array::c_style | pybind11::array::forcecast>
+		    _labels_type;
+		parent.def(
+		    "write_spike_train",
+		    [](::stadls::vx::PlaybackProgramBuilder& self, _times_type const& times,
+		       _labels_type const& labels) {
+			    if ((times.ndim() != 1) || (labels.ndim() != 1)) {
+				    throw std::runtime_error("Spike times and labels have to be one-dimensional.");
+			    }
+			    if (times.size() != labels.size()) {
+				    throw std::runtime_error("Number of spike times and labels do not match.");
+			    }
+			    self.write_spike_train(times.data(), labels.data(), times.size());
+		    },
+		    pybind11::arg("times"), pybind11::arg("labels"));
+	})
+
+	/**
+	 * Add instructions to send spike train loaded from file.
+	 * The instructions built once on loading the file are copied, its spikes are not packed and
+	 * encoded again.
+	 * @param spike_train_file Spike train to add
+	 */
+	void write_spike_train(SpikeTrainFile const& spike_train_file) SYMBOL_VISIBLE;
+
 #define PLAYBACK_CONTAINER(Name, Type)                                                             \
 	/**                                                                                            \
 	 * Add instructions to write given container to given location.                                \
@@ -96,6 +150,32 @@ public:
 	    typename Type::coordinate_type const& coord, Type const& config,                           \
 	    Type const& config_reference) SYMBOL_VISIBLE;                                              \
                                                                                                    \
+	/**                                                                                            \
+	 * Add instructions to write given containers to given locations.                              \
+	 * All containers are encoded into one contiguous address and word sequence and are forwarded  \
+	 * to the backend in a single write.                                                           \
+	 * @throws std::runtime_error On number of coordinates and containers not matching             \
+	 * @param coords Coordinate values selecting locations                                         \
+	 * @param configs Container configuration data, one per coordinate                             \
+	 * @param backend Backend selection                                                            \
+	 */                                                                                            \
+	void write_many(                                                                               \
+	    std::vector<typename Type::coordinate_type> const& coords,                                 \
+	    std::vector<Type> const& configs, haldls::vx::Backend backend) SYMBOL_VISIBLE;             \
+                                                                                                   \
+	/**                                                                                            \
+	 * Add instructions to write given containers to given locations.                              \
+	 * The container's default backend is used.                                                    \
+	 * @throws std::runtime_error On number of coordinates and containers not matching             \
+	 * @param coords Coordinate values selecting locations                                         \
+	 * @param configs Container configuration data, one per coordinate                             \
+	 * @note This function without backend parameter is needed due to python wrapping not being    \
+	 * able to handle templated default arguments.                                                 \
+	 */                                                                                            \
+	void write_many(                                                                               \
+	    std::vector<typename Type::coordinate_type> const& coords,                                 \
+	    std::vector<Type> const& configs) SYMBOL_VISIBLE;                                          \
+                                                                                                   \
 	/**                                                                                            \
 	 * Add instructions to read container data from given location.                                \
 	 * @param coord Coordinate value selecting location                                            \
@@ -112,7 +192,28 @@ public:
 	 * able to handle templated default arguments.                                                 \
 	 */                                                                                            \
 	PlaybackProgram::ContainerTicket<Type> read(typename Type::coordinate_type const& coord)       \
-	    SYMBOL_VISIBLE;
+	    SYMBOL_VISIBLE;                                                                            \
+                                                                                                   \
+	/**                                                                                            \
+	 * Add instructions to read data of multiple containers from given locations.                  \
+	 * All addresses are read with a single backend read instruction, for empty coordinates no     \
+	 * instruction is added and the returned ticket is valid immediately.                          \
+	 * @param coords Coordinate values selecting locations                                         \
+	 * @param backend Backend selection                                                            \
+	 */                                                                                            \
+	PlaybackProgram::ContainerBatchTicket<Type> read_many(                                         \
+	    std::vector<typename Type::coordinate_type> const& coords, haldls::vx::Backend backend)    \
+	    SYMBOL_VISIBLE;                                                                            \
+                                                                                                   \
+	/**                                                                                            \
+	 * Add instructions to read data of multiple containers from given locations.                  \
+	 * The container's default backend is used.                                                    \
+	 * @param coords Coordinate values selecting locations                                         \
+	 * @note This function without backend parameter is needed due to python wrapping not being    \
+	 * able to handle templated default arguments.                                                 \
+	 */                                                                                            \
+	PlaybackProgram::ContainerBatchTicket<Type> read_many(                                         \
+	    std::vector<typename Type::coordinate_type> const& coords) SYMBOL_VISIBLE;
 #pragma push_macro("PLAYBACK_CONTAINER")
 #include "haldls/vx/container.def"
 #pragma pop_macro("PLAYBACK_CONTAINER")
@@ -164,6 +265,33 @@ public:
 	 */
 	bool empty() const SYMBOL_VISIBLE;
 
+	/**
+	 * Enable or disable tracking of the shadow state, i.e. the last word written to every hardware
+	 * location by this builder.
+	 * When enabled, writes of containers supporting differential writes only emit words differing
+	 * from the shadow state, other writes invalidate the shadow state of their locations and a
+	 * ResetChip write invalidates the complete shadow state.
+	 * Writes to the chip via JTAG invalidate the shadow state of writes via the FPGA's omnibus and
+	 * vice versa.
+	 * The shadow state is kept over done(), which assumes that the produced programs are executed
+	 * in the order they are built on a single chip without other programs in between.
+	 * Disabling drops the shadow state.
+	 * @param value Boolean value
+	 */
+	void set_enable_shadow_state(bool value) SYMBOL_VISIBLE;
+
+	/**
+	 * Get whether tracking of the shadow state is enabled.
+	 * @return Boolean value
+	 */
+	bool get_enable_shadow_state() const SYMBOL_VISIBLE;
+
+	/**
+	 * Drop the shadow state, e.g. after the hardware state was changed by other means than
+	 * programs of this builder, so that subsequent writes are emitted completely.
+	 */
+	void reset_shadow_state() SYMBOL_VISIBLE;
+
 private:
 	template <typename T, size_t SupportedBackendIndex>
 	static void write_table_entry(
@@ -180,15 +308,90 @@ private:
 	    std::optional<T> const& config_reference,
 	    std::index_sequence<SupportedBackendIndex...>);
 
+	template <typename T, size_t SupportedBackendIndex>
+	static void write_many_table_entry(
+	    PlaybackProgramBuilder& builder,
+	    std::vector<typename T::coordinate_type> const& coords,
+	    std::vector<T> const& configs);
+
+	template <class T, size_t... SupportedBackendIndex>
+	void write_many_table_generator(
+	    std::vector<typename T::coordinate_type> const& coords,
+	    std::vector<T> const& configs,
+	    size_t backend_index,
+	    std::index_sequence<SupportedBackendIndex...>);
+
 	template <class T, size_t... SupportedBackendIndex>
 	PlaybackProgram::ContainerTicket<T> read_table_generator(
 	    typename T::coordinate_type const& coord,
 	    size_t backend_index,
 	    std::index_sequence<SupportedBackendIndex...>) SYMBOL_VISIBLE;
 
+	template <class T, size_t... SupportedBackendIndex>
+	PlaybackProgram::ContainerBatchTicket<T> read_many_table_generator(
+	    std::vector<typename T::coordinate_type> const& coords,
+	    size_t backend_index,
+	    std::index_sequence<SupportedBackendIndex...>);
+
+	/**
+	 * Check readability of container type with backend container type and restrict executable
+	 * backend accordingly.
+	 * @tparam T Container type
+	 * @tparam BackendContainer Backend container type
+	 * @throws std::runtime_error On container not readable at all or not readable with current
+	 * executable restriction
+	 */
+	template <class T, class BackendContainer>
+	void restrict_executable_for_read();
+
+	/**
+	 * Record data needed for responses of the mock backend, i.e. the current timer value and
+	 * spikes to echo if the builder is restricted to the mock backend.
+	 * @tparam T Container type
+	 * @param config Written container
+	 */
+	template <typename T>
+	void record_for_mock(T const& config);
+
+	/**
+	 * Add instructions to inject spike train into the chip.
+	 * @tparam TimeAt Callable returning the timer value of the spike at given index
+	 * @tparam LabelAt Callable returning the label of the spike at given index
+	 * @param size Number of spikes
+	 * @param time_at Timer value access
+	 * @param label_at Label access
+	 */
+	template <typename TimeAt, typename LabelAt>
+	void write_spike_train(size_t size, TimeAt const& time_at, LabelAt const& label_at);
+
+	/**
+	 * Add write instruction of encoded words, filtered by and updating the shadow state if
+	 * enabled.
+	 * @tparam T Container type
+	 * @tparam AddressesT Address sequence type
+	 * @tparam WordsT Word sequence type
+	 * @param addresses Addresses of words
+	 * @param words Encoded words
+	 */
+	template <typename T, typename AddressesT, typename WordsT>
+	void write_shadowed(AddressesT const& addresses, WordsT const& words);
+
+	struct ShadowState;
+
 	std::unique_ptr<fisch::vx::PlaybackProgramBuilder> m_builder_impl;
 
 	std::optional<ExecutorBackend> m_executable_restriction;
+
+	PlaybackProgram::deferred_decodes_type m_deferred_decodes;
+
+	/** Time of the last timer write or wait instruction annotating mocked responses. */
+	haldls::vx::Timer::Value m_mock_time;
+
+	/** Spikes to echo on execution on the mock backend. */
+	PlaybackProgram::spikes_type m_mock_spikes;
+
+	/** Last written words per location, nullptr if tracking is disabled. */
+	std::unique_ptr<ShadowState> m_shadow_state;
 };
 
 } // namespace vx
@@ -1,8 +1,12 @@
 #pragma once
+#include <future>
 #include <memory>
+#include <optional>
 
 #include "hate/visibility.h"
+#include "stadls/vx/executor_backend.h"
 #include "stadls/vx/genpybind.h"
+#include "stadls/vx/result_stream.h"
 
 namespace fisch::vx {
 class PlaybackProgram;
@@ -57,6 +61,15 @@ public:
 	 */
 	void connect_simulator(ip_t ip, port_t port) SYMBOL_VISIBLE;
 
+	/**
+	 * Connect to in-process mock backend.
+	 * Programs are not executed, instead all reads are answered with deterministic pseudo-random
+	 * data annotated with the time of the last preceding timer write or wait instruction.
+	 * For programs built with ExecutorBackend::mock restriction, written spikes are echoed as
+	 * spikes from the chip.
+	 */
+	void connect_mock() SYMBOL_VISIBLE;
+
 	/**
 	 * Connect to backend by automatically finding possible executor.
 	 * If both hardware and simulator executor are available, hardware is favoured.
@@ -72,6 +85,12 @@ public:
 	 */
 	void disconnect() SYMBOL_VISIBLE;
 
+	/**
+	 * Get type of connected backend.
+	 * @return Backend type or std::nullopt if not connected
+	 */
+	std::optional<ExecutorBackend> get_backend() const SYMBOL_VISIBLE;
+
 	/**
 	 * Destruct executor closing connection to backend.
 	 */
@@ -81,16 +100,110 @@ public:
 	 * Transfer and execute the given playback program and fetch results.
 	 * @param program PlaybackProgram to run
 	 */
-	void run(PlaybackProgram& program) SYMBOL_VISIBLE;
+	void run(PlaybackProgram& program) GENPYBIND(hidden) SYMBOL_VISIBLE;
 	void run(PlaybackProgram&& program) GENPYBIND(hidden) SYMBOL_VISIBLE;
 
+	// Manual wrapping needed to release the GIL while a result stream consumer is waiting
+	GENPYBIND_MANUAL({
+		parent.def(
+		    "run",
+		    [](GENPYBIND_PARENT_TYPE& self, ::stadls::vx::PlaybackProgram& program) {
+			    self.run(program);
+		    },
+		    pybind11::call_guard<pybind11::gil_scoped_release>());
+	})
+
 	/**
 	 * Transfer and execute the given playback program and fetch results.
 	 * @param program PlaybackProgram to run
 	 */
 	void run(std::shared_ptr<fisch::vx::PlaybackProgram> const& program) SYMBOL_VISIBLE;
 
+	/**
+	 * Enqueue the given playback program for execution on a background submission thread and
+	 * return immediately.
+	 * Programs are executed in order of submission. If the maximal number of programs in flight
+	 * is reached, the call blocks until the oldest program has finished execution.
+	 * Synchronous run() calls are serialized with the background execution.
+	 * @param program PlaybackProgram to run
+	 * @return Future of the executed program holding the results, exceptions during execution
+	 * are rethrown on get()
+	 */
+	std::future<PlaybackProgram> run_async(PlaybackProgram const& program) GENPYBIND(hidden)
+	    SYMBOL_VISIBLE;
+
+	/**
+	 * Set maximal number of programs enqueued or executing via run_async().
+	 * @param value Number of programs, has to be larger than zero
+	 * @throws std::invalid_argument On value being zero
+	 */
+	void set_max_programs_in_flight(size_t value) SYMBOL_VISIBLE;
+
+	/**
+	 * Get maximal number of programs enqueued or executing via run_async().
+	 * @return Number of programs
+	 */
+	size_t get_max_programs_in_flight() const SYMBOL_VISIBLE;
+
+	/**
+	 * Block until all programs submitted via run_async() have finished execution.
+	 */
+	void wait_all() SYMBOL_VISIBLE;
+
+	/** Default maximal number of programs in flight. */
+	static constexpr size_t default_max_programs_in_flight = 2;
+
+	/**
+	 * Accumulated durations of the phases of program execution.
+	 */
+	struct GENPYBIND(visible) Timings
+	{
+		/** Number of executed programs. */
+		size_t program_count = 0;
+		/** Time spent executing programs on the backend [s]. */
+		double execution_duration = 0.;
+		/** Time spent generating and decoding mock read responses [s]. */
+		double mock_response_duration = 0.;
+		/** Time spent echoing spikes on the mock backend [s]. */
+		double mock_spike_echo_duration = 0.;
+	};
+
+	/**
+	 * Get accumulated timings of all executions since connection or last reset.
+	 * @return Timings
+	 */
+	Timings get_timings() const SYMBOL_VISIBLE;
+
+	/**
+	 * Reset accumulated timings.
+	 */
+	void reset_timings() SYMBOL_VISIBLE;
+
+	/**
+	 * Attach stream receiving the spikes and MADC samples of every program executed via run() or
+	 * run_async() after its execution.
+	 * Pushing into the stream happens on the executing thread after the program's execution is
+	 * finished, a full stream with blocking overflow policy therefore delays the return of run()
+	 * and further pushes, but not the execution of subsequent programs.
+	 * @param stream Stream to attach, nullptr detaches the current stream
+	 * @throws std::logic_error On stream already attached to another executor
+	 */
+	void set_result_stream(std::shared_ptr<ResultStream> const& stream) SYMBOL_VISIBLE;
+
+	/**
+	 * Get attached result stream.
+	 * @return Stream or nullptr if none is attached
+	 */
+	std::shared_ptr<ResultStream> get_result_stream() const SYMBOL_VISIBLE;
+
 private:
+	/**
+	 * Check that the program's executable restriction matches the connected backend.
+	 * @param program PlaybackProgram to check
+	 * @throws std::runtime_error On non-matching executable restriction
+	 */
+	void check_executable_restriction(PlaybackProgram const& program) const;
+
 	struct Impl;
 	std::unique_ptr<Impl> m_impl;
 };
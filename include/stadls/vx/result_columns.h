@@ -0,0 +1,174 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include "hate/visibility.h"
+#include "stadls/vx/genpybind.h"
+
+#include <pybind11/numpy.h>
+
+namespace stadls::vx GENPYBIND_TAG_STADLS_VX {
+
+/**
+ * Read-only columnar (struct-of-arrays) storage of time-annotated spike events.
+ * Label, FPGA time and chip time of all spikes are stored in separate contiguous arrays, which
+ * allows filtering by a single quantity without touching the others.
+ * Copies of the object and numpy arrays created from it share the storage.
+ */
+class GENPYBIND(visible) SpikeColumns
+{
+public:
+	typedef uint16_t label_type;
+	typedef uint64_t time_type;
+
+	/**
+	 * Column arrays.
+	 */
+	struct GENPYBIND(hidden) Storage
+	{
+		std::vector<label_type> labels;
+		std::vector<time_type> fpga_times;
+		std::vector<time_type> chip_times;
+	};
+
+	/** Construct empty columns. */
+	SpikeColumns() SYMBOL_VISIBLE;
+
+	/**
+	 * Construct columns from storage.
+	 * @param storage Column arrays of equal size
+	 * @throws std::logic_error On arrays not being of equal size
+	 */
+	explicit SpikeColumns(std::shared_ptr<Storage const> const& storage) SYMBOL_VISIBLE
+	    GENPYBIND(hidden);
+
+	/**
+	 * Get number of spikes.
+	 * @return Number of spikes
+	 */
+	size_t size() const SYMBOL_VISIBLE;
+
+	/**
+	 * Get whether no spikes are stored.
+	 * @return Boolean value
+	 */
+	bool empty() const SYMBOL_VISIBLE;
+
+	std::vector<label_type> const& get_labels() const SYMBOL_VISIBLE GENPYBIND(hidden);
+	std::vector<time_type> const& get_fpga_times() const SYMBOL_VISIBLE GENPYBIND(hidden);
+	std::vector<time_type> const& get_chip_times() const SYMBOL_VISIBLE GENPYBIND(hidden);
+
+	/**
+	 * Expose columns as read-only numpy arrays without copy.
+	 */
+	GENPYBIND_MANUAL({
+		typedef ::stadls::vx::SpikeColumns _columns_type;
+
+		auto const column = [](auto const getter) {
+			return [getter](_columns_type const& self) {
+				auto const& values = (self.*getter)();
+				typedef typename std::remove_reference<decltype(values)>::type::value_type
+				    _value_type;
+				auto const owner = new _columns_type(self);
+				pybind11::capsule base(
+				    owner, [](void* ptr) { delete reinterpret_cast<_columns_type*>(ptr); });
+				pybind11::array_t<_value_type> ret(
+				    {values.size()}, {sizeof(_value_type)}, values.data(), base);
+				ret.attr("setflags")(pybind11::arg("write") = false);
+				return ret;
+			};
+		};
+
+		parent.def("__len__", &_columns_type::size);
+		parent.def_property_readonly("labels", column(&_columns_type::get_labels));
+		parent.def_property_readonly("fpga_times", column(&_columns_type::get_fpga_times));
+		parent.def_property_readonly("chip_times", column(&_columns_type::get_chip_times));
+	})
+
+private:
+	std::shared_ptr<Storage const> m_storage;
+};
+
+/**
+ * Read-only columnar (struct-of-arrays) storage of time-annotated MADC sample events.
+ * Value, FPGA time and chip time of all samples are stored in separate contiguous arrays.
+ * Copies of the object and numpy arrays created from it share the storage.
+ */
+class GENPYBIND(visible) MADCSampleColumns
+{
+public:
+	typedef uint16_t value_type;
+	typedef uint64_t time_type;
+
+	/**
+	 * Column arrays.
+	 */
+	struct GENPYBIND(hidden) Storage
+	{
+		std::vector<value_type> values;
+		std::vector<time_type> fpga_times;
+		std::vector<time_type> chip_times;
+	};
+
+	/** Construct empty columns. */
+	MADCSampleColumns() SYMBOL_VISIBLE;
+
+	/**
+	 * Construct columns from storage.
+	 * @param storage Column arrays of equal size
+	 * @throws std::logic_error On arrays not being of equal size
+	 */
+	explicit MADCSampleColumns(std::shared_ptr<Storage const> const& storage) SYMBOL_VISIBLE
+	    GENPYBIND(hidden);
+
+	/**
+	 * Get number of samples.
+	 * @return Number of samples
+	 */
+	size_t size() const SYMBOL_VISIBLE;
+
+	/**
+	 * Get whether no samples are stored.
+	 * @return Boolean value
+	 */
+	bool empty() const SYMBOL_VISIBLE;
+
+	std::vector<value_type> const& get_values() const SYMBOL_VISIBLE GENPYBIND(hidden);
+	std::vector<time_type> const& get_fpga_times() const SYMBOL_VISIBLE GENPYBIND(hidden);
+	std::vector<time_type> const& get_chip_times() const SYMBOL_VISIBLE GENPYBIND(hidden);
+
+	/**
+	 * Expose columns as read-only numpy arrays without copy.
+	 */
+	GENPYBIND_MANUAL({
+		typedef ::stadls::vx::MADCSampleColumns _columns_type;
+
+		auto const column = [](auto const getter) {
+			return [getter](_columns_type const& self) {
+				auto const& values = (self.*getter)();
+				typedef typename std::remove_reference<decltype(values)>::type::value_type
+				    _value_type;
+				auto const owner = new _columns_type(self);
+				pybind11::capsule base(
+				    owner, [](void* ptr) { delete reinterpret_cast<_columns_type*>(ptr); });
+				pybind11::array_t<_value_type> ret(
+				    {values.size()}, {sizeof(_value_type)}, values.data(), base);
+				ret.attr("setflags")(pybind11::arg("write") = false);
+				return ret;
+			};
+		};
+
+		parent.def("__len__", &_columns_type::size);
+		parent.def_property_readonly("values", column(&_columns_type::get_values));
+		parent.def_property_readonly("fpga_times", column(&_columns_type::get_fpga_times));
+		parent.def_property_readonly("chip_times", column(&_columns_type::get_chip_times));
+	})
+
+private:
+	std::shared_ptr<Storage const> m_storage;
+};
+
+} // namespace stadls::vx
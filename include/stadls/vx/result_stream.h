@@ -0,0 +1,201 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+#include "fisch/vx/playback_program.h"
+#include "haldls/vx/event.h"
+#include "hate/visibility.h"
+#include "stadls/vx/genpybind.h"
+#include "stadls/vx/spike_view.h"
+
+namespace stadls::vx GENPYBIND_TAG_STADLS_VX {
+
+/**
+ * Bounded single-producer single-consumer ring buffer of spike and MADC sample chunks.
+ * An executor with attached stream pushes the results of every executed program in chunks of
+ * limited size, which a consumer thread pops while further programs are executed.
+ * The memory used by the stream is bounded by capacity times chunk size, on a full ring the
+ * producer either blocks, which delays subsequent executions, or drops the chunk.
+ * Push and pop are lock-free, blocking operations back off by yielding and sleeping.
+ * To keep the single-producer guarantee, the stream can only be attached to one executor at a
+ * time.
+ */
+class GENPYBIND(visible, holder_type("std::shared_ptr<::stadls::vx::ResultStream>")) ResultStream
+{
+public:
+	typedef std::vector<haldls::vx::SpikeFromChip> spikes_type;
+	typedef std::vector<haldls::vx::MADCSampleFromChipEvent> madc_samples_type;
+
+	/**
+	 * Consecutive results of an executed program.
+	 */
+	struct GENPYBIND(visible) Chunk
+	{
+		spikes_type spikes;
+		madc_samples_type madc_samples;
+	};
+
+	/**
+	 * Behaviour of push on a full ring.
+	 */
+	enum class GENPYBIND(visible) OverflowPolicy
+	{
+		block,
+		drop
+	};
+
+	/**
+	 * Back-pressure and throughput counters.
+	 */
+	struct GENPYBIND(visible) Statistics
+	{
+		/** Number of chunks inserted into the ring. */
+		size_t pushed_chunks = 0;
+		/** Number of chunks taken from the ring. */
+		size_t popped_chunks = 0;
+		/** Number of chunks dropped on a full ring or after close. */
+		size_t dropped_chunks = 0;
+		/** Number of pushes which had to wait for the consumer. */
+		size_t blocked_pushes = 0;
+		/** Maximal number of chunks simultaneously in the ring. */
+		size_t max_fill = 0;
+		/** Number of spikes inserted into the ring. */
+		size_t spikes = 0;
+		/** Number of MADC samples inserted into the ring. */
+		size_t madc_samples = 0;
+	};
+
+	/** Default number of chunks in the ring. */
+	static constexpr size_t default_capacity = 64;
+	/** Default maximal number of spikes and of MADC samples per chunk. */
+	static constexpr size_t default_chunk_size = 1 << 16;
+
+	/**
+	 * Construct empty stream.
+	 * @param capacity Number of chunks in the ring, has to be larger than zero
+	 * @param chunk_size Maximal number of spikes and of MADC samples per chunk, has to be larger
+	 * than zero
+	 * @param overflow_policy Behaviour of push on a full ring
+	 * @throws std::invalid_argument On capacity or chunk size being zero
+	 */
+	ResultStream(
+	    size_t capacity = default_capacity,
+	    size_t chunk_size = default_chunk_size,
+	    OverflowPolicy overflow_policy = OverflowPolicy::block) SYMBOL_VISIBLE;
+
+	ResultStream(ResultStream const&) = delete;
+	ResultStream& operator=(ResultStream const&) = delete;
+
+	size_t get_capacity() const SYMBOL_VISIBLE;
+	size_t get_chunk_size() const SYMBOL_VISIBLE;
+	OverflowPolicy get_overflow_policy() const SYMBOL_VISIBLE;
+
+	/**
+	 * Insert chunk, only to be called from the producer thread.
+	 * @param chunk Chunk to insert
+	 * @return Whether the chunk was inserted, false if it was dropped
+	 */
+	bool push(Chunk&& chunk) SYMBOL_VISIBLE GENPYBIND(hidden);
+
+	/**
+	 * Split results into chunks of at most chunk size spikes and MADC samples and insert them,
+	 * only to be called from the producer thread.
+	 * @param spikes Spikes to insert
+	 * @param madc_samples MADC samples to insert
+	 */
+	void push(SpikeView const& spikes, madc_samples_type const& madc_samples) SYMBOL_VISIBLE
+	    GENPYBIND(hidden);
+
+	/**
+	 * Split results in backend representation into chunks of at most chunk size spikes and MADC
+	 * samples and insert them, only to be called from the producer thread.
+	 * Spikes are converted per chunk without intermediate copy of all spikes.
+	 * @param spikes Spikes to insert
+	 * @param madc_samples MADC samples to insert
+	 */
+	void push(
+	    fisch::vx::PlaybackProgram::spikes_type const& spikes,
+	    madc_samples_type const& madc_samples) SYMBOL_VISIBLE GENPYBIND(hidden);
+
+	/**
+	 * Take oldest chunk if available, only to be called from the consumer thread.
+	 * @return Chunk or std::nullopt if the ring is empty
+	 */
+	std::optional<Chunk> try_pop() SYMBOL_VISIBLE;
+
+	/**
+	 * Take oldest chunk, blocking until one is available or the stream is closed, only to be
+	 * called from the consumer thread.
+	 * @return Chunk or std::nullopt if the stream is closed and empty
+	 */
+	std::optional<Chunk> pop() SYMBOL_VISIBLE GENPYBIND(hidden);
+
+	// Manual wrapping needed to release the GIL while waiting for the producer
+	GENPYBIND_MANUAL({
+		parent.def(
+		    "pop", [](GENPYBIND_PARENT_TYPE& self) { return self.pop(); },
+		    pybind11::call_guard<pybind11::gil_scoped_release>());
+	})
+
+	/**
+	 * Close stream, subsequent pushes are dropped and blocked operations return.
+	 */
+	void close() SYMBOL_VISIBLE;
+
+	/**
+	 * Get whether stream is closed.
+	 * @return Boolean value
+	 */
+	bool get_closed() const SYMBOL_VISIBLE;
+
+	/**
+	 * Get number of chunks currently in the ring.
+	 * @return Number of chunks
+	 */
+	size_t size() const SYMBOL_VISIBLE;
+
+	/**
+	 * Get back-pressure and throughput counters.
+	 * @return Statistics
+	 */
+	Statistics get_statistics() const SYMBOL_VISIBLE;
+
+	/**
+	 * Register producer of the stream.
+	 * @throws std::logic_error On stream already having a producer
+	 */
+	void attach_producer() SYMBOL_VISIBLE GENPYBIND(hidden);
+
+	/**
+	 * Unregister producer of the stream.
+	 */
+	void detach_producer() SYMBOL_VISIBLE GENPYBIND(hidden);
+
+private:
+	template <typename Spikes>
+	void push_chunked(Spikes const& spikes, madc_samples_type const& madc_samples);
+
+	size_t m_chunk_size;
+	OverflowPolicy m_overflow_policy;
+
+	/** Ring slots, one more than the capacity to distinguish full from empty. */
+	std::vector<Chunk> m_slots;
+	/** Index of oldest chunk, written by consumer. */
+	std::atomic<size_t> m_head;
+	/** Index of next free slot, written by producer. */
+	std::atomic<size_t> m_tail;
+	std::atomic<bool> m_closed;
+	std::atomic<bool> m_has_producer;
+
+	std::atomic<size_t> m_pushed_chunks;
+	std::atomic<size_t> m_popped_chunks;
+	std::atomic<size_t> m_dropped_chunks;
+	std::atomic<size_t> m_blocked_pushes;
+	std::atomic<size_t> m_max_fill;
+	std::atomic<size_t> m_spikes;
+	std::atomic<size_t> m_madc_samples;
+};
+
+} // namespace stadls::vx
@@ -0,0 +1,174 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <mutex>
+#include <vector>
+
+#include "haldls/vx/event.h"
+#include "hate/visibility.h"
+#include "stadls/vx/genpybind.h"
+
+#include <pybind11/numpy.h>
+
+namespace stadls::vx GENPYBIND_TAG_STADLS_VX {
+
+/**
+ * Dense histogram of spike counts per label and FPGA time bin.
+ * Attached to a PlaybackProgram, the spikes of every execution are accumulated directly from the
+ * backend representation without materializing them as SpikeFromChip vector.
+ * Memory scales with the number of labels times the number of bins instead of with the number of
+ * spikes.
+ * The counts are stored row-major in a flat array, rows correspond to labels in order of
+ * construction, columns to bins.
+ * Labels are mapped to rows by a direct lookup table over all possible label values.
+ */
+class GENPYBIND(visible, holder_type("std::shared_ptr<::stadls::vx::SpikeHistogram>"))
+    SpikeHistogram
+{
+public:
+	typedef uint64_t count_type;
+	typedef std::vector<haldls::vx::SpikeLabel> labels_type;
+	typedef std::vector<haldls::vx::FPGATime> bin_edges_type;
+
+	/**
+	 * Construct histogram with zero counts.
+	 * Spike times t are counted into bin i if bin_edges[i] <= t < bin_edges[i + 1].
+	 * @param labels Labels to count spikes of, spikes of other labels are not counted
+	 * @param bin_edges Strictly increasing FPGA time edges of the bins
+	 * @throws std::invalid_argument On labels being empty or containing duplicates, less than two
+	 * bin edges or bin edges not being strictly increasing
+	 */
+	SpikeHistogram(labels_type const& labels, bin_edges_type const& bin_edges) SYMBOL_VISIBLE;
+
+	SpikeHistogram(SpikeHistogram const&) = delete;
+	SpikeHistogram& operator=(SpikeHistogram const&) = delete;
+
+	labels_type const& get_labels() const SYMBOL_VISIBLE;
+	bin_edges_type const& get_bin_edges() const SYMBOL_VISIBLE;
+
+	size_t get_num_labels() const SYMBOL_VISIBLE;
+	size_t get_num_bins() const SYMBOL_VISIBLE;
+
+	/**
+	 * Count single spike.
+	 * @param label Label of spike
+	 * @param time FPGA time of spike
+	 */
+	void add(haldls::vx::SpikeLabel const& label, haldls::vx::FPGATime const& time) SYMBOL_VISIBLE;
+
+	/**
+	 * Count spikes of a range.
+	 * The histogram is locked once for the complete range.
+	 * @tparam InputIt Iterator type
+	 * @tparam Projection Callable returning a SpikeFromChip for a range element
+	 * @param begin Begin of range
+	 * @param end End of range
+	 * @param projection Projection of range elements to spikes
+	 */
+	template <typename InputIt, typename Projection>
+	void add(InputIt begin, InputIt end, Projection const& projection) GENPYBIND(hidden)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		for (; begin != end; ++begin) {
+			haldls::vx::SpikeFromChip const spike = projection(*begin);
+			add_unlocked(spike.get_label().value(), spike.get_fpga_time().value());
+		}
+	}
+
+	/**
+	 * Get count of given label row and bin.
+	 * @param label_index Index of label in labels given on construction
+	 * @param bin Index of bin
+	 * @return Count
+	 * @throws std::out_of_range On index out of range
+	 */
+	count_type get_count(size_t label_index, size_t bin) const SYMBOL_VISIBLE;
+
+	/**
+	 * Get all counts as row-major flat array.
+	 * @return Counts
+	 */
+	std::vector<count_type> get_counts() const SYMBOL_VISIBLE GENPYBIND(hidden);
+
+	/**
+	 * Get number of spikes not counted because of untracked label or time outside of all bins.
+	 * @return Number of spikes
+	 */
+	size_t get_num_ignored() const SYMBOL_VISIBLE;
+
+	/**
+	 * Reset all counts to zero.
+	 */
+	void reset() SYMBOL_VISIBLE;
+
+	GENPYBIND_MANUAL({
+		typedef ::stadls::vx::SpikeHistogram _histogram_type;
+		typedef _histogram_type::count_type _count_type;
+
+		// counts as 2D array of shape (labels, bins)
+		parent.def("to_numpy", [](_histogram_type const& self) {
+			auto const counts = self.get_counts();
+			pybind11::array_t<_count_type> ret({self.get_num_labels(), self.get_num_bins()});
+			std::copy(counts.begin(), counts.end(), ret.mutable_data());
+			return ret;
+		});
+
+		// rates as 2D array of shape (labels, bins) in spikes per FPGA clock cycle
+		parent.def("rates_to_numpy", [](_histogram_type const& self) {
+			auto const counts = self.get_counts();
+			auto const& edges = self.get_bin_edges();
+			pybind11::array_t<double> ret({self.get_num_labels(), self.get_num_bins()});
+			auto access = ret.mutable_unchecked<2>();
+			for (size_t row = 0; row < self.get_num_labels(); ++row) {
+				for (size_t bin = 0; bin < self.get_num_bins(); ++bin) {
+					access(row, bin) =
+					    static_cast<double>(counts[row * self.get_num_bins() + bin]) /
+					    static_cast<double>(edges[bin + 1].value() - edges[bin].value());
+				}
+			}
+			return ret;
+		});
+	})
+
+private:
+	typedef uint32_t row_type;
+	static constexpr row_type untracked_row = std::numeric_limits<row_type>::max();
+
+	void add_unlocked(
+	    haldls::vx::SpikeLabel::value_type const label, haldls::vx::FPGATime::value_type const time)
+	{
+		row_type const row = m_rows[label];
+		if ((row == untracked_row) || (time < m_bin_edges.front().value()) ||
+		    (time >= m_bin_edges.back().value())) {
+			m_num_ignored++;
+			return;
+		}
+		size_t bin;
+		if (m_bin_width) {
+			bin = (time - m_bin_edges.front().value()) / m_bin_width;
+		} else {
+			bin = std::distance(
+			          m_edge_values.begin(),
+			          std::upper_bound(m_edge_values.begin(), m_edge_values.end(), time)) -
+			      1;
+		}
+		m_counts[row * get_num_bins() + bin]++;
+	}
+
+	labels_type m_labels;
+	bin_edges_type m_bin_edges;
+	/** Raw bin edge values for binary search. */
+	std::vector<haldls::vx::FPGATime::value_type> m_edge_values;
+	/** Common width of all bins or zero if bins are not equidistant. */
+	haldls::vx::FPGATime::value_type m_bin_width;
+	/** Row of every possible label value. */
+	std::vector<row_type> m_rows;
+	std::vector<count_type> m_counts;
+	size_t m_num_ignored;
+	mutable std::mutex m_mutex;
+};
+
+} // namespace stadls::vx
@@ -0,0 +1,99 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "haldls/vx/event.h"
+#include "haldls/vx/timer.h"
+#include "hate/visibility.h"
+#include "stadls/vx/file_mapping.h"
+#include "stadls/vx/genpybind.h"
+#include "stadls/vx/playback_program_builder.h"
+
+namespace stadls::vx GENPYBIND_TAG_STADLS_VX {
+
+/**
+ * Spike train stored in a binary file, pre-packed for replay in many programs.
+ * The file holds the spike packs and their timer values in the packing produced by
+ * PlaybackProgramBuilder::write_spike_train() as flat fixed-size records, not encoded instructions.
+ * On construction the file is mapped read-only, validated and the records are encoded once into
+ * instructions held in memory.
+ * PlaybackProgramBuilder::write_spike_train(SpikeTrainFile const&) then copies these
+ * instructions into a builder, so repeated use only costs the copy.
+ */
+class GENPYBIND(visible, holder_type("std::shared_ptr<::stadls::vx::SpikeTrainFile>"))
+    SpikeTrainFile
+{
+public:
+	typedef std::vector<haldls::vx::Timer::Value> times_type;
+	typedef std::vector<haldls::vx::SpikeLabel> labels_type;
+
+	/**
+	 * Load spike train saved via save().
+	 * @param filename Path of file to read
+	 * @throws std::runtime_error On file not readable or not containing a valid spike train
+	 */
+	explicit SpikeTrainFile(std::string const& filename) SYMBOL_VISIBLE;
+
+	SpikeTrainFile(SpikeTrainFile const&) = delete;
+	SpikeTrainFile& operator=(SpikeTrainFile const&) = delete;
+
+	/**
+	 * Save spike train to file.
+	 * @param filename Path of file to write
+	 * @param times Non-decreasing timer values of spikes
+	 * @param labels Labels of spikes
+	 * @throws std::runtime_error On sizes not matching, times not being sorted or file not
+	 * writeable
+	 */
+	static void save(
+	    std::string const& filename,
+	    times_type const& times,
+	    labels_type const& labels) SYMBOL_VISIBLE;
+
+	/**
+	 * Get number of spikes.
+	 * @return Number of spikes
+	 */
+	size_t get_num_spikes() const SYMBOL_VISIBLE;
+
+	/**
+	 * Get number of spike packs.
+	 * @return Number of spike packs
+	 */
+	size_t get_num_packs() const SYMBOL_VISIBLE;
+
+	/**
+	 * Get timer value of last spike.
+	 * @return Timer value, zero for an empty spike train
+	 */
+	haldls::vx::Timer::Value get_end_time() const SYMBOL_VISIBLE;
+
+private:
+	friend PlaybackProgramBuilder;
+
+	/**
+	 * Spike pack of up to three co-temporal spikes as stored in the file.
+	 */
+	struct Record
+	{
+		uint64_t time;
+		uint16_t num_labels;
+		uint16_t labels[3];
+	};
+
+	static_assert(sizeof(Record) == 16, "Record layout is part of the file format.");
+
+	Record const* begin() const;
+	Record const* end() const;
+
+	detail::FileMapping m_mapping;
+	Record const* m_records;
+	size_t m_num_records;
+	size_t m_num_spikes;
+	/** Instructions of the spike train, copied by PlaybackProgramBuilder::write_spike_train(). */
+	PlaybackProgramBuilder m_builder;
+};
+
+} // namespace stadls::vx
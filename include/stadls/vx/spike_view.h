@@ -0,0 +1,108 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "haldls/vx/event.h"
+#include "hate/visibility.h"
+#include "stadls/vx/genpybind.h"
+
+#include <pybind11/numpy.h>
+
+namespace stadls::vx GENPYBIND_TAG_STADLS_VX {
+
+/**
+ * Read-only view of time-annotated spike events sharing ownership of the underlying storage.
+ * Copies of the view and numpy arrays created from it refer to the same storage, which stays
+ * valid as long as any of them exists, even if the originating program is executed again.
+ */
+class GENPYBIND(visible) SpikeView
+{
+public:
+	typedef haldls::vx::SpikeFromChip value_type;
+	typedef value_type const* const_iterator;
+	typedef std::vector<value_type> storage_type;
+
+	/** Construct empty view. */
+	SpikeView() SYMBOL_VISIBLE;
+
+	/**
+	 * Construct view of given storage.
+	 * @param storage Spike storage to refer to
+	 */
+	explicit SpikeView(std::shared_ptr<storage_type const> const& storage) SYMBOL_VISIBLE
+	    GENPYBIND(hidden);
+
+	/**
+	 * Get number of spikes.
+	 * @return Number of spikes
+	 */
+	size_t size() const SYMBOL_VISIBLE;
+
+	/**
+	 * Get whether view contains no spikes.
+	 * @return Boolean value
+	 */
+	bool empty() const SYMBOL_VISIBLE;
+
+	/**
+	 * Get pointer to contiguous spike storage.
+	 * @return Pointer to first spike
+	 */
+	value_type const* data() const SYMBOL_VISIBLE GENPYBIND(hidden);
+
+	const_iterator begin() const SYMBOL_VISIBLE GENPYBIND(hidden);
+	const_iterator end() const SYMBOL_VISIBLE GENPYBIND(hidden);
+
+	/**
+	 * Get spike at given index without bounds check.
+	 * @param index Index of spike
+	 * @return Spike
+	 */
+	value_type const& operator[](size_t index) const SYMBOL_VISIBLE GENPYBIND(hidden);
+
+	/**
+	 * Get spike at given index.
+	 * @param index Index of spike
+	 * @return Spike
+	 * @throws std::out_of_range On index not smaller than size()
+	 */
+	value_type const& at(size_t index) const SYMBOL_VISIBLE GENPYBIND(hidden);
+
+	/**
+	 * Get spikes as numpy array without copy.
+	 *
+	 * @note The array is read-only and exposed as flat numpy DTYPE with the same data layout as
+	 *       the underlying SpikeFromChipDType type, it keeps the storage alive.
+	 */
+	GENPYBIND_MANUAL({
+		typedef ::stadls::vx::SpikeView _view_type;
+		typedef ::haldls::vx::SpikeFromChip::SpikeFromChipDType _dtype;
+
+		parent.def("__len__", &_view_type::size);
+		parent.def("__getitem__", [](_view_type const& self, size_t const index) {
+			return self.at(index);
+		});
+		parent.def(
+		    "__iter__",
+		    [](_view_type const& self) {
+			    return pybind11::make_iterator(self.begin(), self.end());
+		    },
+		    pybind11::keep_alive<0, 1>());
+		parent.def("to_numpy", [](_view_type const& self) {
+			auto const owner = new _view_type(self);
+			pybind11::capsule base(
+			    owner, [](void* ptr) { delete reinterpret_cast<_view_type*>(ptr); });
+			pybind11::array_t<_dtype> ret(
+			    {self.size()}, {sizeof(_dtype)}, reinterpret_cast<_dtype const*>(self.data()),
+			    base);
+			ret.attr("setflags")(pybind11::arg("write") = false);
+			return ret;
+		});
+	})
+
+private:
+	std::shared_ptr<storage_type const> m_storage;
+};
+
+} // namespace stadls::vx
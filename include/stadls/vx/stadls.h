@@ -7,8 +7,16 @@ GENPYBIND_MANUAL({
 	parent->py::module::import("pyhaldls_vx");
 })
 
+#include "stadls/vx/encode_cache.h"
+#include "stadls/vx/executor_pool.h"
 #include "stadls/vx/init_generator.h"
+#include "stadls/vx/merge_spikes.h"
 #include "stadls/vx/playback_generator.h"
 #include "stadls/vx/playback_program.h"
 #include "stadls/vx/playback_program_builder.h"
 #include "stadls/vx/playback_program_executor.h"
+#include "stadls/vx/result_columns.h"
+#include "stadls/vx/result_stream.h"
+#include "stadls/vx/spike_histogram.h"
+#include "stadls/vx/spike_view.h"
+#include "stadls/vx/spike_train_file.h"
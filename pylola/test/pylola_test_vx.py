@@ -1,6 +1,7 @@
 #!/usr/bin/env python
 import os
 import unittest
+import numpy as np
 import pylola_vx as lola
 import pyhalco_hicann_dls_vx as halco
 
@@ -72,6 +73,33 @@ class TestPylolaVX(unittest.TestCase):
         row.amp_calibs.from_numpy(np_amp_calibs)
         self.assertEqual(row.amp_calibs[16], 3)
 
+    def test_synapse_matrix(self):
+        matrix = lola.SynapseMatrix()
+
+        matrix.weights[13][27] = 42
+        np_weights = matrix.weights.to_numpy()
+        self.assertEqual(np_weights.shape,
+                         (halco.SynapseRowOnSynram.size,
+                          halco.SynapseOnSynapseRow.size))
+        self.assertEqual(np_weights[13, 27], 42)
+        np_weights[14, 28] = 64
+        with self.assertRaisesRegex(RuntimeError,
+                                    r"range overflow: (\d+) > max\((\d+)\)"):
+            matrix.weights.from_numpy(np_weights)
+        self.assertEqual(matrix.weights[14][28], 0)
+        np_weights[14, 28] = 5
+        matrix.weights.from_numpy(np_weights)
+        self.assertEqual(matrix.weights[14][28], 5)
+
+        row_weights = matrix.weights[14].to_numpy()
+        self.assertEqual(row_weights.shape, (halco.SynapseOnSynapseRow.size,))
+        self.assertEqual(row_weights[28], 5)
+
+        view = np.asarray(matrix.weights)
+        self.assertFalse(view.flags.writeable)
+        matrix.weights[15][29] = 7
+        self.assertEqual(view[15, 29], 7)
+
     def test_ppu_elf_file(self):
         this_dir = os.path.dirname(os.path.realpath(__file__))
         elf_file = lola.PPUElfFile(
@@ -35,6 +35,11 @@ struct PlaybackProgram::Impl
 
 	std::vector<hardware_word_type> results;
 	PlaybackProgram::spikes_type spikes;
+
+	/// \brief Timer value after the last timing instruction, assuming a start at zero.
+	v2::hardware_time_type time = 0;
+	/// \brief Sum of all waits of the program.
+	v2::hardware_time_type runtime = 0;
 };
 
 PlaybackProgram::PlaybackProgram()
@@ -126,6 +131,14 @@ PlaybackProgram::ContainerTicket<T> PlaybackProgram::create_ticket(
 	return {new_sp, coord, offset, length};
 }
 
+hardware_time_type PlaybackProgram::get_runtime_estimate() const
+{
+	if (!m_impl)
+		throw std::logic_error("unexpected access to moved-from object");
+
+	return m_impl->runtime;
+}
+
 std::vector<std::vector<instruction_word_type> > const& PlaybackProgram::instruction_byte_blocks()
 	const
 {
@@ -163,18 +176,26 @@ void PlaybackProgramBuilder::set_time(time_type t)
 {
 	assert(m_program->m_impl);
 	m_program->m_impl->bld.set_time(t);
+	m_program->m_impl->time = t;
 }
 
 void PlaybackProgramBuilder::wait_until(time_type t)
 {
 	assert(m_program->m_impl);
 	m_program->m_impl->bld.wait_until(t);
+	auto& impl = *m_program->m_impl;
+	if (t > impl.time) {
+		impl.runtime += t - impl.time;
+		impl.time = t;
+	}
 }
 
 void PlaybackProgramBuilder::wait_for(time_type t)
 {
 	assert(m_program->m_impl);
 	m_program->m_impl->bld.wait_for(t);
+	m_program->m_impl->runtime += t;
+	m_program->m_impl->time += t;
 }
 
 void PlaybackProgramBuilder::fire(
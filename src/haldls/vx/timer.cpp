@@ -10,6 +10,11 @@ Timer::Value const Timer::Value::fpga_clock_cycles_per_us{fisch::vx::fpga_clock_
 
 Timer::Timer(Value const value) : m_value(value) {}
 
+Timer::Value Timer::get() const
+{
+	return Value(m_value.get().value());
+}
+
 void Timer::set(Value const value)
 {
 	m_value.set(value);
@@ -1,6 +1,17 @@
 #include "lola/vx/synapse.h"
 
+#include <algorithm>
+#include <array>
+#include <climits>
+#include <stdexcept>
 #include <boost/hana/adapt_struct.hpp>
+#include <cereal/types/utility.hpp>
+#include <cereal/types/vector.hpp>
+#include "fisch/vx/jtag.h"
+#include "fisch/vx/omnibus.h"
+#include "halco/common/cerealization_geometry.h"
+#include "halco/common/iter_all.h"
+#include "haldls/cerealization.h"
 #include "lola/vx/gray_scale.h"
 #include "lola/vx/hana.h"
 
@@ -101,6 +112,353 @@ std::ostream& operator<<(std::ostream& os, SynapseMatrix const& matrix)
 }
 
 
+namespace {
+
+/**
+ * Lookup tables for bulk encoding and decoding of synapse quads.
+ * Every byte of the two words of a quad holds one synapse entry, the first word its permuted
+ * weight and time calibration, the second word its address and amplitude calibration, cf.
+ * haldls::vx::SynapseQuad.
+ */
+class SynapseQuadTables
+{
+public:
+	typedef haldls::vx::SynapseQuad::Synapse::Weight Weight;
+
+	/** Number of bits per synapse entry in a word. */
+	static constexpr size_t entry_bits = CHAR_BIT;
+	/** Number of weight and address bits of an entry, the remaining bits hold calibration. */
+	static constexpr size_t value_bits = 6;
+	static constexpr haldls::vx::detail::raw_omnibus_type value_mask = (1u << value_bits) - 1;
+	static constexpr haldls::vx::detail::raw_omnibus_type entry_mask = (1u << entry_bits) - 1;
+
+	/** Synapse on row indexed by quad column times quad size plus entry on quad. */
+	std::array<
+	    halco::hicann_dls::vx::SynapseOnSynapseRow,
+	    halco::hicann_dls::vx::SynapseOnSynapseRow::size>
+	    synapses;
+
+	/**
+	 * Permutation of weight bits as connected to the DAC.
+	 * The permutation is an involution and therefore used for encoding and decoding.
+	 */
+	std::array<haldls::vx::detail::raw_omnibus_type, Weight::max + 1> weight_permutation;
+
+	static SynapseQuadTables const& get()
+	{
+		static SynapseQuadTables const tables;
+		return tables;
+	}
+
+private:
+	SynapseQuadTables()
+	{
+		using namespace halco::hicann_dls::vx;
+		using halco::common::iter_all;
+
+		for (auto const quad : iter_all<SynapseQuadColumnOnDLS>()) {
+			for (auto const entry : iter_all<EntryOnQuad>()) {
+				synapses[quad.toEnum() * EntryOnQuad::size + entry.toEnum()] =
+				    SynapseOnSynapseRow(entry, quad);
+			}
+		}
+
+		// the most significant bit is kept, the others are reversed
+		for (haldls::vx::detail::raw_omnibus_type weight = 0; weight <= Weight::max; ++weight) {
+			haldls::vx::detail::raw_omnibus_type permuted = weight & (1u << (value_bits - 1));
+			for (size_t bit = 0; bit < value_bits - 1; ++bit) {
+				if (weight & (1u << bit)) {
+					permuted |= 1u << (value_bits - 2 - bit);
+				}
+			}
+			weight_permutation[weight] = permuted;
+		}
+	}
+};
+
+} // namespace
+
+template <typename AddressT>
+std::vector<AddressT> SynapseMatrix::write_addresses(coordinate_type const& coord)
+{
+	using namespace halco::hicann_dls::vx;
+	using halco::common::iter_all;
+
+	std::vector<AddressT> ret;
+	ret.reserve(config_size_in_words);
+	for (auto const row : iter_all<SynapseRowOnSynram>()) {
+		for (auto const quad : iter_all<SynapseQuadColumnOnDLS>()) {
+			auto const quad_addresses = haldls::vx::SynapseQuad::addresses<AddressT>(
+			    SynapseQuadOnDLS(SynapseQuadOnSynram(quad, row), coord));
+			ret.insert(ret.end(), quad_addresses.begin(), quad_addresses.end());
+		}
+	}
+	return ret;
+}
+
+template <typename AddressT>
+std::vector<AddressT> SynapseMatrix::read_addresses(coordinate_type const& coord)
+{
+	return write_addresses<AddressT>(coord);
+}
+
+template SYMBOL_VISIBLE std::vector<halco::hicann_dls::vx::OmnibusChipAddress>
+SynapseMatrix::write_addresses(coordinate_type const& coord);
+template SYMBOL_VISIBLE std::vector<halco::hicann_dls::vx::OmnibusChipOverJTAGAddress>
+SynapseMatrix::write_addresses(coordinate_type const& coord);
+template SYMBOL_VISIBLE std::vector<halco::hicann_dls::vx::OmnibusChipAddress>
+SynapseMatrix::read_addresses(coordinate_type const& coord);
+template SYMBOL_VISIBLE std::vector<halco::hicann_dls::vx::OmnibusChipOverJTAGAddress>
+SynapseMatrix::read_addresses(coordinate_type const& coord);
+
+template <typename WordT>
+std::vector<WordT> SynapseMatrix::encode() const
+{
+	using namespace halco::hicann_dls::vx;
+	using halco::common::iter_all;
+	typedef haldls::vx::detail::raw_omnibus_type raw_type;
+	typedef SynapseQuadTables tables_type;
+	auto const& tables = tables_type::get();
+
+	std::vector<WordT> data;
+	data.reserve(config_size_in_words);
+	for (auto const row : iter_all<SynapseRowOnSynram>()) {
+		auto const& row_weights = weights[row];
+		auto const& row_addresses = addresses[row];
+		auto const& row_time_calibs = time_calibs[row];
+		auto const& row_amp_calibs = amp_calibs[row];
+
+		auto synapse = tables.synapses.begin();
+		for (size_t quad = 0; quad < SynapseQuadColumnOnDLS::size; ++quad) {
+			raw_type weight_word = 0;
+			raw_type address_word = 0;
+			for (size_t entry = 0; entry < EntryOnQuad::size; ++entry, ++synapse) {
+				size_t const shift = entry * tables_type::entry_bits;
+				weight_word |=
+				    (tables.weight_permutation[row_weights[*synapse].value()] |
+				     (static_cast<raw_type>(row_time_calibs[*synapse].value())
+				      << tables_type::value_bits))
+				    << shift;
+				address_word |=
+				    (static_cast<raw_type>(row_addresses[*synapse].value()) |
+				     (static_cast<raw_type>(row_amp_calibs[*synapse].value())
+				      << tables_type::value_bits))
+				    << shift;
+			}
+			data.push_back(static_cast<WordT>(fisch::vx::OmnibusData(weight_word)));
+			data.push_back(static_cast<WordT>(fisch::vx::OmnibusData(address_word)));
+		}
+	}
+	return data;
+}
+
+template SYMBOL_VISIBLE std::vector<fisch::vx::OmnibusChip> SynapseMatrix::encode() const;
+template SYMBOL_VISIBLE std::vector<fisch::vx::OmnibusChipOverJTAG> SynapseMatrix::encode() const;
+
+template <typename WordT>
+void SynapseMatrix::decode(WordT const* data)
+{
+	using namespace halco::hicann_dls::vx;
+	using halco::common::iter_all;
+	typedef haldls::vx::detail::raw_omnibus_type raw_type;
+	typedef SynapseQuadTables tables_type;
+	auto const& tables = tables_type::get();
+
+	for (auto const row : iter_all<SynapseRowOnSynram>()) {
+		auto& row_weights = weights[row];
+		auto& row_addresses = addresses[row];
+		auto& row_time_calibs = time_calibs[row];
+		auto& row_amp_calibs = amp_calibs[row];
+
+		auto synapse = tables.synapses.begin();
+		for (size_t quad = 0; quad < SynapseQuadColumnOnDLS::size; ++quad) {
+			raw_type const weight_word = (data++)->get();
+			raw_type const address_word = (data++)->get();
+			for (size_t entry = 0; entry < EntryOnQuad::size; ++entry, ++synapse) {
+				size_t const shift = entry * tables_type::entry_bits;
+				raw_type const weight_entry = (weight_word >> shift) & tables_type::entry_mask;
+				raw_type const address_entry = (address_word >> shift) & tables_type::entry_mask;
+				row_weights[*synapse] =
+				    Weight(tables.weight_permutation[weight_entry & tables_type::value_mask]);
+				row_time_calibs[*synapse] = TimeCalib(weight_entry >> tables_type::value_bits);
+				row_addresses[*synapse] = Address(address_entry & tables_type::value_mask);
+				row_amp_calibs[*synapse] = AmpCalib(address_entry >> tables_type::value_bits);
+			}
+		}
+	}
+}
+
+template SYMBOL_VISIBLE void SynapseMatrix::decode(fisch::vx::OmnibusChip const* data);
+template SYMBOL_VISIBLE void SynapseMatrix::decode(fisch::vx::OmnibusChipOverJTAG const* data);
+
+SynapseMatrixDelta::SynapseMatrixDelta() : m_quads() {}
+
+SynapseMatrixDelta::SynapseMatrixDelta(SynapseMatrix const& base, SynapseMatrix const& target) :
+    m_quads()
+{
+	using namespace halco::hicann_dls::vx;
+	using halco::common::iter_all;
+
+	for (auto const row : iter_all<SynapseRowOnSynram>()) {
+		// rows are contiguous, therefore unchanged rows are skipped by a linear comparison
+		if ((base.weights[row] == target.weights[row]) &&
+		    (base.addresses[row] == target.addresses[row]) &&
+		    (base.time_calibs[row] == target.time_calibs[row]) &&
+		    (base.amp_calibs[row] == target.amp_calibs[row])) {
+			continue;
+		}
+		for (auto const quad : iter_all<SynapseQuadColumnOnDLS>()) {
+			bool changed = false;
+			haldls::vx::SynapseQuad quad_config;
+			for (auto const entry : iter_all<EntryOnQuad>()) {
+				SynapseOnSynapseRow const column(entry, quad);
+				Synapse synapse;
+				synapse.set_weight(target.weights[row][column]);
+				synapse.set_address(target.addresses[row][column]);
+				synapse.set_time_calib(target.time_calibs[row][column]);
+				synapse.set_amp_calib(target.amp_calibs[row][column]);
+				quad_config.set_synapse(entry, synapse);
+				changed |= (base.weights[row][column] != synapse.get_weight()) ||
+				           (base.addresses[row][column] != synapse.get_address()) ||
+				           (base.time_calibs[row][column] != synapse.get_time_calib()) ||
+				           (base.amp_calibs[row][column] != synapse.get_amp_calib());
+			}
+			// iteration is in ascending order of quads, therefore appending keeps the order
+			if (changed) {
+				m_quads.emplace_back(SynapseQuadOnSynram(quad, row), quad_config);
+			}
+		}
+	}
+}
+
+typename SynapseMatrixDelta::entry_type& SynapseMatrixDelta::find_or_insert(
+    halco::hicann_dls::vx::SynapseQuadOnSynram const& coord, haldls::vx::SynapseQuad value)
+{
+	auto it = std::lower_bound(
+	    m_quads.begin(), m_quads.end(), coord, [](entry_type const& entry, auto const& quad) {
+		    return entry.first.toEnum() < quad.toEnum();
+	    });
+	if ((it == m_quads.end()) || (it->first != coord)) {
+		it = m_quads.emplace(it, coord, std::move(value));
+	}
+	return *it;
+}
+
+void SynapseMatrixDelta::set(
+    SynapseMatrix const& base,
+    halco::hicann_dls::vx::SynapseRowOnSynram const& row,
+    halco::hicann_dls::vx::SynapseOnSynapseRow const& column,
+    Synapse const& value)
+{
+	using namespace halco::hicann_dls::vx;
+	using halco::common::iter_all;
+
+	SynapseQuadOnSynram const coord(column.toSynapseQuadColumnOnDLS(), row);
+
+	haldls::vx::SynapseQuad base_quad;
+	for (auto const entry : iter_all<EntryOnQuad>()) {
+		SynapseOnSynapseRow const base_column(entry, column.toSynapseQuadColumnOnDLS());
+		Synapse synapse;
+		synapse.set_weight(base.weights[row][base_column]);
+		synapse.set_address(base.addresses[row][base_column]);
+		synapse.set_time_calib(base.time_calibs[row][base_column]);
+		synapse.set_amp_calib(base.amp_calibs[row][base_column]);
+		base_quad.set_synapse(entry, synapse);
+	}
+
+	find_or_insert(coord, std::move(base_quad)).second.set_synapse(column.toEntryOnQuad(), value);
+}
+
+void SynapseMatrixDelta::set(
+    halco::hicann_dls::vx::SynapseQuadOnSynram const& coord, haldls::vx::SynapseQuad const& value)
+{
+	find_or_insert(coord, value).second = value;
+}
+
+haldls::vx::SynapseQuad SynapseMatrixDelta::get(
+    halco::hicann_dls::vx::SynapseQuadOnSynram const& coord) const
+{
+	auto const it = std::lower_bound(
+	    m_quads.begin(), m_quads.end(), coord, [](entry_type const& entry, auto const& quad) {
+		    return entry.first.toEnum() < quad.toEnum();
+	    });
+	if ((it == m_quads.end()) || (it->first != coord)) {
+		throw std::out_of_range("Synapse quad not affected by delta.");
+	}
+	return it->second;
+}
+
+typename SynapseMatrixDelta::quads_type SynapseMatrixDelta::get_quads() const
+{
+	quads_type ret;
+	ret.reserve(m_quads.size());
+	for (auto const& entry : m_quads) {
+		ret.push_back(entry.first);
+	}
+	return ret;
+}
+
+size_t SynapseMatrixDelta::size() const
+{
+	return m_quads.size();
+}
+
+bool SynapseMatrixDelta::empty() const
+{
+	return m_quads.empty();
+}
+
+void SynapseMatrixDelta::clear()
+{
+	m_quads.clear();
+}
+
+void SynapseMatrixDelta::apply(SynapseMatrix& matrix) const
+{
+	using namespace halco::hicann_dls::vx;
+	using halco::common::iter_all;
+
+	for (auto const& [coord, quad_config] : m_quads) {
+		auto const row = coord.toSynapseRowOnSynram();
+		for (auto const entry : iter_all<EntryOnQuad>()) {
+			SynapseOnSynapseRow const column(entry, coord.toSynapseQuadColumnOnDLS());
+			auto const synapse = quad_config.get_synapse(entry);
+			matrix.weights[row][column] = synapse.get_weight();
+			matrix.addresses[row][column] = synapse.get_address();
+			matrix.time_calibs[row][column] = synapse.get_time_calib();
+			matrix.amp_calibs[row][column] = synapse.get_amp_calib();
+		}
+	}
+}
+
+bool SynapseMatrixDelta::operator==(SynapseMatrixDelta const& other) const
+{
+	return m_quads == other.m_quads;
+}
+
+bool SynapseMatrixDelta::operator!=(SynapseMatrixDelta const& other) const
+{
+	return !(*this == other);
+}
+
+std::ostream& operator<<(std::ostream& os, SynapseMatrixDelta const& delta)
+{
+	os << "SynapseMatrixDelta(" << std::endl;
+	for (auto const& [coord, quad_config] : delta.m_quads) {
+		os << "  " << coord << ": " << quad_config << std::endl;
+	}
+	os << ")";
+	return os;
+}
+
+template <typename Archive>
+void SynapseMatrixDelta::serialize(Archive& ar)
+{
+	ar(CEREAL_NVP(m_quads));
+}
+
+EXPLICIT_INSTANTIATE_CEREAL_SERIALIZE(SynapseMatrixDelta)
+
 CorrelationResetRow::CorrelationResetRow() {}
 
 bool CorrelationResetRow::operator==(CorrelationResetRow const& /* other */) const
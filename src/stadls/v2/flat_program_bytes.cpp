@@ -0,0 +1,56 @@
+#include "stadls/v2/flat_program_bytes.h"
+
+namespace stadls {
+namespace v2 {
+
+FlatProgramBytes::FlatProgramBytes() : bytes(), block_offsets{0} {}
+
+FlatProgramBytes::FlatProgramBytes(blocks_type const& blocks) : bytes(), block_offsets{0}
+{
+	block_offsets.reserve(blocks.size() + 1);
+	for (auto const& block : blocks) {
+		block_offsets.push_back(block_offsets.back() + block.size());
+	}
+	bytes.reserve(block_offsets.back());
+	for (auto const& block : blocks) {
+		bytes.insert(bytes.end(), block.begin(), block.end());
+	}
+}
+
+size_t FlatProgramBytes::num_blocks() const
+{
+	return block_offsets.size() - 1;
+}
+
+haldls::v2::instruction_word_type const* FlatProgramBytes::block_data(size_t const block) const
+{
+	return bytes.data() + block_offsets.at(block);
+}
+
+size_t FlatProgramBytes::block_size(size_t const block) const
+{
+	return block_offsets.at(block + 1) - block_offsets.at(block);
+}
+
+FlatProgramBytes::blocks_type FlatProgramBytes::to_blocks() const
+{
+	blocks_type blocks;
+	blocks.reserve(num_blocks());
+	for (size_t block = 0; block < num_blocks(); ++block) {
+		blocks.emplace_back(block_data(block), block_data(block) + block_size(block));
+	}
+	return blocks;
+}
+
+bool FlatProgramBytes::operator==(FlatProgramBytes const& other) const
+{
+	return (bytes == other.bytes) && (block_offsets == other.block_offsets);
+}
+
+bool FlatProgramBytes::operator!=(FlatProgramBytes const& other) const
+{
+	return !(*this == other);
+}
+
+} // namespace v2
+} // namespace stadls
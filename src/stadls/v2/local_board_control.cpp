@@ -1,8 +1,12 @@
 #include "stadls/v2/local_board_control.h"
 
+#include <algorithm>
 #include <chrono>
+#include <cstdint>
+#include <limits>
 #include <sstream>
 #include <thread>
+#include <utility>
 
 #include "flyspi-rw_api/flyspi_com.h"
 #include "halco/common/iter_all.h"
@@ -23,6 +27,16 @@
 
 namespace {
 
+/// \brief FPGA clock cycles per microsecond, the FPGA runs at 96 MHz
+constexpr haldls::v2::hardware_time_type fpga_cycles_per_us = 96;
+
+/// \brief weight of the latest observation in the learnt runtime correction
+constexpr double runtime_correction_weight = 0.25;
+
+/// \brief minimal time before the predicted end of a program from which on the execute flag is
+///        checked continuously
+constexpr std::chrono::microseconds min_spin_margin(100);
+
 // vvv ------8<----------- (legacy code copied from frickel-dls)
 
 struct Sdram_block_write_allocator
@@ -57,6 +71,31 @@ struct Sdram_block_write_allocator
 
 // ^^^ ------8<-----------
 
+typedef std::vector<std::vector<haldls::v2::instruction_word_type> > program_blocks_type;
+
+size_t num_program_blocks(program_blocks_type const& program_bytes)
+{
+	return program_bytes.size();
+}
+
+std::pair<haldls::v2::instruction_word_type const*, size_t> program_block(
+	program_blocks_type const& program_bytes, size_t const block)
+{
+	return std::make_pair(program_bytes[block].data(), program_bytes[block].size());
+}
+
+size_t num_program_blocks(stadls::v2::FlatProgramBytes const& program_bytes)
+{
+	return program_bytes.num_blocks();
+}
+
+// blocks are copied directly from the contiguous buffer
+std::pair<haldls::v2::instruction_word_type const*, size_t> program_block(
+	stadls::v2::FlatProgramBytes const& program_bytes, size_t const block)
+{
+	return std::make_pair(program_bytes.block_data(block), program_bytes.block_size(block));
+}
+
 struct UniDecoder
 {
 	std::vector<haldls::v2::hardware_word_type> words;
@@ -116,12 +155,49 @@ public:
 
 	Impl(std::string const& usb_serial_number) : com(usb_serial_number) {}
 
+	/// \brief size of each of the two alternating program and result regions used by run_many()
+	static hardware_address_type region_size()
+	{
+		return rw_api::FlyspiCom::SdramChannel::max_size / 2;
+	}
+
+	/// \brief size of program in SDRAM words
+	template <typename ProgramBytes>
+	static size_t program_size(ProgramBytes const& program_bytes);
+
+	/// \brief copies program to SDRAM and waits for completion of the transfer
+	/// \param address Start address of program
+	/// \param capacity Maximal size of program
+	/// \return Size of program
+	/// \throws std::runtime_error On program size exceeding capacity
+	template <typename ProgramBytes>
+	hardware_address_type upload(
+		ProgramBytes const& program_bytes,
+		hardware_address_type address,
+		hardware_address_type capacity);
+
+	/// \brief sets program to execute and address of its results
+	void select(
+		hardware_address_type address, hardware_address_type size, hardware_address_type results);
+
+	/// \brief reads size of results of last execution and checks for FPGA exceptions
+	hardware_word_type result_size();
+
+	/// \brief reads results of given size from SDRAM
+	std::vector<haldls::v2::instruction_word_type> read_results(
+		hardware_address_type address, hardware_word_type size);
+
 	rw_api::FlyspiCom com;
 
 	std::shared_ptr<haldls::v2::PlaybackProgram const> last_playback_program;
-	static constexpr hardware_address_type program_address = 0;
+	hardware_address_type program_address = 0;
 	hardware_address_type program_size = 0;
-	static constexpr hardware_address_type result_address = 0;
+	hardware_address_type result_address = 0;
+	std::chrono::steady_clock::time_point execution_start;
+
+	/// \brief runtime estimate of the transferred program in FPGA clock cycles, if known
+	hate::optional<haldls::v2::hardware_time_type> runtime_estimate;
+	ExecuteStatistics statistics;
 };
 
 LocalBoardControl::LocalBoardControl(std::string const& usb_serial_number)
@@ -193,6 +269,21 @@ void LocalBoardControl::configure_static(
 	execute();
 }
 
+void LocalBoardControl::configure_static(
+	std::vector<haldls::v2::ocp_address_type> const& board_addresses,
+	std::vector<haldls::v2::ocp_word_type> const& board_words,
+	FlatProgramBytes const& chip_program_bytes)
+{
+	if (!m_impl)
+		throw std::logic_error("unexpected access to moved-from object");
+
+	// Write the board config
+	ocp_write(m_impl->com, board_words, board_addresses);
+
+	transfer(chip_program_bytes);
+	execute();
+}
+
 void LocalBoardControl::configure_static(
 	haldls::v2::Board const& board, haldls::v2::Chip const& chip)
 {
@@ -237,11 +328,28 @@ std::shared_ptr<haldls::v2::PlaybackProgram> get_configure_program(haldls::v2::C
 }
 
 
-void LocalBoardControl::transfer(
-	std::vector<std::vector<haldls::v2::instruction_word_type> > const& program_bytes)
+template <typename ProgramBytes>
+size_t LocalBoardControl::Impl::program_size(ProgramBytes const& program_bytes)
 {
-	if (!m_impl)
-		throw std::logic_error("unexpected access to moved-from object");
+	size_t size = 0;
+	for (size_t block = 0; block < num_program_blocks(program_bytes); ++block) {
+		size += program_block(program_bytes, block).second / 4;
+	}
+	return size;
+}
+
+template <typename ProgramBytes>
+LocalBoardControl::Impl::hardware_address_type LocalBoardControl::Impl::upload(
+	ProgramBytes const& program_bytes,
+	hardware_address_type const address,
+	hardware_address_type const capacity)
+{
+	size_t const size = program_size(program_bytes);
+	if (size > capacity) {
+		throw std::runtime_error(
+			"program size(" + std::to_string(size) + ") exceeds SDRAM region(" +
+			std::to_string(capacity) + ")");
+	}
 
 	// vvv ------8<----------- (legacy code copied from frickel-dls)
 
@@ -249,15 +357,16 @@ void LocalBoardControl::transfer(
 
 	std::vector<SdramBlockWriteQuery> queries;
 	std::vector<SdramRequest> reqs;
-	Sdram_block_write_allocator alloc(m_impl->com, m_impl->program_address);
+	Sdram_block_write_allocator alloc(com, address);
 
 	// copy to USB buffer memory and transfer
-	for (auto const& container : program_bytes) {
-		queries.push_back(alloc.allocate(container.size() / 4));
+	for (size_t block = 0; block < num_program_blocks(program_bytes); ++block) {
+		auto const container = program_block(program_bytes, block);
+		queries.push_back(alloc.allocate(container.second / 4));
 
-		auto it_in = std::begin(container);
+		auto it_in = container.first;
 		auto it_out = uni::bytewise(std::begin(queries.back()));
-		while (it_in != std::end(container)) {
+		while (it_in != container.first + container.second) {
 			*it_out = *it_in;
 			++it_in;
 			++it_out;
@@ -273,18 +382,104 @@ void LocalBoardControl::transfer(
 
 	// ^^^ ------8<-----------
 
-	m_impl->program_size = alloc.address - m_impl->program_address;
+	return alloc.address - address;
+}
+
+void LocalBoardControl::Impl::select(
+	hardware_address_type const address,
+	hardware_address_type const size,
+	hardware_address_type const results)
+{
+	program_address = address;
+	program_size = size;
+	result_address = results;
 
 	// write program address, size and result pointer
-	haldls::v2::FlyspiProgramAddress program_address(m_impl->program_address);
-	haldls::v2::FlyspiProgramSize program_size(m_impl->program_size);
-	haldls::v2::FlyspiResultAddress result_address(m_impl->result_address);
+	haldls::v2::FlyspiProgramAddress program_address_config(program_address);
+	haldls::v2::FlyspiProgramSize program_size_config(program_size);
+	haldls::v2::FlyspiResultAddress result_address_config(result_address);
+
+	halco::common::Unique unique;
+
+	ocp_write_container(com, unique, program_address_config);
+	ocp_write_container(com, unique, program_size_config);
+	ocp_write_container(com, unique, result_address_config);
+}
+
+LocalBoardControl::Impl::hardware_word_type LocalBoardControl::Impl::result_size()
+{
+	auto log = log4cxx::Logger::getLogger("fetch");
 
 	halco::common::Unique unique;
+	auto result_size = ocp_read_container<haldls::v2::FlyspiResultSize>(com, unique);
+	if (!result_size.get_value()) {
+		throw std::logic_error("no result size read from board");
+	}
+	if (result_size.get_value().value() > rw_api::FlyspiCom::SdramChannel::max_size) {
+		throw std::logic_error(
+			"to be read back data(" + std::to_string(result_size.get_value().value()) +
+			") exceeds FPGA memory(" + std::to_string(rw_api::FlyspiCom::SdramChannel::max_size) + ")");
+	}
+	auto exception = ocp_read_container<haldls::v2::FlyspiException>(com, FlyspiExceptionOnFPGA());
+	if (!exception.check().value()) {
+		LOG4CXX_ERROR(log, "FPGA exception raised: " << exception);
+		throw std::logic_error("FPGA exception raised, aborting fetching");
+	}
+	return result_size.get_value().value();
+}
+
+std::vector<haldls::v2::instruction_word_type> LocalBoardControl::Impl::read_results(
+	hardware_address_type const address, hardware_word_type const size)
+{
+	// vvv ------8<----------- (legacy code copied from frickel-dls)
+
+	using namespace rw_api::flyspi;
+
+	// transfer data back
+	auto loc = com.locate().chip(0);
+	SdramBlockReadQuery q_read(com, loc, size);
+	q_read.addr(0x08000000 + address);
+
+	auto r_read = q_read.commit();
+	r_read.wait();
 
-	ocp_write_container(m_impl->com, unique, program_address);
-	ocp_write_container(m_impl->com, unique, program_size);
-	ocp_write_container(m_impl->com, unique, result_address);
+	// ^^^ ------8<-----------
+
+	// extract read/write results from data
+
+	std::vector<haldls::v2::instruction_word_type> bytes;
+	std::copy(
+		uni::raw_byte_iterator<rw_api::FlyspiCom::BufferType>(std::begin(r_read)),
+		uni::raw_byte_iterator<rw_api::FlyspiCom::BufferType>(std::end(r_read)),
+		std::back_inserter(bytes));
+	return bytes;
+}
+
+template <typename ProgramBytes>
+void LocalBoardControl::transfer_blocks(ProgramBytes const& program_bytes)
+{
+	if (!m_impl)
+		throw std::logic_error("unexpected access to moved-from object");
+
+	// a single program uses the complete memory
+	auto const program_size = m_impl->upload(
+		program_bytes, 0, std::numeric_limits<Impl::hardware_address_type>::max());
+	m_impl->select(0, program_size, 0);
+}
+
+void LocalBoardControl::transfer(
+	std::vector<std::vector<haldls::v2::instruction_word_type> > const& program_bytes)
+{
+	transfer_blocks(program_bytes);
+	m_impl->runtime_estimate = hate::nullopt;
+}
+
+void LocalBoardControl::transfer(
+	FlatProgramBytes const& program_bytes,
+	hate::optional<haldls::v2::hardware_time_type> const runtime_estimate)
+{
+	transfer_blocks(program_bytes);
+	m_impl->runtime_estimate = runtime_estimate;
 }
 
 void LocalBoardControl::transfer(
@@ -300,15 +495,12 @@ void LocalBoardControl::transfer(
 
 	m_impl->last_playback_program = playback_program;
 	transfer(playback_program->instruction_byte_blocks());
+	m_impl->runtime_estimate = playback_program->get_runtime_estimate();
 }
 
-void LocalBoardControl::execute(
-    std::chrono::microseconds min_wait_period,
-    std::chrono::microseconds max_wait_period,
-    std::chrono::microseconds max_wait,
-    hate::optional<std::chrono::microseconds> expected_runtime)
+void LocalBoardControl::start_execution()
 {
-	auto log = log4cxx::Logger::getLogger(__func__);
+	auto log = log4cxx::Logger::getLogger("execute");
 
 	if (!m_impl)
 		throw std::logic_error("unexpected access to moved-from object");
@@ -345,11 +537,44 @@ void LocalBoardControl::execute(
 	control.set_execute(true);
 	LOG4CXX_DEBUG(log, "start execution");
 	ocp_write_container(m_impl->com, FlyspiControlOnFPGA(), control);
+	m_impl->execution_start = std::chrono::steady_clock::now();
+}
+
+void LocalBoardControl::wait_for_execution(
+    std::chrono::microseconds min_wait_period,
+    std::chrono::microseconds max_wait_period,
+    std::chrono::microseconds max_wait,
+    hate::optional<std::chrono::microseconds> expected_runtime,
+    std::chrono::microseconds spin_window)
+{
+	auto log = log4cxx::Logger::getLogger("execute");
+
+	haldls::v2::FlyspiControl control;
+	control.set_execute(true);
+
+	auto const start = m_impl->execution_start;
+	// begin of the last check still seeing the execute flag set
+	auto last_busy = start;
+	size_t num_polls = 0;
+	auto const poll = [&]() {
+		auto const poll_begin = std::chrono::steady_clock::now();
+		control =
+		    ocp_read_container<haldls::v2::FlyspiControl>(m_impl->com, FlyspiControlOnFPGA());
+		num_polls++;
+		if (control.get_execute()) {
+			last_busy = poll_begin;
+		}
+	};
 
 	// wait until execute bit is cleared again
 	{
 		if (expected_runtime) {
-			std::this_thread::sleep_for(*expected_runtime);
+			std::this_thread::sleep_until(start + *expected_runtime);
+			// check continuously around the expected end to not overshoot by a wait period
+			auto const spin_end = std::chrono::steady_clock::now() + spin_window;
+			while (control.get_execute() && (std::chrono::steady_clock::now() < spin_end)) {
+				poll();
+			}
 		}
 		std::chrono::microseconds waited(0);
 		std::chrono::microseconds wait_period(min_wait_period);
@@ -357,8 +582,7 @@ void LocalBoardControl::execute(
 			LOG4CXX_DEBUG(
 			    log, "execute flag not yet cleared, sleep for " << wait_period.count() << "us");
 			std::this_thread::sleep_for(wait_period);
-			control =
-			    ocp_read_container<haldls::v2::FlyspiControl>(m_impl->com, FlyspiControlOnFPGA());
+			poll();
 
 			if (waited.count() > max_wait.count()) {
 				LOG4CXX_ERROR(
@@ -378,68 +602,107 @@ void LocalBoardControl::execute(
 			waited += wait_period;
 		}
 	}
+	auto const end = std::chrono::steady_clock::now();
 	LOG4CXX_DEBUG(log, "execution finished");
+
+	auto& statistics = m_impl->statistics;
+	statistics.num_executions++;
+	statistics.last_predicted_runtime =
+	    expected_runtime ? *expected_runtime : std::chrono::microseconds(0);
+	statistics.last_observed_runtime =
+	    std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+	statistics.last_latency =
+	    std::chrono::duration_cast<std::chrono::microseconds>(end - last_busy);
+	statistics.last_num_polls = num_polls;
+	statistics.total_latency += statistics.last_latency;
 }
 
-void LocalBoardControl::execute()
+void LocalBoardControl::execute(
+    std::chrono::microseconds min_wait_period,
+    std::chrono::microseconds max_wait_period,
+    std::chrono::microseconds max_wait,
+    hate::optional<std::chrono::microseconds> expected_runtime,
+    std::chrono::microseconds spin_window)
 {
-	execute(
-	    std::chrono::microseconds(50), // legacy value
-	    // 10ms max. period time for fine enough resolution in short sweeps
-	    std::chrono::microseconds(10000),
-	    // typical experiments don't last longer than 60s (PSP: 19.11.2018, OJB: 23.05.2018)
-	    std::chrono::microseconds(60*1000*1000));
+	start_execution();
+	wait_for_execution(min_wait_period, max_wait_period, max_wait, expected_runtime, spin_window);
 }
 
-std::vector<haldls::v2::instruction_word_type> LocalBoardControl::fetch()
+void LocalBoardControl::execute()
 {
-	auto log = log4cxx::Logger::getLogger(__func__);
-	if (!m_impl)
-		throw std::logic_error("unexpected access to moved-from object");
-
-	if (m_impl->program_size == 0)
-		throw std::runtime_error("fetch: no valid playback program has been transferred yet");
+	start_execution();
+	wait_for_execution();
+}
 
-	// get result size
-	halco::common::Unique unique;
-	auto result_size = ocp_read_container<haldls::v2::FlyspiResultSize>(m_impl->com, unique);
-	if (!result_size.get_value()) {
-		throw std::logic_error("no result size read from board");
+void LocalBoardControl::wait_for_execution(bool const overlapped)
+{
+	std::chrono::microseconds const min_wait_period(50); // legacy value
+	// 10ms max. period time for fine enough resolution in short sweeps
+	std::chrono::microseconds const max_wait_period(10000);
+	// typical experiments don't last longer than 60s (PSP: 19.11.2018, OJB: 23.05.2018)
+	std::chrono::microseconds const max_wait(60 * 1000 * 1000);
+
+	auto& statistics = m_impl->statistics;
+	if (!m_impl->runtime_estimate) {
+		wait_for_execution(min_wait_period, max_wait_period, max_wait, hate::nullopt);
+	} else {
+		std::chrono::microseconds const zero(0);
+		std::chrono::microseconds const estimate(*m_impl->runtime_estimate / fpga_cycles_per_us);
+		auto const predicted = std::max(estimate + statistics.runtime_correction, zero);
+		// wake up early by the uncertainty of the prediction and check continuously around its
+		// end
+		auto const margin = std::max(min_spin_margin, predicted / 16);
+		wait_for_execution(
+		    min_wait_period, max_wait_period, max_wait, std::max(predicted - margin, zero),
+		    2 * margin);
+		statistics.last_predicted_runtime = predicted;
 	}
-	if (result_size.get_value().value() > rw_api::FlyspiCom::SdramChannel::max_size) {
-		throw std::logic_error(
-			"to be read back data(" + std::to_string(result_size.get_value().value()) +
-			") exceeds FPGA memory(" + std::to_string(rw_api::FlyspiCom::SdramChannel::max_size) + ")");
+
+	if (overlapped) {
+		// the end of the execution is only observed after the transfers performed meanwhile,
+		// which would be learnt as instruction overhead and delay subsequent executions
+		statistics.total_latency -= statistics.last_latency;
+		return;
 	}
-	auto exception =
-	    ocp_read_container<haldls::v2::FlyspiException>(m_impl->com, FlyspiExceptionOnFPGA());
-	if (!exception.check().value()) {
-		LOG4CXX_ERROR(log, "FPGA exception raised: " << exception);
-		throw std::logic_error("FPGA exception raised, aborting fetching");
+	if (!m_impl->runtime_estimate) {
+		return;
 	}
 
-	// vvv ------8<----------- (legacy code copied from frickel-dls)
+	// the observed runtime includes the execution time of instructions and the time to observe
+	// the end, which are learnt as correction of the estimate
+	std::chrono::microseconds const estimate(*m_impl->runtime_estimate / fpga_cycles_per_us);
+	auto const deviation = statistics.last_observed_runtime - estimate;
+	statistics.runtime_correction = std::chrono::microseconds(static_cast<int64_t>(
+	    (1. - runtime_correction_weight) * statistics.runtime_correction.count() +
+	    runtime_correction_weight * deviation.count()));
+}
 
-	using namespace rw_api::flyspi;
+LocalBoardControl::ExecuteStatistics const& LocalBoardControl::get_execute_statistics() const
+{
+	if (!m_impl)
+		throw std::logic_error("unexpected access to moved-from object");
 
-	// transfer data back
-	auto loc = (m_impl->com).locate().chip(0);
-	SdramBlockReadQuery q_read((m_impl->com), loc, result_size.get_value().value());
-	q_read.addr(0x08000000 + m_impl->result_address);
+	return m_impl->statistics;
+}
 
-	auto r_read = q_read.commit();
-	r_read.wait();
+void LocalBoardControl::reset_execute_statistics()
+{
+	if (!m_impl)
+		throw std::logic_error("unexpected access to moved-from object");
 
-	// ^^^ ------8<-----------
+	m_impl->statistics = ExecuteStatistics();
+}
 
-	// extract read/write results from data
+std::vector<haldls::v2::instruction_word_type> LocalBoardControl::fetch()
+{
+	if (!m_impl)
+		throw std::logic_error("unexpected access to moved-from object");
 
-	std::vector<haldls::v2::instruction_word_type> bytes;
-	std::copy(
-		uni::raw_byte_iterator<rw_api::FlyspiCom::BufferType>(std::begin(r_read)),
-		uni::raw_byte_iterator<rw_api::FlyspiCom::BufferType>(std::end(r_read)),
-		std::back_inserter(bytes));
-	return bytes;
+	if (m_impl->program_size == 0)
+		throw std::runtime_error("fetch: no valid playback program has been transferred yet");
+
+	auto const result_size = m_impl->result_size();
+	return m_impl->read_results(m_impl->result_address, result_size);
 }
 
 void LocalBoardControl::fetch(std::shared_ptr<haldls::v2::PlaybackProgram> const& playback_program)
@@ -470,6 +733,15 @@ std::vector<haldls::v2::instruction_word_type> LocalBoardControl::run(
 	return fetch();
 }
 
+std::vector<haldls::v2::instruction_word_type> LocalBoardControl::run(
+	FlatProgramBytes const& program_bytes,
+	hate::optional<haldls::v2::hardware_time_type> const runtime_estimate)
+{
+	transfer(program_bytes, runtime_estimate);
+	execute();
+	return fetch();
+}
+
 void LocalBoardControl::run(std::shared_ptr<haldls::v2::PlaybackProgram> const& playback_program)
 {
 	transfer(playback_program);
@@ -477,6 +749,138 @@ void LocalBoardControl::run(std::shared_ptr<haldls::v2::PlaybackProgram> const&
 	fetch(playback_program);
 }
 
+template <typename ProgramBytes>
+void LocalBoardControl::run_pipelined(
+	std::vector<ProgramBytes const*> const& programs,
+	std::vector<hate::optional<haldls::v2::hardware_time_type> > const& runtime_estimates,
+	std::vector<std::vector<haldls::v2::instruction_word_type> >& results)
+{
+	if (!m_impl)
+		throw std::logic_error("unexpected access to moved-from object");
+
+	if (runtime_estimates.size() != programs.size()) {
+		throw std::runtime_error("Number of runtime estimates does not match number of programs.");
+	}
+
+	results.clear();
+	if (programs.empty()) {
+		return;
+	}
+	results.reserve(programs.size());
+	// SDRAM content no longer belongs to the previously transferred playback program
+	m_impl->last_playback_program.reset();
+
+	// programs not fitting into a region are run on their own using the complete memory
+	auto const fits_region = [&programs](size_t const index) {
+		return Impl::program_size(*programs[index]) <= Impl::region_size();
+	};
+	size_t begin = 0;
+	while (begin < programs.size()) {
+		if (!fits_region(begin)) {
+			transfer_blocks(*programs[begin]);
+			m_impl->runtime_estimate = runtime_estimates[begin];
+			execute();
+			results.push_back(fetch());
+			++begin;
+			continue;
+		}
+		size_t end = begin + 1;
+		while ((end < programs.size()) && fits_region(end)) {
+			++end;
+		}
+		run_overlapped(programs, runtime_estimates, begin, end, results);
+		begin = end;
+	}
+}
+
+template <typename ProgramBytes>
+void LocalBoardControl::run_overlapped(
+	std::vector<ProgramBytes const*> const& programs,
+	std::vector<hate::optional<haldls::v2::hardware_time_type> > const& runtime_estimates,
+	size_t const begin,
+	size_t const end,
+	std::vector<std::vector<haldls::v2::instruction_word_type> >& results)
+{
+	// program i and its results are located in region i % 2
+	auto const region_size = Impl::region_size();
+	auto const region_address = [region_size](size_t const index) {
+		return static_cast<Impl::hardware_address_type>((index % 2) * region_size);
+	};
+
+	auto program_size = m_impl->upload(*programs[begin], region_address(begin), region_size);
+	Impl::hardware_word_type result_size = 0;
+	for (size_t i = begin; i < end; ++i) {
+		m_impl->select(region_address(i), program_size, region_address(i));
+		m_impl->runtime_estimate = runtime_estimates[i];
+		start_execution();
+
+		// while program i is executed, the results of the previous program are fetched from and
+		// the next program is transferred to the other region
+		bool const overlapped = (i > begin) || (i + 1 < end);
+		try {
+			if (i > begin) {
+				results.push_back(m_impl->read_results(region_address(i - 1), result_size));
+			}
+			if (i + 1 < end) {
+				program_size =
+					m_impl->upload(*programs[i + 1], region_address(i + 1), region_size);
+			}
+		} catch (...) {
+			// program i is still executed and would interfere with subsequent executions
+			wait_for_execution(overlapped);
+			throw;
+		}
+
+		wait_for_execution(overlapped);
+		result_size = m_impl->result_size();
+		if (result_size > region_size) {
+			throw std::runtime_error(
+				"result size(" + std::to_string(result_size) + ") exceeds SDRAM region(" +
+				std::to_string(region_size) + ")");
+		}
+	}
+	results.push_back(m_impl->read_results(region_address(end - 1), result_size));
+}
+
+void LocalBoardControl::run_many(
+	std::vector<FlatProgramBytes const*> const& program_bytes,
+	std::vector<hate::optional<haldls::v2::hardware_time_type> > const& runtime_estimates,
+	std::vector<std::vector<haldls::v2::instruction_word_type> >& results)
+{
+	for (auto const program : program_bytes) {
+		if (!program) {
+			throw std::runtime_error("Trying to run nullptr program.");
+		}
+	}
+	run_pipelined(program_bytes, runtime_estimates, results);
+}
+
+void LocalBoardControl::run_many(
+	std::vector<std::shared_ptr<haldls::v2::PlaybackProgram> > const& playback_programs)
+{
+	if (!m_impl)
+		throw std::logic_error("unexpected access to moved-from object");
+
+	std::vector<program_blocks_type const*> program_bytes;
+	std::vector<hate::optional<haldls::v2::hardware_time_type> > runtime_estimates;
+	for (auto const& playback_program : playback_programs) {
+		if (!playback_program || !playback_program->valid()) {
+			throw std::logic_error("trying to transfer program with invalid state");
+		}
+		program_bytes.push_back(&playback_program->instruction_byte_blocks());
+		runtime_estimates.push_back(playback_program->get_runtime_estimate());
+	}
+
+	std::vector<std::vector<haldls::v2::instruction_word_type> > results;
+	run_pipelined(program_bytes, runtime_estimates, results);
+	for (size_t i = 0; i < playback_programs.size(); ++i) {
+		decode_result_bytes(results[i], playback_programs[i]);
+	}
+	if (!playback_programs.empty()) {
+		m_impl->last_playback_program = playback_programs.back();
+	}
+}
+
 void LocalBoardControl::run_experiment(
     haldls::v2::Board const& board,
     haldls::v2::Chip const& chip,
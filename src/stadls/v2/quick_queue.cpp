@@ -1,15 +1,23 @@
 #include "stadls/v2/quick_queue.h"
 
+#include <SF/string.hpp>
 #include <SF/vector.hpp>
 
+#include <algorithm>
 #include <chrono>
+#include <cstdint>
 #include <cstdlib>
 #include <functional>
+#include <limits>
 #include <sstream>
+#include <stdexcept>
+#include <string>
 #include <thread>
 #include <unordered_map> // needed for std::hash<std::string>
+#include <utility>
 #include <cereal/archives/binary.hpp>
 #include <cereal/cereal.hpp>
+#include <cereal/types/string.hpp>
 #include <cereal/types/vector.hpp>
 #include <sys/wait.h>
 
@@ -51,31 +59,141 @@ void serialize(SF::Archive& ar, haldls::v2::ocp_word_type& word)
 namespace stadls {
 namespace v2 {
 
+hate::optional<haldls::v2::hardware_time_type>
+QuickQueueRequest::get_playback_program_runtime_estimate() const
+{
+	// requests of clients not estimating the runtime carry the default value
+	if (playback_program_runtime_estimate == 0) {
+		return hate::nullopt;
+	}
+	return playback_program_runtime_estimate;
+}
+
+namespace {
+
+// Wire frames are written straight to and read straight from the binary stream of the archive,
+// see wire_format.h.
+
+wire_writer_type sf_writer(SF::Archive& ar)
+{
+	return [&ar](uint8_t const* const data, size_t const size) {
+		if (size > std::numeric_limits<uint32_t>::max()) {
+			throw std::runtime_error("Wire frame exceeds maximal size of archive.");
+		}
+		ar.getOstream()->writeRaw(reinterpret_cast<char const*>(data), static_cast<uint32_t>(size));
+	};
+}
+
+wire_reader_type sf_reader(SF::Archive& ar)
+{
+	return [&ar](uint8_t* const data, size_t const size) {
+		if (size > std::numeric_limits<uint32_t>::max()) {
+			throw std::runtime_error("Wire frame exceeds maximal size of archive.");
+		}
+		auto const read = ar.getIstream()->read(
+			reinterpret_cast<char*>(data), static_cast<uint32_t>(size));
+		if (read != size) {
+			throw std::runtime_error("Wire frame is truncated.");
+		}
+	};
+}
+
+template <class Archive>
+wire_writer_type cereal_writer(Archive& archive)
+{
+	return [&archive](uint8_t const* const data, size_t const size) {
+		archive(cereal::binary_data(data, size));
+	};
+}
+
+template <class Archive>
+wire_reader_type cereal_reader(Archive& archive)
+{
+	return [&archive](uint8_t* const data, size_t const size) {
+		archive(cereal::binary_data(data, size));
+	};
+}
+
+} // namespace
+
 template <class Archive>
 void QuickQueueRequest::serialize_detail(Archive& archive, std::false_type)
 {
 	archive(CEREAL_NVP(board_addresses));
 	archive(CEREAL_NVP(board_words));
-	archive(CEREAL_NVP(chip_program_bytes));
-	archive(CEREAL_NVP(playback_program_bytes));
+	if constexpr (Archive::is_saving::value) {
+		auto const writer = cereal_writer(archive);
+		write_wire_frame(chip_program_bytes, compression, writer);
+		write_wire_frame(playback_program_bytes, compression, writer);
+	} else {
+		auto const reader = cereal_reader(archive);
+		read_wire_frame(reader, chip_program_bytes);
+		read_wire_frame(reader, playback_program_bytes);
+	}
+	archive(CEREAL_NVP(playback_program_runtime_estimate));
 }
 
 template <class Archive>
 void QuickQueueRequest::serialize_detail(Archive& ar, std::true_type)
 {
-	ar& board_addresses& board_words& chip_program_bytes& playback_program_bytes;
+	ar& board_addresses& board_words;
+	if (ar.isWrite()) {
+		auto const writer = sf_writer(ar);
+		write_wire_frame(chip_program_bytes, compression, writer);
+		write_wire_frame(playback_program_bytes, compression, writer);
+	} else {
+		auto const reader = sf_reader(ar);
+		read_wire_frame(reader, chip_program_bytes);
+		read_wire_frame(reader, playback_program_bytes);
+	}
+	ar& playback_program_runtime_estimate;
 }
 
 template <class Archive>
 void QuickQueueResponse::serialize_detail(Archive& archive, std::false_type)
 {
-	archive(CEREAL_NVP(result_bytes));
+	if constexpr (Archive::is_saving::value) {
+		write_wire_frame(result_bytes, compression, cereal_writer(archive));
+	} else {
+		read_wire_frame(cereal_reader(archive), result_bytes);
+	}
 }
 
 template <class Archive>
 void QuickQueueResponse::serialize_detail(Archive& ar, std::true_type)
 {
-	ar& result_bytes;
+	if (ar.isWrite()) {
+		write_wire_frame(result_bytes, compression, sf_writer(ar));
+	} else {
+		read_wire_frame(sf_reader(ar), result_bytes);
+	}
+}
+
+template <class Archive>
+void QuickQueueBatchRequest::serialize_detail(Archive& archive, std::false_type)
+{
+	archive(CEREAL_NVP(requests));
+	archive(CEREAL_NVP(accepted_compressions));
+}
+
+template <class Archive>
+void QuickQueueBatchRequest::serialize_detail(Archive& ar, std::true_type)
+{
+	ar& requests& accepted_compressions;
+}
+
+template <class Archive>
+void QuickQueueBatchResponse::serialize_detail(Archive& archive, std::false_type)
+{
+	archive(CEREAL_NVP(responses));
+	archive(CEREAL_NVP(error_messages));
+	archive(CEREAL_NVP(capabilities));
+}
+
+template <class Archive>
+void QuickQueueBatchResponse::serialize_detail(Archive& ar, std::true_type)
+{
+	ar& responses& error_messages& capabilities;
 }
 
 // excplicit instantiation to fix build problems with jenkins (builds locally but fails with missing
@@ -83,6 +201,22 @@ void QuickQueueResponse::serialize_detail(Archive& ar, std::true_type)
 // TODO: investigate
 template void QuickQueueRequest::serialize_detail<SF::Archive>(SF::Archive& ar, std::true_type);
 template void QuickQueueResponse::serialize_detail<SF::Archive>(SF::Archive& ar, std::true_type);
+template void QuickQueueBatchRequest::serialize_detail<SF::Archive>(
+	SF::Archive& ar, std::true_type);
+template void QuickQueueBatchResponse::serialize_detail<SF::Archive>(
+	SF::Archive& ar, std::true_type);
+
+#define QUICK_QUEUE_CEREAL_INSTANTIATION(Type)                                                     \
+	template void Type::serialize_detail<cereal::BinaryOutputArchive>(                             \
+	    cereal::BinaryOutputArchive & archive, std::false_type);                                   \
+	template void Type::serialize_detail<cereal::BinaryInputArchive>(                              \
+	    cereal::BinaryInputArchive & archive, std::false_type);
+
+QUICK_QUEUE_CEREAL_INSTANTIATION(QuickQueueRequest)
+QUICK_QUEUE_CEREAL_INSTANTIATION(QuickQueueResponse)
+QUICK_QUEUE_CEREAL_INSTANTIATION(QuickQueueBatchRequest)
+QUICK_QUEUE_CEREAL_INSTANTIATION(QuickQueueBatchResponse)
+#undef QUICK_QUEUE_CEREAL_INSTANTIATION
 
 
 QuickQueueRequest create_request(
@@ -96,14 +230,57 @@ QuickQueueRequest create_request(
 	visit_preorder(board, coord, WriteAddressVisitor<ocp_addresses_type>{req.board_addresses});
 	visit_preorder(board, coord, EncodeVisitor<ocp_words_type>{req.board_words});
 
-	req.chip_program_bytes = get_configure_program(chip)->instruction_byte_blocks();
-	req.playback_program_bytes = playback_program->instruction_byte_blocks();
+	req.chip_program_bytes =
+		FlatProgramBytes(get_configure_program(chip)->instruction_byte_blocks());
+	req.playback_program_bytes = FlatProgramBytes(playback_program->instruction_byte_blocks());
+	req.playback_program_runtime_estimate = playback_program->get_runtime_estimate();
 	return req;
 }
 
 
+namespace {
+
+/**
+ * Get 64-bit FNV-1a hash of the static configuration of a request.
+ * Sizes of all sequences are included, so that differently split data does not collide.
+ * @param req Request
+ * @return Fingerprint
+ */
+uint64_t static_config_fingerprint(QuickQueueRequest const& req)
+{
+	uint64_t hash = 14695981039346656037ull;
+	auto const mix = [&hash](uint64_t const value) {
+		hash ^= value;
+		hash *= 1099511628211ull;
+	};
+
+	mix(req.board_addresses.size());
+	for (auto const& address : req.board_addresses) {
+		mix(address.value);
+	}
+	mix(req.board_words.size());
+	for (auto const& word : req.board_words) {
+		mix(word.value);
+	}
+	mix(req.chip_program_bytes.num_blocks());
+	for (size_t block = 0; block < req.chip_program_bytes.num_blocks(); ++block) {
+		mix(req.chip_program_bytes.block_size(block));
+	}
+	for (auto const byte : req.chip_program_bytes.bytes) {
+		mix(byte);
+	}
+	return hash;
+}
+
+} // namespace
+
 QuickQueueWorker::QuickQueueWorker(std::string const& usb_serial)
-	: m_usb_serial(usb_serial), m_has_slurm_allocation(false), m_mock_mode(false)
+	: m_usb_serial(usb_serial),
+	  m_has_slurm_allocation(false),
+	  m_mock_mode(false),
+	  m_reuse_static_config(false),
+	  m_static_config_fingerprint(),
+	  m_num_static_configurations(0)
 {
 	char const* env_partition = std::getenv(m_env_name_partition);
 	if (env_partition == nullptr) {
@@ -167,6 +344,8 @@ void QuickQueueWorker::setup()
 		LOG4CXX_DEBUG(log, "Setting up LocalBoardControl.");
 		// TODO have the experiment control timeout (e.g. when the board is unresponsive)
 		m_local_board_ctrl.reset(new LocalBoardControl(m_usb_serial));
+		// state of freshly allocated board is unknown
+		m_static_config_fingerprint.reset();
 	} else {
 		LOG4CXX_DEBUG(log, "Operating in mock-mode - no LocalBoardControl allocated.");
 	}
@@ -177,6 +356,7 @@ void QuickQueueWorker::teardown()
 {
 	if (!m_mock_mode) {
 		m_local_board_ctrl.reset();
+		m_static_config_fingerprint.reset();
 		free_slurm_allocation();
 	}
 	auto log = log4cxx::Logger::getLogger("QuickQueueWorker");
@@ -215,21 +395,84 @@ void QuickQueueWorker::free_slurm_allocation()
 	}
 }
 
-QuickQueueResponse QuickQueueWorker::work(QuickQueueRequest const& req)
+QuickQueueBatchResponse QuickQueueWorker::work(QuickQueueBatchRequest const& batch)
+{
+	auto log = log4cxx::Logger::getLogger("QuickQueueWorker");
+	if (log->isEnabledFor(log4cxx::Level::getDebug())) {
+		std::stringstream ss;
+		ss << "Running batch of " << batch.requests.size() << " experiment(s).";
+		LOG4CXX_DEBUG(log, ss.str());
+	}
+
+	QuickQueueBatchResponse response;
+	response.responses.resize(batch.requests.size());
+	response.error_messages.resize(batch.requests.size());
+	// results are compressed if supported by the client
+	auto const compression = negotiate_wire_compression(batch.accepted_compressions);
+	size_t begin = 0;
+	while (begin < batch.requests.size()) {
+		// experiments sharing the static configuration loaded once are pipelined
+		size_t end = begin + 1;
+		if (m_reuse_static_config) {
+			uint64_t const fingerprint = static_config_fingerprint(batch.requests[begin]);
+			while ((end < batch.requests.size()) &&
+			       (static_config_fingerprint(batch.requests[end]) == fingerprint)) {
+				++end;
+			}
+		}
+
+		// first experiment without results if an error occurs
+		size_t first_failed = begin;
+		try {
+			if (end - begin == 1) {
+				response.responses[begin] = work_single(batch.requests[begin]);
+			} else {
+				work_pipelined(batch.requests, begin, end, response.responses, first_failed);
+			}
+		} catch (const rw_api::LogicError&) {
+			// worker is torn down, remaining experiments can't be executed
+			m_static_config_fingerprint.reset();
+			throw;
+		} catch (const std::exception& e) {
+			// a failed experiment leaves the loaded configuration unknown
+			m_static_config_fingerprint.reset();
+			std::string message = e.what();
+			if (message.empty()) {
+				message = "Unknown error.";
+			}
+			for (size_t i = first_failed; i < end; ++i) {
+				response.error_messages[i] = message;
+			}
+			std::stringstream ss;
+			ss << "Experiment(s) " << first_failed << " to " << end - 1
+			   << " of batch failed: " << message;
+			LOG4CXX_WARN(log, ss.str());
+		}
+		begin = end;
+	}
+
+	for (auto& single_response : response.responses) {
+		single_response.compression = compression;
+	}
+	return response;
+}
+
+QuickQueueResponse QuickQueueWorker::work_single(QuickQueueRequest const& req)
 {
 	auto log = log4cxx::Logger::getLogger("QuickQueueWorker");
 	QuickQueueResponse response;
 
+	configure_static(req);
 	if (m_mock_mode) {
 		LOG4CXX_DEBUG(log, "Running mock-experiment!");
+		check_mock_request(req);
 		return response;
 	}
 	LOG4CXX_DEBUG(log, "Running experiment!");
 
-	m_local_board_ctrl->configure_static(
-		req.board_addresses, req.board_words, req.chip_program_bytes);
 	try {
-		response.result_bytes = m_local_board_ctrl->run(req.playback_program_bytes);
+		response.result_bytes = m_local_board_ctrl->run(
+			req.playback_program_bytes, req.get_playback_program_runtime_estimate());
 	} catch (const rw_api::LogicError& e) {
 		// TODO: Power cycle board
 		teardown();
@@ -239,6 +482,87 @@ QuickQueueResponse QuickQueueWorker::work(QuickQueueRequest const& req)
 	return response;
 }
 
+void QuickQueueWorker::work_pipelined(
+	std::vector<QuickQueueRequest> const& requests,
+	size_t const begin,
+	size_t const end,
+	std::vector<QuickQueueResponse>& responses,
+	size_t& first_failed)
+{
+	auto log = log4cxx::Logger::getLogger("QuickQueueWorker");
+	if (log->isEnabledFor(log4cxx::Level::getDebug())) {
+		std::stringstream ss;
+		ss << "Running " << end - begin << " experiments pipelined!";
+		LOG4CXX_DEBUG(log, ss.str());
+	}
+
+	first_failed = begin;
+	configure_static(requests.at(begin));
+	if (m_mock_mode) {
+		for (; first_failed < end; ++first_failed) {
+			check_mock_request(requests.at(first_failed));
+		}
+		return;
+	}
+
+	std::vector<FlatProgramBytes const*> program_bytes;
+	std::vector<hate::optional<haldls::v2::hardware_time_type> > runtime_estimates;
+	for (size_t i = begin; i < end; ++i) {
+		program_bytes.push_back(&requests.at(i).playback_program_bytes);
+		runtime_estimates.push_back(requests.at(i).get_playback_program_runtime_estimate());
+	}
+
+	// results are complete for all experiments preceding a failed one
+	std::vector<std::vector<haldls::v2::instruction_word_type> > results;
+	auto const store_results = [&]() {
+		for (size_t i = 0; i < results.size(); ++i) {
+			responses.at(begin + i).result_bytes = std::move(results[i]);
+		}
+		first_failed = begin + results.size();
+	};
+	try {
+		m_local_board_ctrl->run_many(program_bytes, runtime_estimates, results);
+	} catch (const rw_api::LogicError& e) {
+		// TODO: Power cycle board
+		teardown();
+		LOG4CXX_ERROR(log, "FPGA seems to be hung.");
+		throw;
+	} catch (const std::exception&) {
+		store_results();
+		throw;
+	}
+	store_results();
+}
+
+void QuickQueueWorker::configure_static(QuickQueueRequest const& req)
+{
+	auto log = log4cxx::Logger::getLogger("QuickQueueWorker");
+
+	// reconfiguration includes waiting for the CapMem to settle, therefore it is only performed if
+	// the configuration differs from the one loaded
+	uint64_t const fingerprint = static_config_fingerprint(req);
+	if (m_reuse_static_config && (m_static_config_fingerprint == fingerprint)) {
+		LOG4CXX_DEBUG(log, "Static configuration unchanged, skipping reconfiguration.");
+	} else {
+		// loaded configuration is unknown if configuration fails
+		m_static_config_fingerprint.reset();
+		if (!m_mock_mode) {
+			m_local_board_ctrl->configure_static(
+				req.board_addresses, req.board_words, req.chip_program_bytes);
+		}
+		m_static_config_fingerprint = fingerprint;
+		m_num_static_configurations++;
+	}
+}
+
+void QuickQueueWorker::check_mock_request(QuickQueueRequest const& req)
+{
+	// the hardware refuses to execute an empty program
+	if (req.playback_program_bytes.bytes.empty()) {
+		throw std::runtime_error("execute: no valid playback program has been transferred yet");
+	}
+}
+
 std::optional<size_t> QuickQueueWorker::verify_user(std::string const& user_data)
 {
 	auto log = log4cxx::Logger::getLogger("QuickQueueWorker");
@@ -275,9 +599,15 @@ struct QuickQueueClient::Impl
 
 	void setup_client(const std::string& std, uint16_t port);
 
-	typedef typename QuickQueueServer::rcf_interface_t rcf_interface_t;
+	// submit batch to server, retrying while the server is not ready yet
+	// Requests are compressed if the server announced support for it in a previous response.
+	QuickQueueBatchResponse submit(QuickQueueBatchRequest& batch);
+
+	typedef typename QuickQueueBatchServer::rcf_interface_t rcf_interface_t;
 
 	std::unique_ptr<RcfClient<rcf_interface_t> > m_client;
+	// compressions accepted by the server, unknown before the first response
+	std::optional<wire_capabilities_type> m_server_capabilities;
 };
 
 QuickQueueClient::Impl::Impl()
@@ -360,11 +690,80 @@ void QuickQueueClient::run_experiment(
     haldls::v2::Board const& board,
     haldls::v2::Chip const& chip,
     std::shared_ptr<haldls::v2::PlaybackProgram> const& playback_program)
+{
+	QuickQueueBatchRequest batch;
+	batch.requests.push_back(create_request(board, chip, playback_program));
+
+	auto const response = m_impl->submit(batch);
+	if (response.responses.size() != 1 || response.error_messages.size() != 1) {
+		throw std::logic_error("Number of responses does not match number of requests.");
+	}
+	if (!response.error_messages.front().empty()) {
+		throw std::runtime_error(response.error_messages.front());
+	}
+
+	// decode received bytes
+	LocalBoardControl::decode_result_bytes(
+	    response.responses.front().result_bytes, playback_program);
+}
+
+std::vector<std::string> QuickQueueClient::run_experiments(
+    std::vector<haldls::v2::Board> const& boards,
+    std::vector<haldls::v2::Chip> const& chips,
+    std::vector<std::shared_ptr<haldls::v2::PlaybackProgram> > const& playback_programs)
+{
+	if (boards.size() != playback_programs.size() || chips.size() != playback_programs.size()) {
+		throw std::runtime_error("Number of boards, chips and playback programs do not match.");
+	}
+
+	QuickQueueBatchRequest batch;
+	batch.requests.reserve(playback_programs.size());
+	for (size_t i = 0; i < playback_programs.size(); ++i) {
+		if (i > 0 && boards[i] == boards[i - 1] && chips[i] == chips[i - 1]) {
+			// reuse encoded static configuration of previous experiment
+			auto const& previous = batch.requests.back();
+			QuickQueueRequest req;
+			req.board_addresses = previous.board_addresses;
+			req.board_words = previous.board_words;
+			req.chip_program_bytes = previous.chip_program_bytes;
+			req.playback_program_bytes =
+				FlatProgramBytes(playback_programs[i]->instruction_byte_blocks());
+			req.playback_program_runtime_estimate = playback_programs[i]->get_runtime_estimate();
+			batch.requests.push_back(std::move(req));
+		} else {
+			batch.requests.push_back(create_request(boards[i], chips[i], playback_programs[i]));
+		}
+	}
+
+	auto const response = m_impl->submit(batch);
+	if (response.responses.size() != batch.requests.size() ||
+	    response.error_messages.size() != batch.requests.size()) {
+		throw std::logic_error("Number of responses does not match number of requests.");
+	}
+
+	// decode received bytes of successful experiments
+	for (size_t i = 0; i < playback_programs.size(); ++i) {
+		if (response.error_messages[i].empty()) {
+			LocalBoardControl::decode_result_bytes(
+			    response.responses[i].result_bytes, playback_programs[i]);
+		}
+	}
+	return response.error_messages;
+}
+
+QuickQueueBatchResponse QuickQueueClient::Impl::submit(QuickQueueBatchRequest& batch)
 {
 	auto log = log4cxx::Logger::getLogger("QuickQueueClient");
 
-	QuickQueueRequest req = create_request(board, chip, playback_program);
-	QuickQueueResponse response;
+	auto const compression = m_server_capabilities
+		? negotiate_wire_compression(*m_server_capabilities)
+		: WireCompression::none;
+	for (auto& request : batch.requests) {
+		request.compression = compression;
+	}
+	batch.accepted_compressions = local_wire_capabilities();
+
+	QuickQueueBatchResponse response;
 
 	// TODO make adjustable
 	size_t max_connection_attempts = 10;
@@ -374,9 +773,16 @@ void QuickQueueClient::run_experiment(
 		 ++num_connection_attempts) {
 		// build request and send it to server
 		try {
-			response = m_impl->m_client->submit_work(req);
+			response = m_client->submit_work(batch);
+			m_server_capabilities = response.capabilities;
 			break;
 		} catch (const RCF::Exception& e) {
+			if (e.getErrorId() == RCF::RcfError_UnknownInterface) {
+				throw std::runtime_error(
+					"Server does not provide the QuickQueueBatchServer interface, its version "
+					"does not match the client: " +
+					e.getErrorString());
+			}
 			if (e.getErrorId() != RCF::RcfError_ClientConnectFail ||
 				num_connection_attempts == max_connection_attempts - 1) {
 				// reraise if something unexpected happened or we reached the
@@ -392,9 +798,7 @@ void QuickQueueClient::run_experiment(
 		LOG4CXX_INFO(log, ss.str());
 		std::this_thread::sleep_for(std::chrono::seconds(wait_after_connection_attempt_secs));
 	}
-
-	// decode received bytes
-	LocalBoardControl::decode_result_bytes(response.result_bytes, playback_program);
+	return response;
 }
 
 } // namespace v2
@@ -0,0 +1,286 @@
+#include "stadls/v2/wire_format.h"
+
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#ifdef USE_LZ4_COMPRESSION
+#include <lz4.h>
+#endif
+
+namespace stadls {
+namespace v2 {
+
+namespace {
+
+/// \brief "QQWF" in little endian byte order
+constexpr uint32_t wire_frame_magic = 0x46575151;
+constexpr uint8_t wire_frame_version = 1;
+
+/// \brief header at the beginning of every frame, followed by block sizes and payload
+struct WireFrameHeader
+{
+	uint32_t magic;
+	uint8_t version;
+	uint8_t compression;
+	uint16_t reserved;
+	uint64_t num_blocks;
+	uint64_t raw_size;
+	uint64_t payload_size;
+};
+
+static_assert(sizeof(WireFrameHeader) == 32, "Wire frame header layout is part of the protocol.");
+
+constexpr wire_capabilities_type capability(WireCompression const compression)
+{
+	return wire_capabilities_type(1) << static_cast<uint8_t>(compression);
+}
+
+#ifdef USE_LZ4_COMPRESSION
+/// \brief buffer of compressed payloads, reused to not allocate for every frame
+std::vector<uint8_t>& compression_buffer()
+{
+	thread_local std::vector<uint8_t> buffer;
+	return buffer;
+}
+#endif
+
+void write_frame(
+	uint8_t const* data,
+	std::vector<uint64_t> const& block_sizes,
+	uint64_t const raw_size,
+	WireCompression const compression,
+	wire_writer_type const& writer)
+{
+	WireFrameHeader header{};
+	header.magic = wire_frame_magic;
+	header.version = wire_frame_version;
+	header.compression = static_cast<uint8_t>(WireCompression::none);
+	header.num_blocks = block_sizes.size();
+	header.raw_size = raw_size;
+	header.payload_size = raw_size;
+	uint8_t const* payload = data;
+
+#ifdef USE_LZ4_COMPRESSION
+	if ((compression == WireCompression::lz4) && (raw_size > 0) &&
+	    (raw_size <= static_cast<uint64_t>(LZ4_MAX_INPUT_SIZE))) {
+		auto& buffer = compression_buffer();
+		int const bound = LZ4_compressBound(static_cast<int>(raw_size));
+		buffer.resize(bound);
+		int const compressed_size = LZ4_compress_default(
+			reinterpret_cast<char const*>(data), reinterpret_cast<char*>(buffer.data()),
+			static_cast<int>(raw_size), bound);
+		// incompressible data is sent as is
+		if ((compressed_size > 0) && (static_cast<uint64_t>(compressed_size) < raw_size)) {
+			header.compression = static_cast<uint8_t>(WireCompression::lz4);
+			header.payload_size = compressed_size;
+			payload = buffer.data();
+		}
+	}
+#else
+	static_cast<void>(compression);
+#endif
+
+	writer(reinterpret_cast<uint8_t const*>(&header), sizeof(header));
+	if (!block_sizes.empty()) {
+		writer(
+			reinterpret_cast<uint8_t const*>(block_sizes.data()),
+			block_sizes.size() * sizeof(uint64_t));
+	}
+	if (header.payload_size > 0) {
+		writer(payload, header.payload_size);
+	}
+}
+
+/// \brief reads and validates header and block sizes of a frame
+/// \param block_offsets Offsets of the blocks in the decoded payload, see FlatProgramBytes
+WireFrameHeader read_frame_prefix(
+	wire_reader_type const& reader, std::vector<uint64_t>& block_offsets)
+{
+	WireFrameHeader header;
+	reader(reinterpret_cast<uint8_t*>(&header), sizeof(header));
+	if (header.magic != wire_frame_magic) {
+		throw std::runtime_error("Data is not a wire frame.");
+	}
+	if (header.version != wire_frame_version) {
+		throw std::runtime_error(
+			"Unsupported wire frame version " + std::to_string(header.version) + ".");
+	}
+	if ((header.compression >= sizeof(wire_capabilities_type) * 8) ||
+	    !(local_wire_capabilities() & (wire_capabilities_type(1) << header.compression))) {
+		throw std::runtime_error(
+			"Wire frame uses compression " + std::to_string(header.compression) +
+			" not supported by this build.");
+	}
+
+	// block sizes are read one by one to not allocate for a corrupt number of blocks beyond the
+	// end of the stream
+	block_offsets.assign(1, 0);
+	for (uint64_t block = 0; block < header.num_blocks; ++block) {
+		uint64_t block_size;
+		reader(reinterpret_cast<uint8_t*>(&block_size), sizeof(block_size));
+		if (block_size > header.raw_size - block_offsets.back()) {
+			throw std::runtime_error("Block sizes of wire frame exceed its size.");
+		}
+		block_offsets.push_back(block_offsets.back() + block_size);
+	}
+	if (block_offsets.back() != header.raw_size) {
+		throw std::runtime_error("Block sizes of wire frame do not match its size.");
+	}
+
+	if ((header.compression == static_cast<uint8_t>(WireCompression::none)) &&
+	    (header.payload_size != header.raw_size)) {
+		throw std::runtime_error("Uncompressed wire frame payload does not match its size.");
+	}
+#ifdef USE_LZ4_COMPRESSION
+	if ((header.compression == static_cast<uint8_t>(WireCompression::lz4)) &&
+	    ((header.raw_size > static_cast<uint64_t>(LZ4_MAX_INPUT_SIZE)) ||
+	     (header.payload_size > static_cast<uint64_t>(LZ4_MAX_INPUT_SIZE)))) {
+		throw std::runtime_error("Compressed wire frame exceeds maximal size.");
+	}
+#endif
+	return header;
+}
+
+/// \brief reads payload of a frame after its prefix into output of size header.raw_size
+void read_payload(
+	wire_reader_type const& reader, WireFrameHeader const& header, uint8_t* const output)
+{
+	switch (static_cast<WireCompression>(header.compression)) {
+		case WireCompression::none: {
+			if (header.raw_size > 0) {
+				reader(output, header.raw_size);
+			}
+			return;
+		}
+#ifdef USE_LZ4_COMPRESSION
+		case WireCompression::lz4: {
+			auto& buffer = compression_buffer();
+			buffer.resize(header.payload_size);
+			reader(buffer.data(), header.payload_size);
+			int const size = LZ4_decompress_safe(
+				reinterpret_cast<char const*>(buffer.data()), reinterpret_cast<char*>(output),
+				static_cast<int>(header.payload_size), static_cast<int>(header.raw_size));
+			if ((size < 0) || (static_cast<uint64_t>(size) != header.raw_size)) {
+				throw std::runtime_error("Compressed wire frame payload is corrupt.");
+			}
+			return;
+		}
+#endif
+		default:
+			throw std::logic_error("Unsupported compression of validated wire frame.");
+	}
+}
+
+wire_writer_type memory_writer(std::vector<uint8_t>& frame)
+{
+	return [&frame](uint8_t const* const data, size_t const size) {
+		frame.insert(frame.end(), data, data + size);
+	};
+}
+
+wire_reader_type memory_reader(std::vector<uint8_t> const& frame, size_t& offset)
+{
+	return [&frame, &offset](uint8_t* const data, size_t const size) {
+		if (size > frame.size() - offset) {
+			throw std::runtime_error("Wire frame is truncated.");
+		}
+		std::memcpy(data, frame.data() + offset, size);
+		offset += size;
+	};
+}
+
+} // namespace
+
+wire_capabilities_type local_wire_capabilities()
+{
+	wire_capabilities_type capabilities = capability(WireCompression::none);
+#ifdef USE_LZ4_COMPRESSION
+	capabilities |= capability(WireCompression::lz4);
+#endif
+	return capabilities;
+}
+
+WireCompression negotiate_wire_compression(wire_capabilities_type const peer_capabilities)
+{
+	wire_capabilities_type const common = local_wire_capabilities() & peer_capabilities;
+	if (common & capability(WireCompression::lz4)) {
+		return WireCompression::lz4;
+	}
+	return WireCompression::none;
+}
+
+void write_wire_frame(
+	FlatProgramBytes const& program,
+	WireCompression const compression,
+	wire_writer_type const& writer)
+{
+	std::vector<uint64_t> block_sizes(program.num_blocks());
+	for (size_t block = 0; block < block_sizes.size(); ++block) {
+		block_sizes[block] = program.block_size(block);
+	}
+	write_frame(program.bytes.data(), block_sizes, program.bytes.size(), compression, writer);
+}
+
+void write_wire_frame(
+	std::vector<haldls::v2::instruction_word_type> const& bytes,
+	WireCompression const compression,
+	wire_writer_type const& writer)
+{
+	write_frame(bytes.data(), {bytes.size()}, bytes.size(), compression, writer);
+}
+
+void read_wire_frame(wire_reader_type const& reader, FlatProgramBytes& program)
+{
+	auto const header = read_frame_prefix(reader, program.block_offsets);
+	program.bytes.resize(header.raw_size);
+	read_payload(reader, header, program.bytes.data());
+}
+
+void read_wire_frame(
+	wire_reader_type const& reader, std::vector<haldls::v2::instruction_word_type>& bytes)
+{
+	std::vector<uint64_t> block_offsets;
+	auto const header = read_frame_prefix(reader, block_offsets);
+	bytes.resize(header.raw_size);
+	read_payload(reader, header, bytes.data());
+}
+
+std::vector<uint8_t> encode_wire_frame(
+	FlatProgramBytes const& program, WireCompression const compression)
+{
+	std::vector<uint8_t> frame;
+	write_wire_frame(program, compression, memory_writer(frame));
+	return frame;
+}
+
+std::vector<uint8_t> encode_wire_frame(
+	std::vector<haldls::v2::instruction_word_type> const& bytes,
+	WireCompression const compression)
+{
+	std::vector<uint8_t> frame;
+	write_wire_frame(bytes, compression, memory_writer(frame));
+	return frame;
+}
+
+void decode_wire_frame(std::vector<uint8_t> const& frame, FlatProgramBytes& program)
+{
+	size_t offset = 0;
+	read_wire_frame(memory_reader(frame, offset), program);
+	if (offset != frame.size()) {
+		throw std::runtime_error("Wire frame has trailing data.");
+	}
+}
+
+void decode_wire_frame(
+	std::vector<uint8_t> const& frame, std::vector<haldls::v2::instruction_word_type>& bytes)
+{
+	size_t offset = 0;
+	read_wire_frame(memory_reader(frame, offset), bytes);
+	if (offset != frame.size()) {
+		throw std::runtime_error("Wire frame has trailing data.");
+	}
+}
+
+} // namespace v2
+} // namespace stadls
@@ -0,0 +1,116 @@
+#include "stadls/vx/encode_cache.h"
+
+#include <atomic>
+#include <mutex>
+
+namespace stadls::vx {
+
+namespace {
+
+/**
+ * Global state shared by all typed cache storages.
+ */
+struct EncodeCacheState
+{
+	std::atomic<bool> enabled{false};
+	std::atomic<size_t> max_size{EncodeCache::default_max_size};
+	std::atomic<size_t> size{0};
+	std::atomic<size_t> hits{0};
+	std::atomic<size_t> misses{0};
+
+	/** Serializes changes of the generation with releases of entries. */
+	std::mutex generation_mutex;
+	std::atomic<size_t> generation{0};
+
+	static EncodeCacheState& get()
+	{
+		static EncodeCacheState state;
+		return state;
+	}
+};
+
+} // namespace
+
+void EncodeCache::set_enabled(bool const value)
+{
+	EncodeCacheState::get().enabled = value;
+}
+
+bool EncodeCache::get_enabled()
+{
+	return EncodeCacheState::get().enabled;
+}
+
+void EncodeCache::set_max_size(size_t const value)
+{
+	EncodeCacheState::get().max_size = value;
+}
+
+size_t EncodeCache::get_max_size()
+{
+	return EncodeCacheState::get().max_size;
+}
+
+typename EncodeCache::Statistics EncodeCache::get_statistics()
+{
+	auto const& state = EncodeCacheState::get();
+	Statistics statistics;
+	statistics.hits = state.hits;
+	statistics.misses = state.misses;
+	statistics.size = state.size;
+	return statistics;
+}
+
+void EncodeCache::reset_statistics()
+{
+	auto& state = EncodeCacheState::get();
+	state.hits = 0;
+	state.misses = 0;
+}
+
+void EncodeCache::clear()
+{
+	auto& state = EncodeCacheState::get();
+	std::lock_guard<std::mutex> lock(state.generation_mutex);
+	state.generation++;
+	state.size = 0;
+}
+
+size_t EncodeCache::get_generation()
+{
+	return EncodeCacheState::get().generation;
+}
+
+void EncodeCache::release_entries(size_t const num, size_t const generation)
+{
+	auto& state = EncodeCacheState::get();
+	std::lock_guard<std::mutex> lock(state.generation_mutex);
+	// entries of previous generations are not accounted anymore
+	if (generation == state.generation) {
+		state.size -= num;
+	}
+}
+
+bool EncodeCache::reserve_entry()
+{
+	auto& state = EncodeCacheState::get();
+	size_t size = state.size;
+	do {
+		if (size >= state.max_size) {
+			return false;
+		}
+	} while (!state.size.compare_exchange_weak(size, size + 1));
+	return true;
+}
+
+void EncodeCache::count_hit()
+{
+	EncodeCacheState::get().hits++;
+}
+
+void EncodeCache::count_miss()
+{
+	EncodeCacheState::get().misses++;
+}
+
+} // namespace stadls::vx
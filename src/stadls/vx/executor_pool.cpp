@@ -0,0 +1,338 @@
+#include "stadls/vx/executor_pool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <thread>
+#include "hxcomm/common/fpga_ip_list.h"
+#include "stadls/vx/playback_program.h"
+
+namespace stadls::vx {
+
+double ExecutorPool::Utilization::get_fraction() const
+{
+	if (total_time <= 0.) {
+		return 0.;
+	}
+	return std::min(busy_time / total_time, 1.);
+}
+
+struct ExecutorPool::Impl
+{
+	typedef std::chrono::steady_clock clock_type;
+
+	/**
+	 * Program enqueued for execution.
+	 */
+	struct Job
+	{
+		PlaybackProgram program;
+		std::promise<PlaybackProgram> promise;
+	};
+
+	/**
+	 * Executor of the pool together with its worker thread and statistics.
+	 */
+	struct Backend
+	{
+		Backend(PlaybackProgramExecutor&& executor, ExecutorBackend const type) :
+		    executor(std::move(executor)),
+		    type(type),
+		    thread(),
+		    programs(0),
+		    busy_time(clock_type::duration::zero()),
+		    added(clock_type::now())
+		{}
+
+		PlaybackProgramExecutor executor;
+		ExecutorBackend type;
+		std::thread thread;
+		size_t programs;
+		clock_type::duration busy_time;
+		clock_type::time_point added;
+	};
+
+	Impl() :
+	    m_backends(),
+	    m_jobs(),
+	    m_programs_in_flight(),
+	    m_mutex(),
+	    m_changed(),
+	    m_jobs_in_flight(0),
+	    m_stop(false)
+	{}
+
+	~Impl() { stop(); }
+
+	static bool is_compatible(PlaybackProgram const& program, Backend const& backend)
+	{
+		auto const restriction = program.get_executable_restriction();
+		// the mock backend is able to execute all programs
+		return !restriction || (backend.type == ExecutorBackend::mock) ||
+		       (*restriction == backend.type);
+	}
+
+	/**
+	 * Get whether the implementation of the job's program is currently executed by another
+	 * backend.
+	 * Copies of a program share the implementation and result data, their executions are
+	 * therefore serialized.
+	 */
+	bool is_in_flight(Job const& job) const
+	{
+		return m_programs_in_flight.count(job.program.m_program_impl.get()) != 0;
+	}
+
+	/**
+	 * Execute compatible jobs on given backend until stop is requested and no compatible job is
+	 * left in the queue.
+	 * Jobs sharing their program implementation with a job in execution are skipped until the
+	 * latter is finished.
+	 * @param backend Backend to execute jobs on
+	 */
+	void work(Backend& backend)
+	{
+		while (true) {
+			std::optional<Job> job;
+			{
+				std::unique_lock<std::mutex> lock(m_mutex);
+				auto it = m_jobs.end();
+				auto const compatible = [&backend](Job const& candidate) {
+					return is_compatible(candidate.program, backend);
+				};
+				auto const startable = [&](Job const& candidate) {
+					return compatible(candidate) && !is_in_flight(candidate);
+				};
+				m_changed.wait(lock, [&]() {
+					it = std::find_if(m_jobs.begin(), m_jobs.end(), startable);
+					return (it != m_jobs.end()) ||
+					       (m_stop && std::none_of(m_jobs.begin(), m_jobs.end(), compatible));
+				});
+				if (it == m_jobs.end()) {
+					return;
+				}
+				job.emplace(std::move(*it));
+				m_jobs.erase(it);
+				m_programs_in_flight.insert(job->program.m_program_impl.get());
+			}
+			// program is moved into the promise on success
+			auto const program_impl = job->program.m_program_impl.get();
+
+			auto const begin = clock_type::now();
+			try {
+				backend.executor.run(job->program);
+				job->promise.set_value(std::move(job->program));
+			} catch (...) {
+				job->promise.set_exception(std::current_exception());
+			}
+			auto const end = clock_type::now();
+
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				backend.programs++;
+				backend.busy_time += end - begin;
+				m_programs_in_flight.erase(program_impl);
+				m_jobs_in_flight--;
+			}
+			m_changed.notify_all();
+		}
+	}
+
+	void add(PlaybackProgramExecutor&& executor)
+	{
+		auto const type = executor.get_backend();
+		if (!type) {
+			throw std::runtime_error("Trying to add executor without connection to a backend.");
+		}
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_backends.push_back(std::make_unique<Backend>(std::move(executor), *type));
+		auto& backend = *(m_backends.back());
+		backend.thread = std::thread(&Impl::work, this, std::ref(backend));
+	}
+
+	/**
+	 * Execute all enqueued jobs, stop worker threads and disconnect from all backends.
+	 */
+	void stop()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_stop = true;
+		}
+		m_changed.notify_all();
+		for (auto& backend : m_backends) {
+			if (backend->thread.joinable()) {
+				backend->thread.join();
+			}
+		}
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_backends.clear();
+		m_stop = false;
+	}
+
+	std::vector<std::unique_ptr<Backend>> m_backends;
+	std::deque<Job> m_jobs;
+	/** Implementations of programs currently executed by a backend. */
+	std::set<fisch::vx::PlaybackProgram const*> m_programs_in_flight;
+	mutable std::mutex m_mutex;
+	std::condition_variable m_changed;
+	size_t m_jobs_in_flight;
+	bool m_stop;
+};
+
+ExecutorPool::ExecutorPool() : m_impl(std::make_unique<Impl>()) {}
+
+ExecutorPool::ExecutorPool(ExecutorPool&& other) : m_impl(std::move(other.m_impl)) {}
+
+ExecutorPool::~ExecutorPool() = default;
+
+void ExecutorPool::connect_hardware(ip_t const ip)
+{
+	if (!m_impl) {
+		throw std::logic_error("Unexpected access to moved-from object.");
+	}
+
+	PlaybackProgramExecutor executor;
+	executor.connect_hardware(ip);
+	m_impl->add(std::move(executor));
+}
+
+void ExecutorPool::connect_simulator(ip_t const ip, port_t const port)
+{
+	if (!m_impl) {
+		throw std::logic_error("Unexpected access to moved-from object.");
+	}
+
+	PlaybackProgramExecutor executor;
+	executor.connect_simulator(ip, port);
+	m_impl->add(std::move(executor));
+}
+
+void ExecutorPool::connect_mock()
+{
+	if (!m_impl) {
+		throw std::logic_error("Unexpected access to moved-from object.");
+	}
+
+	PlaybackProgramExecutor executor;
+	executor.connect_mock();
+	m_impl->add(std::move(executor));
+}
+
+void ExecutorPool::connect()
+{
+	if (!m_impl) {
+		throw std::logic_error("Unexpected access to moved-from object.");
+	}
+
+	auto const fpga_ip_list = hxcomm::get_fpga_ip_list();
+	if (fpga_ip_list.empty()) {
+		PlaybackProgramExecutor executor;
+		executor.connect_simulator();
+		m_impl->add(std::move(executor));
+		return;
+	}
+	for (auto const& ip : fpga_ip_list) {
+		connect_hardware(ip);
+	}
+}
+
+void ExecutorPool::add(PlaybackProgramExecutor&& executor)
+{
+	if (!m_impl) {
+		throw std::logic_error("Unexpected access to moved-from object.");
+	}
+
+	m_impl->add(std::move(executor));
+}
+
+void ExecutorPool::disconnect()
+{
+	if (!m_impl) {
+		throw std::logic_error("Unexpected access to moved-from object.");
+	}
+
+	m_impl->stop();
+}
+
+size_t ExecutorPool::size() const
+{
+	if (!m_impl) {
+		throw std::logic_error("Unexpected access to moved-from object.");
+	}
+
+	std::lock_guard<std::mutex> lock(m_impl->m_mutex);
+	return m_impl->m_backends.size();
+}
+
+std::future<PlaybackProgram> ExecutorPool::run_async(PlaybackProgram const& program)
+{
+	if (!m_impl) {
+		throw std::logic_error("Unexpected access to moved-from object.");
+	}
+
+	std::future<PlaybackProgram> future;
+	{
+		std::lock_guard<std::mutex> lock(m_impl->m_mutex);
+		auto const compatible = [&program](auto const& backend) {
+			return Impl::is_compatible(program, *backend);
+		};
+		if (std::none_of(m_impl->m_backends.begin(), m_impl->m_backends.end(), compatible)) {
+			throw std::runtime_error(
+			    "Trying to execute program without backend in pool matching its executable "
+			    "restriction.");
+		}
+		m_impl->m_jobs.push_back(Impl::Job{program, {}});
+		future = m_impl->m_jobs.back().promise.get_future();
+		m_impl->m_jobs_in_flight++;
+	}
+	m_impl->m_changed.notify_all();
+	return future;
+}
+
+void ExecutorPool::run(std::vector<PlaybackProgram> const& programs)
+{
+	std::vector<std::future<PlaybackProgram>> futures;
+	futures.reserve(programs.size());
+	for (auto const& program : programs) {
+		futures.push_back(run_async(program));
+	}
+	for (auto& future : futures) {
+		future.get();
+	}
+}
+
+void ExecutorPool::wait_all()
+{
+	if (!m_impl) {
+		throw std::logic_error("Unexpected access to moved-from object.");
+	}
+
+	std::unique_lock<std::mutex> lock(m_impl->m_mutex);
+	m_impl->m_changed.wait(lock, [this]() { return m_impl->m_jobs_in_flight == 0; });
+}
+
+std::vector<ExecutorPool::Utilization> ExecutorPool::get_utilization() const
+{
+	if (!m_impl) {
+		throw std::logic_error("Unexpected access to moved-from object.");
+	}
+
+	auto const now = Impl::clock_type::now();
+	std::vector<Utilization> utilization;
+	std::lock_guard<std::mutex> lock(m_impl->m_mutex);
+	for (auto const& backend : m_impl->m_backends) {
+		std::chrono::duration<double> const busy_time = backend->busy_time;
+		std::chrono::duration<double> const total_time = now - backend->added;
+		utilization.push_back(
+		    Utilization{backend->type, backend->programs, busy_time.count(), total_time.count()});
+	}
+	return utilization;
+}
+
+} // namespace stadls::vx
@@ -0,0 +1,56 @@
+#include "stadls/vx/file_mapping.h"
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace stadls::vx::detail {
+
+FileMapping::FileMapping(std::string const& filename) : m_data(nullptr), m_size(0)
+{
+	int const fd = ::open(filename.c_str(), O_RDONLY);
+	if (fd < 0) {
+		throw std::runtime_error(
+		    "Failed to open " + filename + ": " + std::string(std::strerror(errno)));
+	}
+	struct stat info;
+	if (::fstat(fd, &info) != 0) {
+		::close(fd);
+		throw std::runtime_error(
+		    "Failed to stat " + filename + ": " + std::string(std::strerror(errno)));
+	}
+	m_size = static_cast<size_t>(info.st_size);
+	if (m_size > 0) {
+		void* const data = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (data == MAP_FAILED) {
+			::close(fd);
+			throw std::runtime_error(
+			    "Failed to map " + filename + ": " + std::string(std::strerror(errno)));
+		}
+		m_data = static_cast<char const*>(data);
+	}
+	::close(fd);
+}
+
+FileMapping::~FileMapping()
+{
+	if (m_data) {
+		::munmap(const_cast<char*>(m_data), m_size);
+	}
+}
+
+char const* FileMapping::data() const
+{
+	return m_data;
+}
+
+size_t FileMapping::size() const
+{
+	return m_size;
+}
+
+} // namespace stadls::vx::detail
@@ -0,0 +1,175 @@
+#include "stadls/vx/merge_spikes.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include "stadls/vx/playback_program.h"
+
+namespace stadls::vx {
+
+namespace {
+
+typedef uint64_t time_type;
+
+/**
+ * Part of a spike sequence together with the time offset of the sequence.
+ */
+struct Slice
+{
+	SpikeView::const_iterator begin;
+	SpikeView::const_iterator end;
+	time_type offset;
+};
+
+time_type shifted_time(haldls::vx::SpikeFromChip const& spike, time_type const offset)
+{
+	return spike.get_fpga_time().value() + offset;
+}
+
+/**
+ * Merge slices into output columns starting at given position.
+ * @param slices Slices to merge, ties are broken by slice index
+ * @param columns Output columns of sufficient size
+ * @param position Index of first output element
+ */
+void merge_slices(std::vector<Slice> slices, SpikeColumns::Storage& columns, size_t position)
+{
+	typedef std::pair<time_type, size_t> entry_type;
+	std::priority_queue<entry_type, std::vector<entry_type>, std::greater<entry_type>> heap;
+	for (size_t i = 0; i < slices.size(); ++i) {
+		if (slices[i].begin != slices[i].end) {
+			heap.emplace(shifted_time(*slices[i].begin, slices[i].offset), i);
+		}
+	}
+
+	while (!heap.empty()) {
+		auto const [time, index] = heap.top();
+		heap.pop();
+		auto& slice = slices[index];
+		columns.labels[position] = slice.begin->get_label().value();
+		columns.fpga_times[position] = time;
+		columns.chip_times[position] = slice.begin->get_chip_time().value();
+		++position;
+		++slice.begin;
+		if (slice.begin != slice.end) {
+			heap.emplace(shifted_time(*slice.begin, slice.offset), index);
+		}
+	}
+}
+
+} // namespace
+
+SpikeColumns merge_spikes(
+    std::vector<SpikeView> const& spikes,
+    std::vector<haldls::vx::FPGATime> const& time_offsets,
+    size_t thread_count)
+{
+	if (!time_offsets.empty() && (time_offsets.size() != spikes.size())) {
+		throw std::invalid_argument("Number of time offsets does not match number of sequences.");
+	}
+
+	auto const earlier = [](haldls::vx::SpikeFromChip const& a,
+	                        haldls::vx::SpikeFromChip const& b) {
+		return a.get_fpga_time() < b.get_fpga_time();
+	};
+
+	std::vector<Slice> slices;
+	slices.reserve(spikes.size());
+	size_t total_size = 0;
+	size_t largest = 0;
+	for (size_t i = 0; i < spikes.size(); ++i) {
+		if (!std::is_sorted(spikes[i].begin(), spikes[i].end(), earlier)) {
+			throw std::invalid_argument(
+			    "Spike sequence " + std::to_string(i) + " is not sorted by FPGA time.");
+		}
+		time_type const offset = time_offsets.empty() ? 0 : time_offsets[i].value();
+		slices.push_back(Slice{spikes[i].begin(), spikes[i].end(), offset});
+		total_size += spikes[i].size();
+		if (spikes[i].size() > spikes[largest].size()) {
+			largest = i;
+		}
+	}
+
+	auto columns = std::make_shared<SpikeColumns::Storage>();
+	columns->labels.resize(total_size);
+	columns->fpga_times.resize(total_size);
+	columns->chip_times.resize(total_size);
+
+	if (thread_count == 0) {
+		thread_count = (total_size >= merge_spikes_parallel_threshold)
+		                   ? std::max(std::thread::hardware_concurrency(), 1u)
+		                   : 1;
+	}
+
+	if ((thread_count == 1) || (total_size == 0)) {
+		merge_slices(slices, *columns, 0);
+		return SpikeColumns(columns);
+	}
+
+	// partition time range at quantiles of the largest sequence, spikes at a pivot time belong to
+	// the later partition in all sequences, which keeps the order of equal times
+	std::vector<time_type> pivots;
+	auto const& reference = slices[largest];
+	size_t const reference_size = std::distance(reference.begin, reference.end);
+	for (size_t p = 1; p < thread_count; ++p) {
+		auto const quantile = reference.begin + (p * reference_size / thread_count);
+		pivots.push_back(shifted_time(*quantile, reference.offset));
+	}
+	pivots.erase(std::unique(pivots.begin(), pivots.end()), pivots.end());
+
+	auto const before = [](haldls::vx::SpikeFromChip const& spike, time_type const time) {
+		return spike.get_fpga_time().value() < time;
+	};
+	std::vector<std::vector<Slice>> partitions(pivots.size() + 1, slices);
+	for (size_t i = 0; i < slices.size(); ++i) {
+		auto const& slice = slices[i];
+		auto begin = slice.begin;
+		for (size_t p = 0; p < pivots.size(); ++p) {
+			auto const end = (pivots[p] < slice.offset)
+			                     ? begin
+			                     : std::lower_bound(
+			                           begin, slice.end, pivots[p] - slice.offset, before);
+			partitions[p][i].begin = begin;
+			partitions[p][i].end = end;
+			begin = end;
+		}
+		partitions.back()[i].begin = begin;
+	}
+
+	std::vector<std::thread> threads;
+	size_t position = 0;
+	for (auto const& partition : partitions) {
+		threads.emplace_back(merge_slices, partition, std::ref(*columns), position);
+		for (auto const& slice : partition) {
+			position += std::distance(slice.begin, slice.end);
+		}
+	}
+	for (auto& thread : threads) {
+		thread.join();
+	}
+	return SpikeColumns(columns);
+}
+
+SpikeColumns merge_spikes(
+    std::vector<PlaybackProgram const*> const& programs,
+    std::vector<haldls::vx::FPGATime> const& time_offsets,
+    size_t const thread_count)
+{
+	std::vector<SpikeView> spikes;
+	spikes.reserve(programs.size());
+	for (auto const program : programs) {
+		if (!program) {
+			throw std::invalid_argument("Trying to merge spikes of nullptr program.");
+		}
+		spikes.push_back(program->get_spikes());
+	}
+	return merge_spikes(spikes, time_offsets, thread_count);
+}
+
+} // namespace stadls::vx
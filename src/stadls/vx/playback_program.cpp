@@ -1,25 +1,174 @@
 #include "stadls/vx/playback_program.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <istream>
+#include <streambuf>
+#include <thread>
+#include <cereal/types/common.hpp>
+#include "fisch/vx/fill.h"
 #include "fisch/vx/playback_program.h"
+#include "haldls/cerealization.h"
 #include "haldls/vx/common.h"
 #include "haldls/vx/container.h"
+#include "hate/type_traits.h"
 #include "lola/vx/container.h"
 #include "stadls/visitors.h"
+#include "stadls/vx/file_mapping.h"
 
 namespace stadls::vx {
 
 PlaybackProgram::PlaybackProgram() :
-    m_program_impl(std::make_shared<fisch::vx::PlaybackProgram>()), m_executable_restriction()
+    m_program_impl(std::make_shared<fisch::vx::PlaybackProgram>()),
+    m_executable_restriction(),
+    m_deferred_decodes(std::make_shared<deferred_decodes_type>()),
+    m_mock_state(std::make_shared<MockState>()),
+    m_result_cache(std::make_shared<ResultCache>()),
+    m_spike_histogram()
 {}
 
 PlaybackProgram::PlaybackProgram(
     std::shared_ptr<fisch::vx::PlaybackProgram> const& program_impl,
-    std::optional<ExecutorBackend> const executable_restriction) :
-    m_program_impl(program_impl), m_executable_restriction(executable_restriction)
+    std::optional<ExecutorBackend> const executable_restriction,
+    std::shared_ptr<deferred_decodes_type> const& deferred_decodes,
+    std::shared_ptr<MockState> const& mock_state) :
+    m_program_impl(program_impl),
+    m_executable_restriction(executable_restriction),
+    m_deferred_decodes(deferred_decodes),
+    m_mock_state(mock_state),
+    m_result_cache(std::make_shared<ResultCache>()),
+    m_spike_histogram()
 {}
 
+namespace {
+
+/**
+ * Construct container suitable for decoding data at given location.
+ * @tparam T Container type
+ * @param coord Coordinate of container
+ * @return Container
+ */
+template <typename T>
+T make_decodable(typename T::coordinate_type const& coord)
+{
+	T config;
+	if constexpr (std::is_same<T, haldls::vx::PPUMemoryBlock>::value) {
+		// FIXME (Issue #3327): PPUMemoryBlock needs special size on construction
+		config = haldls::vx::PPUMemoryBlock(coord.toPPUMemoryBlockSize());
+	}
+	return config;
+}
+
+/**
+ * Non-owning view of a contiguous range of read words, which allows decoding a container from
+ * the results without copying its words.
+ * @tparam Data Word sequence type with contiguous storage
+ */
+template <typename Data>
+class DecodeRange
+{
+public:
+	typedef typename Data::value_type value_type;
+	typedef value_type const* const_iterator;
+
+	DecodeRange(Data const& data, size_t const begin, size_t const end) :
+	    m_begin(data.data() + begin), m_end(data.data() + end)
+	{}
+
+	const_iterator cbegin() const
+	{
+		return m_begin;
+	}
+
+	const_iterator cend() const
+	{
+		return m_end;
+	}
+
+private:
+	const_iterator m_begin;
+	const_iterator m_end;
+};
+
+/**
+ * Get number of words read for container at given location.
+ * @tparam T Container type
+ * @tparam Data Word sequence type
+ * @param coord Coordinate of container
+ * @return Number of words
+ */
+template <typename T, typename Data>
+size_t count_read_words(typename T::coordinate_type const& coord)
+{
+	typedef std::vector<typename Data::value_type::coordinate_type> addresses_type;
+	addresses_type addresses;
+	auto config = make_decodable<T>(coord);
+	haldls::vx::visit_preorder(
+	    config, coord, stadls::ReadAddressVisitor<addresses_type>{addresses});
+	return addresses.size();
+}
+
+/**
+ * Generate pseudo-random words.
+ * @tparam Data Word sequence type
+ * @param size Number of words
+ * @param gen RNG
+ * @return Words
+ */
+template <typename Data>
+Data generate_mock_data(size_t const size, std::mt19937& gen)
+{
+	Data data(size);
+	for (auto& word : data) {
+		word = fisch::vx::fill_random<typename Data::value_type>(gen);
+	}
+	return data;
+}
+
+} // namespace
+
 template <typename T>
 T PlaybackProgram::ContainerTicket<T>::get() const
+{
+	{
+		std::lock_guard<std::mutex> lock(m_cache->mutex);
+		if (m_cache->value) {
+			return *(m_cache->value);
+		}
+	}
+	return decode();
+}
+
+template <typename T>
+void PlaybackProgram::ContainerTicket<T>::decode_into_cache() const
+{
+	{
+		std::lock_guard<std::mutex> lock(m_cache->mutex);
+		if (m_cache->value) {
+			return;
+		}
+	}
+	if (!valid()) {
+		return;
+	}
+	auto config = decode();
+	std::lock_guard<std::mutex> lock(m_cache->mutex);
+	m_cache->value = std::move(config);
+}
+
+template <typename T>
+void PlaybackProgram::ContainerTicket<T>::reset_cache() const
+{
+	std::lock_guard<std::mutex> lock(m_cache->mutex);
+	m_cache->value.reset();
+	m_cache->fpga_time.reset();
+}
+
+template <typename T>
+T PlaybackProgram::ContainerTicket<T>::decode() const
 {
 	return boost::apply_visitor(
 	    [this](auto&& ticket_impl) -> T {
@@ -27,24 +176,51 @@ T PlaybackProgram::ContainerTicket<T>::get() const
 			    throw std::runtime_error(
 			        "container data not available yet (out of bounds of available results data)");
 
-		    auto data = ticket_impl.get();
-		    T config;
+		    return decode(ticket_impl.get());
+	    },
+	    m_ticket_impl);
+}
 
-		    if constexpr (std::is_same<T, haldls::vx::PPUMemoryBlock>::value) {
-			    // FIXME (Issue #3327): PPUMemoryBlock needs special size on construction
-			    config = haldls::vx::PPUMemoryBlock(m_coord.toPPUMemoryBlockSize());
-		    }
+template <typename T>
+template <typename Data>
+T PlaybackProgram::ContainerTicket<T>::decode(Data const& data) const
+{
+	auto config = make_decodable<T>(m_coord);
+	haldls::vx::visit_preorder(
+	    config, m_coord,
+	    stadls::DecodeVisitor<DecodeRange<Data>>{DecodeRange<Data>(data, 0, data.size())});
+	return config;
+}
 
-		    haldls::vx::visit_preorder(
-		        config, m_coord, stadls::DecodeVisitor<decltype(data)>{std::move(data)});
-		    return config;
+template <typename T>
+void PlaybackProgram::ContainerTicket<T>::mock_into_cache(
+    std::mt19937& gen, fpga_time_type const& fpga_time) const
+{
+	auto config = boost::apply_visitor(
+	    [this, &gen](auto&& ticket_impl) -> T {
+		    typedef hate::remove_all_qualifiers_t<decltype(ticket_impl.get())> data_type;
+		    size_t const size = count_read_words<T, data_type>(m_coord);
+		    try {
+			    return decode(generate_mock_data<data_type>(size, gen));
+		    } catch (std::exception const&) {
+			    return decode(data_type(size));
+		    }
 	    },
 	    m_ticket_impl);
+	std::lock_guard<std::mutex> lock(m_cache->mutex);
+	m_cache->value = std::move(config);
+	m_cache->fpga_time = fpga_time;
 }
 
 template <typename T>
 bool PlaybackProgram::ContainerTicket<T>::valid() const
 {
+	{
+		std::lock_guard<std::mutex> lock(m_cache->mutex);
+		if (m_cache->value) {
+			return true;
+		}
+	}
 	return boost::apply_visitor(
 	    [this](auto&& ticket_impl) -> bool { return ticket_impl.valid(); }, m_ticket_impl);
 }
@@ -58,29 +234,244 @@ typename T::coordinate_type PlaybackProgram::ContainerTicket<T>::get_coordinate(
 template <typename T>
 typename PlaybackProgram::fpga_time_type PlaybackProgram::ContainerTicket<T>::get_fpga_time() const
 {
+	{
+		std::lock_guard<std::mutex> lock(m_cache->mutex);
+		if (m_cache->fpga_time) {
+			return *(m_cache->fpga_time);
+		}
+	}
 	return boost::apply_visitor(
 	    [this](auto&& ticket_impl) -> fpga_time_type { return ticket_impl.fpga_time(); },
 	    m_ticket_impl);
 }
 
+template <typename T>
+std::vector<T> PlaybackProgram::ContainerBatchTicket<T>::get() const
+{
+	{
+		std::lock_guard<std::mutex> lock(m_cache->mutex);
+		if (m_cache->value) {
+			return *(m_cache->value);
+		}
+	}
+	return decode();
+}
+
+template <typename T>
+void PlaybackProgram::ContainerBatchTicket<T>::decode_into_cache() const
+{
+	{
+		std::lock_guard<std::mutex> lock(m_cache->mutex);
+		if (m_cache->value) {
+			return;
+		}
+	}
+	if (!valid()) {
+		return;
+	}
+	auto configs = decode();
+	std::lock_guard<std::mutex> lock(m_cache->mutex);
+	m_cache->value = std::move(configs);
+}
+
+template <typename T>
+void PlaybackProgram::ContainerBatchTicket<T>::reset_cache() const
+{
+	std::lock_guard<std::mutex> lock(m_cache->mutex);
+	m_cache->value.reset();
+	m_cache->fpga_time.reset();
+}
+
+template <typename T>
+std::vector<T> PlaybackProgram::ContainerBatchTicket<T>::decode() const
+{
+	return boost::apply_visitor(
+	    [this](auto&& ticket_impl) -> std::vector<T> {
+		    if (!ticket_impl.valid())
+			    throw std::runtime_error(
+			        "container data not available yet (out of bounds of available results data)");
+
+		    return decode(ticket_impl.get());
+	    },
+	    *m_ticket_impl);
+}
+
+template <typename T>
+template <typename Data>
+std::vector<T> PlaybackProgram::ContainerBatchTicket<T>::decode(Data const& data) const
+{
+	if (data.size() != m_word_offsets.back()) {
+		throw std::logic_error("number of read words does not match batch size");
+	}
+
+	std::vector<T> configs;
+	configs.reserve(m_coords.size());
+	for (size_t i = 0; i < m_coords.size(); ++i) {
+		auto const& coord = m_coords[i];
+		auto config = make_decodable<T>(coord);
+		haldls::vx::visit_preorder(
+		    config, coord,
+		    stadls::DecodeVisitor<DecodeRange<Data>>{
+		        DecodeRange<Data>(data, m_word_offsets[i], m_word_offsets[i + 1])});
+		configs.push_back(std::move(config));
+	}
+	return configs;
+}
+
+template <typename T>
+void PlaybackProgram::ContainerBatchTicket<T>::mock_into_cache(
+    std::mt19937& gen, fpga_time_type const& fpga_time) const
+{
+	auto configs = boost::apply_visitor(
+	    [this, &gen](auto&& ticket_impl) -> std::vector<T> {
+		    typedef hate::remove_all_qualifiers_t<decltype(ticket_impl.get())> data_type;
+		    size_t const size = m_word_offsets.back();
+		    try {
+			    return decode(generate_mock_data<data_type>(size, gen));
+		    } catch (std::exception const&) {
+			    return decode(data_type(size));
+		    }
+	    },
+	    *m_ticket_impl);
+	std::lock_guard<std::mutex> lock(m_cache->mutex);
+	m_cache->value = std::move(configs);
+	m_cache->fpga_time = fpga_time;
+}
+
+template <typename T>
+bool PlaybackProgram::ContainerBatchTicket<T>::valid() const
+{
+	{
+		std::lock_guard<std::mutex> lock(m_cache->mutex);
+		if (m_cache->value) {
+			return true;
+		}
+	}
+	return boost::apply_visitor(
+	    [](auto&& ticket_impl) -> bool { return ticket_impl.valid(); }, *m_ticket_impl);
+}
+
+template <typename T>
+typename PlaybackProgram::ContainerBatchTicket<T>::coordinates_type
+PlaybackProgram::ContainerBatchTicket<T>::get_coordinates() const
+{
+	return m_coords;
+}
+
+template <typename T>
+typename PlaybackProgram::fpga_time_type PlaybackProgram::ContainerBatchTicket<T>::get_fpga_time()
+    const
+{
+	{
+		std::lock_guard<std::mutex> lock(m_cache->mutex);
+		if (m_cache->fpga_time) {
+			return *(m_cache->fpga_time);
+		}
+	}
+	return boost::apply_visitor(
+	    [](auto&& ticket_impl) -> fpga_time_type { return ticket_impl.fpga_time(); },
+	    *m_ticket_impl);
+}
+
+template <typename T>
+size_t PlaybackProgram::ContainerBatchTicket<T>::size() const
+{
+	return m_coords.size();
+}
+
+#define PLAYBACK_CONTAINER(_Name, Type)                                                            \
+	template SYMBOL_VISIBLE std::vector<Type> PlaybackProgram::ContainerBatchTicket<Type>::get()   \
+	    const;                                                                                     \
+	template SYMBOL_VISIBLE bool PlaybackProgram::ContainerBatchTicket<Type>::valid() const;       \
+	template SYMBOL_VISIBLE typename PlaybackProgram::ContainerBatchTicket<Type>::coordinates_type \
+	PlaybackProgram::ContainerBatchTicket<Type>::get_coordinates() const;                          \
+	template SYMBOL_VISIBLE typename PlaybackProgram::fpga_time_type                               \
+	PlaybackProgram::ContainerBatchTicket<Type>::get_fpga_time() const;                            \
+	template SYMBOL_VISIBLE size_t PlaybackProgram::ContainerBatchTicket<Type>::size() const;      \
+	template void PlaybackProgram::ContainerBatchTicket<Type>::decode_into_cache() const;          \
+	template void PlaybackProgram::ContainerBatchTicket<Type>::reset_cache() const;                \
+	template void PlaybackProgram::ContainerBatchTicket<Type>::mock_into_cache(                    \
+	    std::mt19937&, PlaybackProgram::fpga_time_type const&) const;
+#pragma push_macro("PLAYBACK_CONTAINER")
+#include "haldls/vx/container.def"
+#pragma pop_macro("PLAYBACK_CONTAINER")
+#include "lola/vx/container.def"
+
 #define PLAYBACK_CONTAINER(_Name, Type)                                                            \
 	template SYMBOL_VISIBLE Type PlaybackProgram::ContainerTicket<Type>::get() const;              \
 	template SYMBOL_VISIBLE bool PlaybackProgram::ContainerTicket<Type>::valid() const;            \
 	template SYMBOL_VISIBLE typename Type::coordinate_type                                         \
 	PlaybackProgram::ContainerTicket<Type>::get_coordinate() const;                                \
 	template SYMBOL_VISIBLE typename PlaybackProgram::fpga_time_type                               \
-	PlaybackProgram::ContainerTicket<Type>::get_fpga_time() const;
+	PlaybackProgram::ContainerTicket<Type>::get_fpga_time() const;                                 \
+	template void PlaybackProgram::ContainerTicket<Type>::decode_into_cache() const;               \
+	template void PlaybackProgram::ContainerTicket<Type>::reset_cache() const;                     \
+	template void PlaybackProgram::ContainerTicket<Type>::mock_into_cache(                         \
+	    std::mt19937&, PlaybackProgram::fpga_time_type const&) const;
 #pragma push_macro("PLAYBACK_CONTAINER")
 #include "haldls/vx/container.def"
 #pragma pop_macro("PLAYBACK_CONTAINER")
 #include "lola/vx/container.def"
 
-typename PlaybackProgram::spikes_type PlaybackProgram::get_spikes() const
+SpikeView PlaybackProgram::get_spikes() const
+{
+	if (m_mock_state->active) {
+		// share ownership of the mock state instead of copying its spikes
+		return SpikeView(std::shared_ptr<spikes_type const>(m_mock_state, &(m_mock_state->spikes)));
+	}
+	std::lock_guard<std::mutex> lock(m_result_cache->mutex);
+	if (!m_result_cache->spikes) {
+		auto const& spikes_impl = m_program_impl->get_spikes();
+		m_result_cache->spikes =
+		    std::make_shared<spikes_type const>(spikes_impl.begin(), spikes_impl.end());
+	}
+	return SpikeView(m_result_cache->spikes);
+}
+
+SpikeColumns PlaybackProgram::get_spike_columns() const
+{
+	std::lock_guard<std::mutex> lock(m_result_cache->mutex);
+	if (!m_result_cache->spike_columns) {
+		auto columns = std::make_shared<SpikeColumns::Storage>();
+		// convert spikes one by one without constructing the spike vector
+		auto const fill = [&columns](auto const& spikes) {
+			columns->labels.reserve(spikes.size());
+			columns->fpga_times.reserve(spikes.size());
+			columns->chip_times.reserve(spikes.size());
+			for (auto const& spike_impl : spikes) {
+				haldls::vx::SpikeFromChip const spike(spike_impl);
+				columns->labels.push_back(spike.get_label().value());
+				columns->fpga_times.push_back(spike.get_fpga_time().value());
+				columns->chip_times.push_back(spike.get_chip_time().value());
+			}
+		};
+		if (m_mock_state->active) {
+			fill(m_mock_state->spikes);
+		} else {
+			fill(m_program_impl->get_spikes());
+		}
+		m_result_cache->spike_columns = columns;
+	}
+	return SpikeColumns(m_result_cache->spike_columns);
+}
+
+MADCSampleColumns PlaybackProgram::get_madc_sample_columns() const
 {
-	spikes_type spikes;
-	auto const& spikes_impl = m_program_impl->get_spikes();
-	std::copy(spikes_impl.begin(), spikes_impl.end(), std::back_inserter(spikes));
-	return spikes;
+	std::lock_guard<std::mutex> lock(m_result_cache->mutex);
+	if (!m_result_cache->madc_sample_columns) {
+		auto const& samples = m_program_impl->get_madc_samples();
+		auto columns = std::make_shared<MADCSampleColumns::Storage>();
+		columns->values.reserve(samples.size());
+		columns->fpga_times.reserve(samples.size());
+		columns->chip_times.reserve(samples.size());
+		for (auto const& sample : samples) {
+			columns->values.push_back(sample.get_sample().get_value().value());
+			columns->fpga_times.push_back(sample.get_fpga_time().value());
+			columns->chip_times.push_back(sample.get_sample().get_chip_time().value());
+		}
+		m_result_cache->madc_sample_columns = columns;
+	}
+	return MADCSampleColumns(m_result_cache->madc_sample_columns);
 }
 
 typename PlaybackProgram::madc_samples_type const& PlaybackProgram::get_madc_samples() const
@@ -100,11 +491,109 @@ PlaybackProgram::get_madc_samples_pack_counts() const
 	return m_program_impl->get_madc_samples_pack_counts();
 }
 
+void PlaybackProgram::set_spike_histogram(std::shared_ptr<SpikeHistogram> const& histogram)
+{
+	m_spike_histogram = histogram;
+}
+
+std::shared_ptr<SpikeHistogram> PlaybackProgram::get_spike_histogram() const
+{
+	return m_spike_histogram;
+}
+
 std::optional<ExecutorBackend> PlaybackProgram::get_executable_restriction() const
 {
 	return m_executable_restriction;
 }
 
+void PlaybackProgram::decode_all(size_t thread_count)
+{
+	auto const& deferred_decodes = *m_deferred_decodes;
+	if (thread_count == 0) {
+		thread_count = std::max(std::thread::hardware_concurrency(), 1u);
+	}
+	thread_count = std::min(thread_count, deferred_decodes.size());
+
+	// threads dynamically fetch the next undecoded ticket, which balances differently expensive
+	// decodes, e.g. of SynapseMatrix and CapMemCell, across the threads
+	std::atomic<size_t> next(0);
+	std::mutex exception_mutex;
+	std::exception_ptr exception;
+	auto const work = [&]() {
+		for (size_t i = next++; i < deferred_decodes.size(); i = next++) {
+			try {
+				deferred_decodes[i].decode();
+			} catch (...) {
+				std::lock_guard<std::mutex> lock(exception_mutex);
+				if (!exception) {
+					exception = std::current_exception();
+				}
+			}
+		}
+	};
+
+	std::vector<std::thread> threads;
+	if (thread_count > 1) {
+		threads.reserve(thread_count - 1);
+		for (size_t i = 0; i < thread_count - 1; ++i) {
+			threads.emplace_back(work);
+		}
+	}
+	work();
+	for (auto& thread : threads) {
+		thread.join();
+	}
+
+	if (exception) {
+		std::rethrow_exception(exception);
+	}
+}
+
+void PlaybackProgram::reset_decoded()
+{
+	for (auto const& deferred_decode : *m_deferred_decodes) {
+		deferred_decode.reset();
+	}
+	m_mock_state->active = false;
+	// views handed out before keep the previous results alive
+	std::lock_guard<std::mutex> lock(m_result_cache->mutex);
+	m_result_cache->spikes.reset();
+	m_result_cache->spike_columns.reset();
+	m_result_cache->madc_sample_columns.reset();
+}
+
+void PlaybackProgram::mock_responses(std::mt19937& gen)
+{
+	for (auto const& deferred_decode : *m_deferred_decodes) {
+		deferred_decode.mock(gen);
+	}
+}
+
+void PlaybackProgram::mock_spike_echo()
+{
+	m_mock_state->active = true;
+}
+
+void PlaybackProgram::accumulate_spike_histogram() const
+{
+	if (!m_spike_histogram) {
+		return;
+	}
+	if (m_mock_state->active) {
+		auto const& spikes = m_mock_state->spikes;
+		m_spike_histogram->add(
+		    spikes.begin(), spikes.end(), [](haldls::vx::SpikeFromChip const& spike) {
+			    return spike;
+		    });
+	} else {
+		// count from the backend representation without converting to spikes_type
+		auto const& spikes_impl = m_program_impl->get_spikes();
+		m_spike_histogram->add(
+		    spikes_impl.begin(), spikes_impl.end(),
+		    [](auto const& event) { return haldls::vx::SpikeFromChip(event); });
+	}
+}
+
 std::ostream& operator<<(std::ostream& os, PlaybackProgram const& program)
 {
 	os << *(program.m_program_impl);
@@ -121,4 +610,107 @@ bool PlaybackProgram::operator!=(PlaybackProgram const& other) const
 	return !(*this == other);
 }
 
+template <typename Archive>
+void PlaybackProgram::save(Archive& ar) const
+{
+	bool const has_executable_restriction = static_cast<bool>(m_executable_restriction);
+	ar(CEREAL_NVP(has_executable_restriction));
+	if (has_executable_restriction) {
+		auto const executable_restriction = *m_executable_restriction;
+		ar(CEREAL_NVP(executable_restriction));
+	}
+	ar(cereal::make_nvp("program_impl", *m_program_impl));
+}
+
+template <typename Archive>
+void PlaybackProgram::load(Archive& ar)
+{
+	bool has_executable_restriction;
+	ar(CEREAL_NVP(has_executable_restriction));
+	if (has_executable_restriction) {
+		ExecutorBackend executable_restriction;
+		ar(CEREAL_NVP(executable_restriction));
+		m_executable_restriction = executable_restriction;
+	} else {
+		m_executable_restriction.reset();
+	}
+	ar(cereal::make_nvp("program_impl", *m_program_impl));
+}
+
+template SYMBOL_VISIBLE void PlaybackProgram::save(cereal::BinaryOutputArchive&) const;
+template SYMBOL_VISIBLE void PlaybackProgram::save(cereal::PortableBinaryOutputArchive&) const;
+template SYMBOL_VISIBLE void PlaybackProgram::save(cereal::JSONOutputArchive&) const;
+template SYMBOL_VISIBLE void PlaybackProgram::save(cereal::XMLOutputArchive&) const;
+template SYMBOL_VISIBLE void PlaybackProgram::load(cereal::BinaryInputArchive&);
+template SYMBOL_VISIBLE void PlaybackProgram::load(cereal::PortableBinaryInputArchive&);
+template SYMBOL_VISIBLE void PlaybackProgram::load(cereal::JSONInputArchive&);
+template SYMBOL_VISIBLE void PlaybackProgram::load(cereal::XMLInputArchive&);
+
+namespace {
+
+/** Identifier at the beginning of files written by PlaybackProgram::save(). */
+constexpr char saved_program_magic[] = "STADLSVXPROGRAM";
+
+/** Format version of files written by PlaybackProgram::save(). */
+constexpr uint32_t saved_program_version = 1;
+
+/**
+ * Read-only stream buffer over an existing memory region.
+ */
+class MemoryStreamBuffer : public std::streambuf
+{
+public:
+	MemoryStreamBuffer(char const* data, size_t const size)
+	{
+		auto begin = const_cast<char*>(data);
+		setg(begin, begin, begin + size);
+	}
+};
+
+} // namespace
+
+void PlaybackProgram::save(std::string const& filename) const
+{
+	std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+	if (!file) {
+		throw std::runtime_error("Failed to open " + filename + " for writing.");
+	}
+	file.write(saved_program_magic, sizeof(saved_program_magic));
+	file.write(
+	    reinterpret_cast<char const*>(&saved_program_version), sizeof(saved_program_version));
+	{
+		cereal::BinaryOutputArchive archive(file);
+		archive(*this);
+	}
+	if (!file) {
+		throw std::runtime_error("Failed to write " + filename + ".");
+	}
+}
+
+PlaybackProgram PlaybackProgram::load(std::string const& filename)
+{
+	detail::FileMapping const mapping(filename);
+	size_t const header_size = sizeof(saved_program_magic) + sizeof(saved_program_version);
+	if ((mapping.size() < header_size) ||
+	    (std::memcmp(mapping.data(), saved_program_magic, sizeof(saved_program_magic)) != 0)) {
+		throw std::runtime_error(filename + " does not contain a saved PlaybackProgram.");
+	}
+	uint32_t version;
+	std::memcpy(&version, mapping.data() + sizeof(saved_program_magic), sizeof(version));
+	if (version != saved_program_version) {
+		throw std::runtime_error(
+		    filename + " contains unsupported PlaybackProgram format version " +
+		    std::to_string(version) + ".");
+	}
+
+	MemoryStreamBuffer buffer(mapping.data() + header_size, mapping.size() - header_size);
+	std::istream stream(&buffer);
+	PlaybackProgram program;
+	{
+		cereal::BinaryInputArchive archive(stream);
+		archive(program);
+	}
+	return program;
+}
+
 } // namespace stadls::vx
@@ -1,25 +1,125 @@
 #include "stadls/vx/playback_program_builder.h"
 
+#include <any>
+#include <memory>
 #include <optional>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+#include "fisch/vx/jtag.h"
+#include "fisch/vx/omnibus.h"
 #include "fisch/vx/playback_program_builder.h"
 #include "haldls/vx/common.h"
+#include "haldls/vx/event.h"
 #include "haldls/vx/is_readable.h"
+#include "haldls/vx/reset.h"
+#include "haldls/vx/timer.h"
+#include "hate/type_list.h"
 #include "stadls/visitors.h"
+#include "stadls/vx/encode_cache.h"
 #include "stadls/vx/playback_program.h"
+#include "stadls/vx/spike_train_file.h"
 
 namespace stadls::vx {
 
+/**
+ * Last written word per location, stored separately for each backend container type.
+ * Backend container types accessing the same hardware locations via different paths invalidate
+ * each other's shadow state on write.
+ */
+struct PlaybackProgramBuilder::ShadowState
+{
+	/** Backend container types accessing the chip's omnibus address space. */
+	typedef hate::type_list<fisch::vx::OmnibusChip, fisch::vx::OmnibusChipOverJTAG>
+	    chip_omnibus_aliases;
+
+	template <typename BackendContainer>
+	using storage_type =
+	    std::unordered_map<typename BackendContainer::coordinate_type, BackendContainer>;
+
+	template <typename BackendContainer>
+	storage_type<BackendContainer>& get()
+	{
+		auto& storage = storages[std::type_index(typeid(BackendContainer))];
+		if (!storage.has_value()) {
+			storage = storage_type<BackendContainer>();
+		}
+		return std::any_cast<storage_type<BackendContainer>&>(storage);
+	}
+
+	/**
+	 * Set shadow state of given locations to given words.
+	 * @param addresses Locations
+	 * @param words Words
+	 */
+	template <typename AddressesT, typename WordsT>
+	void assign(AddressesT const& addresses, WordsT const& words)
+	{
+		invalidate_aliases<typename WordsT::value_type>(chip_omnibus_aliases());
+		auto& storage = get<typename WordsT::value_type>();
+		for (size_t i = 0; i < words.size(); ++i) {
+			storage.insert_or_assign(addresses[i], words[i]);
+		}
+	}
+
+	/**
+	 * Drop shadow state of given locations.
+	 * @param addresses Locations
+	 */
+	template <typename BackendContainer, typename AddressesT>
+	void invalidate(AddressesT const& addresses)
+	{
+		auto& storage = get<BackendContainer>();
+		for (auto const& address : addresses) {
+			storage.erase(address);
+		}
+	}
+
+	/**
+	 * Drop shadow state of all other backend container types aliasing the given one.
+	 * @tparam BackendContainer Backend container type to be written
+	 * @tparam Aliases Backend container types accessing the same locations
+	 */
+	template <typename BackendContainer, typename... Aliases>
+	void invalidate_aliases(hate::type_list<Aliases...>)
+	{
+		if constexpr (hate::is_in_type_list<BackendContainer, hate::type_list<Aliases...>>::value) {
+			for (auto const& alias : {std::type_index(typeid(Aliases))...}) {
+				if (alias != std::type_index(typeid(BackendContainer))) {
+					storages.erase(alias);
+				}
+			}
+		}
+	}
+
+	std::unordered_map<std::type_index, std::any> storages;
+};
+
 PlaybackProgramBuilder::PlaybackProgramBuilder(
     std::optional<ExecutorBackend> const executable_restriction) :
     m_builder_impl(std::make_unique<fisch::vx::PlaybackProgramBuilder>()),
-    m_executable_restriction(executable_restriction)
+    m_executable_restriction(executable_restriction),
+    m_deferred_decodes(),
+    m_mock_time(),
+    m_mock_spikes(),
+    m_shadow_state()
 {}
 
 PlaybackProgramBuilder::PlaybackProgramBuilder(PlaybackProgramBuilder&& other) :
     m_builder_impl(std::move(other.m_builder_impl)),
-    m_executable_restriction(other.m_executable_restriction)
+    m_executable_restriction(other.m_executable_restriction),
+    m_deferred_decodes(std::move(other.m_deferred_decodes)),
+    m_mock_time(other.m_mock_time),
+    m_mock_spikes(std::move(other.m_mock_spikes)),
+    m_shadow_state(std::move(other.m_shadow_state))
 {
 	other.m_executable_restriction = std::nullopt;
+	other.m_deferred_decodes.clear();
+	other.m_mock_time = haldls::vx::Timer::Value();
+	other.m_mock_spikes.clear();
 }
 
 PlaybackProgramBuilder::~PlaybackProgramBuilder() {}
@@ -28,8 +128,359 @@ void PlaybackProgramBuilder::wait_until(
     typename haldls::vx::Timer::coordinate_type const& coord, haldls::vx::Timer::Value const time)
 {
 	m_builder_impl->wait_until(coord, time);
+	m_mock_time = time;
+}
+
+template <typename TimeAt, typename LabelAt>
+void PlaybackProgramBuilder::write_spike_train(
+    size_t const size, TimeAt const& time_at, LabelAt const& label_at)
+{
+	using namespace haldls::vx;
+
+	// validate complete train, including the range of times, before adding any instruction
+	for (size_t i = 1; i < size; ++i) {
+		if (time_at(i) < time_at(i - 1)) {
+			throw std::runtime_error("Spike times are not sorted.");
+		}
+	}
+
+	size_t begin = 0;
+	while (begin < size) {
+		auto const time = time_at(begin);
+		size_t end = begin + 1;
+		while ((end < size) && (time_at(end) == time)) {
+			++end;
+		}
+
+		wait_until(Timer::coordinate_type(), time);
+		// pack co-temporal spikes into packs of three and a single pack for the remainder
+		for (; begin + 3 <= end; begin += 3) {
+			write(
+			    SpikePack3ToChip::coordinate_type(),
+			    SpikePack3ToChip(SpikePack3ToChip::labels_type{
+			        label_at(begin), label_at(begin + 1), label_at(begin + 2)}));
+		}
+		if (end - begin == 2) {
+			write(
+			    SpikePack2ToChip::coordinate_type(),
+			    SpikePack2ToChip(
+			        SpikePack2ToChip::labels_type{label_at(begin), label_at(begin + 1)}));
+		} else if (end - begin == 1) {
+			write(
+			    SpikePack1ToChip::coordinate_type(),
+			    SpikePack1ToChip(SpikePack1ToChip::labels_type{label_at(begin)}));
+		}
+		begin = end;
+	}
+}
+
+void PlaybackProgramBuilder::write_spike_train(
+    std::vector<haldls::vx::Timer::Value> const& times,
+    std::vector<haldls::vx::SpikeLabel> const& labels)
+{
+	if (times.size() != labels.size()) {
+		throw std::runtime_error("Number of spike times and labels do not match.");
+	}
+	write_spike_train(
+	    times.size(), [&times](size_t const i) { return times[i]; },
+	    [&labels](size_t const i) { return labels[i]; });
+}
+
+void PlaybackProgramBuilder::write_spike_train(
+    uint64_t const* const times, uint16_t const* const labels, size_t const size)
+{
+	auto const time_at = [times](size_t const i) {
+		// check before narrowing to the timer value type
+		if (times[i] > haldls::vx::Timer::Value::max) {
+			throw std::overflow_error("Spike time exceeds range of timer value.");
+		}
+		return haldls::vx::Timer::Value(times[i]);
+	};
+	write_spike_train(
+	    size, time_at, [labels](size_t const i) { return haldls::vx::SpikeLabel(labels[i]); });
+}
+
+void PlaybackProgramBuilder::write_spike_train(SpikeTrainFile const& spike_train_file)
+{
+	m_builder_impl->copy_back(*(spike_train_file.m_builder.m_builder_impl));
+	if (spike_train_file.get_num_packs() == 0) {
+		return;
+	}
+	// only recorded on request to not burden programs for other backends
+	if (m_executable_restriction == ExecutorBackend::mock) {
+		for (auto record = spike_train_file.begin(); record != spike_train_file.end(); ++record) {
+			for (size_t i = 0; i < record->num_labels; ++i) {
+				m_mock_spikes.push_back(haldls::vx::SpikeFromChip(
+				    haldls::vx::SpikeLabel(record->labels[i]), haldls::vx::FPGATime(record->time),
+				    haldls::vx::ChipTime()));
+			}
+		}
+	}
+	m_mock_time = spike_train_file.get_end_time();
+}
+
+template <typename T>
+void PlaybackProgramBuilder::record_for_mock(T const& config)
+{
+	if constexpr (std::is_same<T, haldls::vx::Timer>::value) {
+		m_mock_time = config.get();
+	} else if constexpr (
+	    std::is_same<T, haldls::vx::SpikePack1ToChip>::value ||
+	    std::is_same<T, haldls::vx::SpikePack2ToChip>::value ||
+	    std::is_same<T, haldls::vx::SpikePack3ToChip>::value) {
+		// only recorded on request to not burden programs for other backends
+		if (m_executable_restriction == ExecutorBackend::mock) {
+			for (auto const& label : config.get_labels()) {
+				m_mock_spikes.push_back(haldls::vx::SpikeFromChip(
+				    label, haldls::vx::FPGATime(m_mock_time.value()), haldls::vx::ChipTime()));
+			}
+		}
+	}
+}
+
+template <typename T, typename AddressesT, typename WordsT>
+void PlaybackProgramBuilder::write_shadowed(AddressesT const& addresses, WordsT const& words)
+{
+	if (!m_shadow_state) {
+		m_builder_impl->write(addresses, words);
+		return;
+	}
+
+	typedef typename WordsT::value_type word_type;
+	if constexpr (std::is_same<T, haldls::vx::ResetChip>::value) {
+		m_shadow_state->storages.clear();
+		m_builder_impl->write(addresses, words);
+	} else if constexpr (std::is_base_of<haldls::vx::DifferentialWriteTrait, T>::value) {
+		m_shadow_state->invalidate_aliases<word_type>(ShadowState::chip_omnibus_aliases());
+		auto& storage = m_shadow_state->get<word_type>();
+		std::vector<typename word_type::coordinate_type> changed_addresses;
+		std::vector<word_type> changed_words;
+		for (size_t i = 0; i < words.size(); ++i) {
+			auto const it = storage.find(addresses[i]);
+			if ((it == storage.end()) || (it->second != words[i])) {
+				changed_addresses.push_back(addresses[i]);
+				changed_words.push_back(words[i]);
+				storage.insert_or_assign(addresses[i], words[i]);
+			}
+		}
+		if (!changed_words.empty()) {
+			m_builder_impl->write(changed_addresses, changed_words);
+		}
+	} else {
+		// the effect of writes to e.g. trigger or reset locations is not known, therefore they are
+		// always written and subsequent differential writes to the same location are complete
+		m_shadow_state->invalidate_aliases<word_type>(ShadowState::chip_omnibus_aliases());
+		m_shadow_state->invalidate<word_type>(addresses);
+		m_builder_impl->write(addresses, words);
+	}
+}
+
+void PlaybackProgramBuilder::set_enable_shadow_state(bool const value)
+{
+	if (!value) {
+		m_shadow_state.reset();
+	} else if (!m_shadow_state) {
+		m_shadow_state = std::make_unique<ShadowState>();
+	}
+}
+
+bool PlaybackProgramBuilder::get_enable_shadow_state() const
+{
+	return static_cast<bool>(m_shadow_state);
+}
+
+void PlaybackProgramBuilder::reset_shadow_state()
+{
+	if (m_shadow_state) {
+		m_shadow_state->storages.clear();
+	}
+}
+
+namespace {
+
+template <typename T, typename = void>
+struct has_config_size_in_words : std::false_type
+{};
+
+template <typename T>
+struct has_config_size_in_words<T, std::void_t<decltype(T::config_size_in_words)>>
+    : std::true_type
+{};
+
+template <typename T, typename = void>
+struct has_write_config_size_in_words : std::false_type
+{};
+
+template <typename T>
+struct has_write_config_size_in_words<T, std::void_t<decltype(T::write_config_size_in_words)>>
+    : std::true_type
+{};
+
+/**
+ * Get number of words written by a container if known at compile time.
+ * Leaf containers expose their size via `config_size_in_words` or `write_config_size_in_words`,
+ * for composite containers zero is returned and the buffer capacity is grown on first use.
+ * @tparam T Container type
+ * @return Number of words
+ */
+template <typename T>
+constexpr size_t write_size_in_words_hint()
+{
+	if constexpr (has_config_size_in_words<T>::value) {
+		return T::config_size_in_words;
+	} else if constexpr (has_write_config_size_in_words<T>::value) {
+		return T::write_config_size_in_words;
+	} else {
+		return 0;
+	}
+}
+
+/**
+ * Per-thread reusable address and word storage for encoding a container.
+ * The vectors are cleared but never shrunk, so after the first write of the largest container of
+ * a backend type no further heap allocations take place during encoding.
+ * @tparam BackendContainer Backend container type of encoded words
+ */
+template <typename BackendContainer>
+struct EncodeBuffer
+{
+	typedef std::vector<typename BackendContainer::coordinate_type> addresses_type;
+	typedef std::vector<BackendContainer> words_type;
+
+	addresses_type addresses;
+	words_type words;
+	words_type reference_words;
+
+	/**
+	 * Get cleared thread-local buffer instance with capacity for at least given number of words.
+	 * @param size_hint Number of words to reserve
+	 * @return Reference to buffer
+	 */
+	static EncodeBuffer& get(size_t const size_hint)
+	{
+		thread_local EncodeBuffer buffer;
+		buffer.addresses.clear();
+		buffer.words.clear();
+		buffer.reference_words.clear();
+		buffer.addresses.reserve(size_hint);
+		buffer.words.reserve(size_hint);
+		return buffer;
+	}
+};
+
+/**
+ * Encode addresses and words of container at given location.
+ * @tparam T Container type
+ * @tparam AddressesT Address sequence type
+ * @tparam WordsT Word sequence type
+ * @param coord Coordinate of container
+ * @param config Container to encode
+ * @param addresses Address sequence to append to
+ * @param words Word sequence to append to
+ * @throws std::runtime_error On container not being writeable
+ */
+template <typename T, typename AddressesT, typename WordsT>
+void encode_write(
+    typename T::coordinate_type const& coord, T const& config, AddressesT& addresses, WordsT& words)
+{
+	size_t const previous_size = words.size();
+	haldls::vx::visit_preorder(config, coord, stadls::WriteAddressVisitor<AddressesT>{addresses});
+	haldls::vx::visit_preorder(config, coord, stadls::EncodeVisitor<WordsT>{words});
+
+	if (words.size() != addresses.size()) {
+		throw std::logic_error("number of addresses and words do not match");
+	}
+
+	// sparse containers without changes are valid and do not produce words
+	if ((words.size() == previous_size) &&
+	    !std::is_base_of<haldls::vx::SparseWriteTrait, T>::value) {
+		throw std::runtime_error("Container not writeable.");
+	}
 }
 
+/**
+ * Typed storage of the EncodeCache for a container and backend container type of one thread.
+ * @tparam T Container type
+ * @tparam BackendContainer Backend container type of encoded words
+ */
+template <typename T, typename BackendContainer>
+class EncodeCacheStorage
+{
+public:
+	struct Entry
+	{
+		T config;
+		std::vector<typename BackendContainer::coordinate_type> addresses;
+		std::vector<BackendContainer> words;
+	};
+
+	/**
+	 * Get storage of the calling thread.
+	 * Entries are dropped if the cache was cleared since the last access.
+	 * @return Storage
+	 */
+	static EncodeCacheStorage& get()
+	{
+		thread_local EncodeCacheStorage storage;
+		auto const generation = EncodeCache::get_generation();
+		if (storage.m_generation != generation) {
+			storage.m_entries.clear();
+			storage.m_size = 0;
+			storage.m_generation = generation;
+		}
+		return storage;
+	}
+
+	/**
+	 * Get entry or nullptr if not present.
+	 * @param coord Coordinate of container
+	 * @param config Container
+	 * @return Entry
+	 */
+	Entry const* find(typename T::coordinate_type const& coord, T const& config) const
+	{
+		auto const it = m_entries.find(coord.toEnum());
+		if (it == m_entries.end()) {
+			return nullptr;
+		}
+		for (auto const& entry : it->second) {
+			if (entry.config == config) {
+				return &entry;
+			}
+		}
+		return nullptr;
+	}
+
+	/**
+	 * Insert entry if the maximal size of the cache is not reached.
+	 * @param coord Coordinate of container
+	 * @param entry Entry to insert
+	 */
+	void insert(typename T::coordinate_type const& coord, Entry&& entry)
+	{
+		if (!EncodeCache::reserve_entry()) {
+			return;
+		}
+		m_entries[coord.toEnum()].push_back(std::move(entry));
+		m_size++;
+	}
+
+	~EncodeCacheStorage()
+	{
+		EncodeCache::release_entries(m_size, m_generation);
+	}
+
+private:
+	EncodeCacheStorage() : m_entries(), m_size(0), m_generation(EncodeCache::get_generation()) {}
+
+	/** Entries per enum value of the coordinate. */
+	std::unordered_map<size_t, std::vector<Entry>> m_entries;
+	size_t m_size;
+	size_t m_generation;
+};
+
+} // namespace
+
 template <typename T, size_t SupportedBackendIndex>
 void PlaybackProgramBuilder::write_table_entry(
     PlaybackProgramBuilder& builder,
@@ -42,45 +493,65 @@ void PlaybackProgramBuilder::write_table_entry(
 	    typename haldls::vx::detail::BackendContainerTrait<T>::container_list>::type
 	    backend_container_type;
 
-	typedef std::vector<typename backend_container_type::coordinate_type> addresses_type;
-	addresses_type write_addresses;
-	haldls::vx::visit_preorder(
-	    config, coord, stadls::WriteAddressVisitor<addresses_type>{write_addresses});
+	if constexpr (hate::is_in_type_list<
+	                  T, stadls::vx::detail::EncodeCacheableContainerList>::value) {
+		if (!config_reference && EncodeCache::get_enabled()) {
+			typedef EncodeCacheStorage<T, backend_container_type> storage_type;
+			auto& storage = storage_type::get();
+			builder.record_for_mock(config);
+			if (auto const entry = storage.find(coord, config); entry) {
+				EncodeCache::count_hit();
+				builder.write_shadowed<T>(entry->addresses, entry->words);
+			} else {
+				EncodeCache::count_miss();
+				typename storage_type::Entry new_entry{config, {}, {}};
+				encode_write(coord, config, new_entry.addresses, new_entry.words);
+				builder.write_shadowed<T>(new_entry.addresses, new_entry.words);
+				storage.insert(coord, std::move(new_entry));
+			}
+			return;
+		}
+	}
 
-	typedef std::vector<backend_container_type> words_type;
-	words_type words;
-	haldls::vx::visit_preorder(config, coord, stadls::EncodeVisitor<words_type>{words});
+	typedef EncodeBuffer<backend_container_type> buffer_type;
+	auto& buffer = buffer_type::get(write_size_in_words_hint<T>());
+	auto& write_addresses = buffer.addresses;
+	auto& words = buffer.words;
 
-	if (words.size() != write_addresses.size()) {
-		throw std::logic_error("number of addresses and words do not match");
-	}
+	encode_write(coord, config, write_addresses, words);
 
-	if (words.size() == 0) {
-		throw std::runtime_error("Container not writeable.");
-	}
+	builder.record_for_mock(config);
 
 	if (config_reference) {
 		if constexpr (std::is_base_of<haldls::vx::DifferentialWriteTrait, T>::value) {
-			words_type reference_words;
+			auto& reference_words = buffer.reference_words;
+			reference_words.reserve(words.size());
 			haldls::vx::visit_preorder(
-			    *config_reference, coord, stadls::EncodeVisitor<words_type>{reference_words});
+			    *config_reference, coord,
+			    stadls::EncodeVisitor<typename buffer_type::words_type>{reference_words});
 			if (reference_words.size() != words.size()) {
 				throw std::logic_error("number of words of container and reference do not match");
 			}
-			words_type reduced_words;
-			addresses_type reduced_addresses;
+			if (builder.m_shadow_state) {
+				builder.m_shadow_state->assign(write_addresses, words);
+			}
+			// compact differing words in-place to not allocate reduced copies
+			size_t reduced_size = 0;
 			for (size_t i = 0; i < reference_words.size(); ++i) {
 				if (reference_words[i] != words[i]) {
-					reduced_words.push_back(words[i]);
-					reduced_addresses.push_back(write_addresses[i]);
+					words[reduced_size] = words[i];
+					write_addresses[reduced_size] = write_addresses[i];
+					++reduced_size;
 				}
 			}
-			builder.m_builder_impl->write(reduced_addresses, reduced_words);
+			words.resize(reduced_size);
+			write_addresses.resize(reduced_size);
+			builder.m_builder_impl->write(write_addresses, words);
 		} else {
 			throw std::logic_error("Container type does not support differential write.");
 		}
 	} else {
-		builder.m_builder_impl->write(write_addresses, words);
+		builder.write_shadowed<T>(write_addresses, words);
 	}
 }
 
@@ -153,13 +624,141 @@ void PlaybackProgramBuilder::write_table_generator(
 #pragma pop_macro("PLAYBACK_CONTAINER")
 #include "lola/vx/container.def"
 
+template <typename T, size_t SupportedBackendIndex>
+void PlaybackProgramBuilder::write_many_table_entry(
+    PlaybackProgramBuilder& builder,
+    std::vector<typename T::coordinate_type> const& coords,
+    std::vector<T> const& configs)
+{
+	typedef typename hate::index_type_list_by_integer<
+	    SupportedBackendIndex,
+	    typename haldls::vx::detail::BackendContainerTrait<T>::container_list>::type
+	    backend_container_type;
+
+	typedef EncodeBuffer<backend_container_type> buffer_type;
+	auto& buffer = buffer_type::get(write_size_in_words_hint<T>() * configs.size());
+	auto& write_addresses = buffer.addresses;
+	auto& words = buffer.words;
+
+	for (size_t i = 0; i < configs.size(); ++i) {
+		encode_write(coords[i], configs[i], write_addresses, words);
+	}
+
+	for (auto const& config : configs) {
+		builder.record_for_mock(config);
+	}
+
+	builder.write_shadowed<T>(write_addresses, words);
+}
+
+template <typename T, size_t... SupportedBackendIndex>
+void PlaybackProgramBuilder::write_many_table_generator(
+    std::vector<typename T::coordinate_type> const& coords,
+    std::vector<T> const& configs,
+    size_t const backend_index,
+    std::index_sequence<SupportedBackendIndex...>)
+{
+	std::array<
+	    void (*)(
+	        PlaybackProgramBuilder&, std::vector<typename T::coordinate_type> const&,
+	        std::vector<T> const&),
+	    sizeof...(SupportedBackendIndex)>
+	    write_table{write_many_table_entry<T, SupportedBackendIndex>...};
+
+	write_table.at(backend_index)(*this, coords, configs);
+}
+
+#define PLAYBACK_CONTAINER(Name, Type)                                                             \
+	void PlaybackProgramBuilder::write_many(                                                       \
+	    std::vector<typename Type::coordinate_type> const& coords,                                 \
+	    std::vector<Type> const& configs, haldls::vx::Backend backend)                             \
+	{                                                                                              \
+		if (!haldls::vx::detail::BackendContainerTrait<Type>::valid(backend)) {                    \
+			throw std::runtime_error("Backend not supported for container type.");                 \
+		}                                                                                          \
+		if (coords.size() != configs.size()) {                                                     \
+			throw std::runtime_error("Number of coordinates and containers do not match.");        \
+		}                                                                                          \
+		if (configs.empty()) {                                                                     \
+			return;                                                                                \
+		}                                                                                          \
+		size_t const backend_index = static_cast<size_t>(                                          \
+		    haldls::vx::detail::BackendContainerTrait<Type>::backend_index_lookup_table.at(        \
+		        static_cast<size_t>(backend)));                                                    \
+		write_many_table_generator<Type>(                                                          \
+		    coords, configs, backend_index,                                                        \
+		    std::make_index_sequence<                                                              \
+		        hate::type_list_size<typename haldls::vx::detail::BackendContainerTrait<           \
+		            Type>::container_list>::value>());                                             \
+	}                                                                                              \
+	void PlaybackProgramBuilder::write_many(                                                       \
+	    std::vector<typename Type::coordinate_type> const& coords,                                 \
+	    std::vector<Type> const& configs)                                                          \
+	{                                                                                              \
+		write_many(                                                                                \
+		    coords, configs, haldls::vx::detail::BackendContainerTrait<Type>::default_backend);    \
+	}
+#pragma push_macro("PLAYBACK_CONTAINER")
+#include "haldls/vx/container.def"
+#pragma pop_macro("PLAYBACK_CONTAINER")
+#include "lola/vx/container.def"
+
+template <class T, class BackendContainer>
+void PlaybackProgramBuilder::restrict_executable_for_read()
+{
+	using namespace haldls::vx::detail;
+	if constexpr (
+	    !is_hardware_readable<T, BackendContainer>() &&
+	    !is_simulation_readable<T, BackendContainer>()) {
+		throw std::runtime_error("Container not readable.");
+	}
+	if (!m_executable_restriction) {
+		if constexpr (!is_simulation_readable<T, BackendContainer>()) {
+			m_executable_restriction = ExecutorBackend::hardware;
+		} else if constexpr (!is_hardware_readable<T, BackendContainer>()) {
+			m_executable_restriction = ExecutorBackend::simulation;
+		}
+	} else {
+		if ((!is_simulation_readable<T, BackendContainer>() &&
+		     (m_executable_restriction == ExecutorBackend::simulation)) ||
+		    (!is_hardware_readable<T, BackendContainer>() &&
+		     (m_executable_restriction == ExecutorBackend::hardware))) {
+			throw std::runtime_error(
+			    "Container not readable for current executor backend restriction.");
+		}
+	}
+}
+
+namespace {
+
+/**
+ * Append read addresses of container at given location.
+ * @tparam T Container type
+ * @tparam AddressesT Address sequence type
+ * @param coord Coordinate of container
+ * @param addresses Address sequence to append to
+ */
+template <class T, class AddressesT>
+void append_read_addresses(typename T::coordinate_type const& coord, AddressesT& addresses)
+{
+	T config;
+
+	if constexpr (std::is_same<T, haldls::vx::PPUMemoryBlock>::value) {
+		// FIXME (Issue #3327): PPUMemoryBlock needs special size on construction
+		config = haldls::vx::PPUMemoryBlock(coord.toPPUMemoryBlockSize());
+	}
+
+	haldls::vx::visit_preorder(config, coord, stadls::ReadAddressVisitor<AddressesT>{addresses});
+}
+
+} // namespace
+
 template <class T, size_t... SupportedBackendIndex>
 PlaybackProgram::ContainerTicket<T> PlaybackProgramBuilder::read_table_generator(
     typename T::coordinate_type const& coord,
     size_t backend_index,
     std::index_sequence<SupportedBackendIndex...>)
 {
-	using namespace haldls::vx::detail;
 	std::array<
 	    PlaybackProgram::ContainerTicket<T> (*)(
 	        PlaybackProgramBuilder&, typename T::coordinate_type const&),
@@ -170,45 +769,66 @@ PlaybackProgram::ContainerTicket<T> PlaybackProgramBuilder::read_table_generator
 		        SupportedBackendIndex,
 		        typename haldls::vx::detail::BackendContainerTrait<T>::container_list>::type
 		        backend_container_type;
-		    if constexpr (
-		        !is_hardware_readable<T, backend_container_type>() &&
-		        !is_simulation_readable<T, backend_container_type>()) {
-			    throw std::runtime_error("Container not readable.");
-		    }
-		    if (!builder.m_executable_restriction) {
-			    if constexpr (!is_simulation_readable<T, backend_container_type>()) {
-				    builder.m_executable_restriction = ExecutorBackend::hardware;
-			    } else if constexpr (!is_hardware_readable<T, backend_container_type>()) {
-				    builder.m_executable_restriction = ExecutorBackend::simulation;
-			    }
-		    } else {
-			    if ((!is_simulation_readable<T, backend_container_type>() &&
-			         (builder.m_executable_restriction == ExecutorBackend::simulation)) ||
-			        (!is_hardware_readable<T, backend_container_type>() &&
-			         (builder.m_executable_restriction == ExecutorBackend::hardware))) {
-				    throw std::runtime_error(
-				        "Container not readable for current executor backend restriction.");
-			    }
-		    }
+		    builder.restrict_executable_for_read<T, backend_container_type>();
 
 		    typedef std::vector<typename backend_container_type::coordinate_type> addresses_type;
 		    addresses_type read_addresses;
-		    {
-			    T config;
+		    append_read_addresses<T>(coord, read_addresses);
+		    auto ticket_impl = builder.m_builder_impl->read(read_addresses);
+		    PlaybackProgram::ContainerTicket<T> const ticket(coord, ticket_impl);
+		    PlaybackProgram::fpga_time_type const mock_time(builder.m_mock_time.value());
+		    builder.m_deferred_decodes.push_back(
+		        {[ticket]() { ticket.decode_into_cache(); }, [ticket]() { ticket.reset_cache(); },
+		         [ticket, mock_time](std::mt19937& gen) {
+			         ticket.mock_into_cache(gen, mock_time);
+		         }});
+		    return ticket;
+	    }...};
 
-			    if constexpr (std::is_same<T, haldls::vx::PPUMemoryBlock>::value) {
-				    // FIXME (Issue #3327): PPUMemoryBlock needs special size on construction
-				    config = haldls::vx::PPUMemoryBlock(coord.toPPUMemoryBlockSize());
-			    }
+	return read_table.at(backend_index)(*this, coord);
+}
 
-			    haldls::vx::visit_preorder(
-			        config, coord, stadls::ReadAddressVisitor<addresses_type>{read_addresses});
+template <class T, size_t... SupportedBackendIndex>
+PlaybackProgram::ContainerBatchTicket<T> PlaybackProgramBuilder::read_many_table_generator(
+    std::vector<typename T::coordinate_type> const& coords,
+    size_t backend_index,
+    std::index_sequence<SupportedBackendIndex...>)
+{
+	std::array<
+	    PlaybackProgram::ContainerBatchTicket<T> (*)(
+	        PlaybackProgramBuilder&, std::vector<typename T::coordinate_type> const&),
+	    sizeof...(SupportedBackendIndex)>
+	    read_table{[](PlaybackProgramBuilder& builder,
+	                  std::vector<typename T::coordinate_type> const& coords)
+	                   -> PlaybackProgram::ContainerBatchTicket<T> {
+		    typedef typename hate::index_type_list_by_integer<
+		        SupportedBackendIndex,
+		        typename haldls::vx::detail::BackendContainerTrait<T>::container_list>::type
+		        backend_container_type;
+		    builder.restrict_executable_for_read<T, backend_container_type>();
+
+		    typedef std::vector<typename backend_container_type::coordinate_type> addresses_type;
+		    addresses_type read_addresses;
+		    std::vector<size_t> word_offsets;
+		    word_offsets.reserve(coords.size() + 1);
+		    word_offsets.push_back(0);
+		    for (auto const& coord : coords) {
+			    append_read_addresses<T>(coord, read_addresses);
+			    word_offsets.push_back(read_addresses.size());
 		    }
 		    auto ticket_impl = builder.m_builder_impl->read(read_addresses);
-		    return PlaybackProgram::ContainerTicket<T>(coord, ticket_impl);
+		    PlaybackProgram::ContainerBatchTicket<T> const ticket(
+		        coords, word_offsets, ticket_impl);
+		    PlaybackProgram::fpga_time_type const mock_time(builder.m_mock_time.value());
+		    builder.m_deferred_decodes.push_back(
+		        {[ticket]() { ticket.decode_into_cache(); }, [ticket]() { ticket.reset_cache(); },
+		         [ticket, mock_time](std::mt19937& gen) {
+			         ticket.mock_into_cache(gen, mock_time);
+		         }});
+		    return ticket;
 	    }...};
 
-	return read_table.at(backend_index)(*this, coord);
+	return read_table.at(backend_index)(*this, coords);
 }
 
 #define PLAYBACK_CONTAINER(Name, Type)                                                             \
@@ -232,6 +852,31 @@ PlaybackProgram::ContainerTicket<T> PlaybackProgramBuilder::read_table_generator
 	    typename Type::coordinate_type const& coord)                                               \
 	{                                                                                              \
 		return read(coord, haldls::vx::detail::BackendContainerTrait<Type>::default_backend);      \
+	}                                                                                              \
+	PlaybackProgram::ContainerBatchTicket<Type> PlaybackProgramBuilder::read_many(                 \
+	    std::vector<typename Type::coordinate_type> const& coords, haldls::vx::Backend backend)    \
+	{                                                                                              \
+		if (!haldls::vx::detail::BackendContainerTrait<Type>::valid(backend)) {                    \
+			throw std::runtime_error("Backend not supported for container type.");                 \
+		}                                                                                          \
+		if (coords.empty()) {                                                                      \
+			return PlaybackProgram::ContainerBatchTicket<Type>();                                  \
+		}                                                                                          \
+                                                                                                   \
+		size_t const backend_index = static_cast<size_t>(                                          \
+		    haldls::vx::detail::BackendContainerTrait<Type>::backend_index_lookup_table.at(        \
+		        static_cast<size_t>(backend)));                                                    \
+		return read_many_table_generator<Type>(                                                    \
+		    coords, backend_index,                                                                 \
+		    std::make_index_sequence<                                                              \
+		        hate::type_list_size<typename haldls::vx::detail::BackendContainerTrait<           \
+		            Type>::container_list>::value>());                                             \
+	}                                                                                              \
+	PlaybackProgram::ContainerBatchTicket<Type> PlaybackProgramBuilder::read_many(                 \
+	    std::vector<typename Type::coordinate_type> const& coords)                                 \
+	{                                                                                              \
+		return read_many(                                                                          \
+		    coords, haldls::vx::detail::BackendContainerTrait<Type>::default_backend);             \
 	}
 #pragma push_macro("PLAYBACK_CONTAINER")
 #include "haldls/vx/container.def"
@@ -240,7 +885,16 @@ PlaybackProgram::ContainerTicket<T> PlaybackProgramBuilder::read_table_generator
 
 void PlaybackProgramBuilder::merge_back(PlaybackProgramBuilder& other)
 {
+	// written locations of other builder are unknown
+	reset_shadow_state();
 	m_builder_impl->merge_back(*(other.m_builder_impl));
+	m_deferred_decodes.insert(
+	    m_deferred_decodes.end(), other.m_deferred_decodes.begin(),
+	    other.m_deferred_decodes.end());
+	other.m_deferred_decodes.clear();
+	m_mock_spikes.insert(
+	    m_mock_spikes.end(), other.m_mock_spikes.begin(), other.m_mock_spikes.end());
+	other.m_mock_spikes.clear();
 	if (other.m_executable_restriction) {
 		if (!m_executable_restriction) {
 			m_executable_restriction = other.m_executable_restriction;
@@ -252,12 +906,16 @@ void PlaybackProgramBuilder::merge_back(PlaybackProgramBuilder& other)
 
 void PlaybackProgramBuilder::merge_back(fisch::vx::PlaybackProgramBuilder& other)
 {
+	reset_shadow_state();
 	m_builder_impl->merge_back(other);
 }
 
 void PlaybackProgramBuilder::copy_back(PlaybackProgramBuilder const& other)
 {
+	reset_shadow_state();
 	m_builder_impl->copy_back(*(other.m_builder_impl));
+	m_mock_spikes.insert(
+	    m_mock_spikes.end(), other.m_mock_spikes.begin(), other.m_mock_spikes.end());
 	if (other.m_executable_restriction) {
 		if (!m_executable_restriction) {
 			m_executable_restriction = other.m_executable_restriction;
@@ -269,12 +927,21 @@ void PlaybackProgramBuilder::copy_back(PlaybackProgramBuilder const& other)
 
 void PlaybackProgramBuilder::copy_back(fisch::vx::PlaybackProgramBuilder const& other)
 {
+	reset_shadow_state();
 	m_builder_impl->copy_back(other);
 }
 
 PlaybackProgram PlaybackProgramBuilder::done()
 {
-	return PlaybackProgram(m_builder_impl->done(), m_executable_restriction);
+	auto deferred_decodes =
+	    std::make_shared<PlaybackProgram::deferred_decodes_type>(std::move(m_deferred_decodes));
+	m_deferred_decodes.clear();
+	auto mock_state = std::make_shared<PlaybackProgram::MockState>();
+	mock_state->spikes = std::move(m_mock_spikes);
+	m_mock_spikes.clear();
+	m_mock_time = haldls::vx::Timer::Value();
+	return PlaybackProgram(
+	    m_builder_impl->done(), m_executable_restriction, deferred_decodes, mock_state);
 }
 
 std::ostream& operator<<(std::ostream& os, PlaybackProgramBuilder const& builder)
@@ -1,6 +1,12 @@
 #include "stadls/vx/playback_program_executor.h"
 
+#include <chrono>
+#include <condition_variable>
+#include <deque>
 #include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
 #include <variant>
 #include "fisch/vx/playback_executor.h"
 #include "hxcomm/common/fpga_ip_list.h"
@@ -8,15 +14,229 @@
 
 namespace stadls::vx {
 
+namespace {
+
+/**
+ * In-process executor not executing the program.
+ * Responses are generated by the PlaybackProgramExecutor from the stadls program.
+ */
+struct MockExecutor
+{
+	void run(std::shared_ptr<fisch::vx::PlaybackProgram> const& /* program */) {}
+};
+
+} // namespace
+
 struct PlaybackProgramExecutor::Impl
 {
-	Impl() : m_fisch_executor() {}
+	Impl() :
+	    m_fisch_executor(),
+	    m_run_mutex(),
+	    m_timings(),
+	    m_result_stream(),
+	    m_push_mutex(),
+	    m_submissions(),
+	    m_submission_mutex(),
+	    m_submission_changed(),
+	    m_max_programs_in_flight(default_max_programs_in_flight),
+	    m_programs_in_flight(0),
+	    m_stop_submission(false),
+	    m_submission_thread()
+	{}
+
+	~Impl()
+	{
+		stop_submission();
+		if (m_result_stream) {
+			m_result_stream->detach_producer();
+		}
+	}
+
+	typedef std::variant<
+	    fisch::vx::PlaybackProgramARQExecutor,
+	    fisch::vx::PlaybackProgramSimExecutor,
+	    MockExecutor>
+	    executor_variant_type;
 
-	typedef std::
-	    variant<fisch::vx::PlaybackProgramARQExecutor, fisch::vx::PlaybackProgramSimExecutor>
-	        executor_variant_type;
+	typedef std::chrono::steady_clock clock_type;
+
+	/** Seed of the RNG generating mock responses, reset for every program. */
+	static constexpr std::mt19937::result_type mock_seed = 1234;
+
+	/**
+	 * Program enqueued for asynchronous execution.
+	 */
+	struct Submission
+	{
+		PlaybackProgram program;
+		std::promise<PlaybackProgram> promise;
+	};
+
+	/**
+	 * Execute given program on the connected backend.
+	 * @param program Program to execute
+	 */
+	void run(std::shared_ptr<fisch::vx::PlaybackProgram> const& program)
+	{
+		std::lock_guard<std::mutex> lock(m_run_mutex);
+		run_unlocked(program);
+	}
+
+	/**
+	 * Execute given program on the connected backend, generate responses on the mock backend.
+	 * Decoded results of a previous execution are reset under the run mutex, since copies of the
+	 * program sharing its data may still be executed by the submission thread.
+	 * Results are pushed into the attached result stream after the run mutex is released, which
+	 * allows execution of further programs meanwhile.
+	 * @param program Program to execute
+	 */
+	void run(PlaybackProgram& program)
+	{
+		std::unique_lock<std::mutex> run_lock(m_run_mutex);
+		program.reset_decoded();
+		run_unlocked(program.m_program_impl);
+		if (std::holds_alternative<MockExecutor>(*m_fisch_executor)) {
+			auto const begin = clock_type::now();
+			std::mt19937 gen(mock_seed);
+			program.mock_responses(gen);
+			auto const responded = clock_type::now();
+			program.mock_spike_echo();
+			auto const echoed = clock_type::now();
+			m_timings.mock_response_duration +=
+			    std::chrono::duration<double>(responded - begin).count();
+			m_timings.mock_spike_echo_duration +=
+			    std::chrono::duration<double>(echoed - responded).count();
+		}
+		program.accumulate_spike_histogram();
+		if (!m_result_stream) {
+			return;
+		}
+
+		// hand over from run to push mutex to keep pushes in order of execution
+		auto const result_stream = m_result_stream;
+		std::lock_guard<std::mutex> push_lock(m_push_mutex);
+		run_lock.unlock();
+		if (program.m_mock_state->active) {
+			result_stream->push(program.get_spikes(), program.get_madc_samples());
+		} else {
+			result_stream->push(
+			    program.m_program_impl->get_spikes(), program.m_program_impl->get_madc_samples());
+		}
+	}
+
+	/**
+	 * Execute given program on the connected backend without serialization.
+	 * @param program Program to execute
+	 */
+	void run_unlocked(std::shared_ptr<fisch::vx::PlaybackProgram> const& program)
+	{
+		if (!m_fisch_executor) {
+			throw std::logic_error(
+			    "Trying to call run on an executor without open connection to backend.");
+		}
+		auto const begin = clock_type::now();
+		std::visit(
+		    [&program](auto& fisch_executor) { fisch_executor.run(program); }, *m_fisch_executor);
+		auto const end = clock_type::now();
+		m_timings.program_count++;
+		m_timings.execution_duration += std::chrono::duration<double>(end - begin).count();
+	}
+
+	/**
+	 * Execute enqueued programs in order until stop is requested and the queue is empty.
+	 */
+	void submission_loop()
+	{
+		while (true) {
+			std::optional<Submission> submission;
+			{
+				std::unique_lock<std::mutex> lock(m_submission_mutex);
+				m_submission_changed.wait(
+				    lock, [this]() { return m_stop_submission || !m_submissions.empty(); });
+				if (m_submissions.empty()) {
+					return;
+				}
+				submission.emplace(std::move(m_submissions.front()));
+				m_submissions.pop_front();
+			}
+			try {
+				run(submission->program);
+				submission->promise.set_value(std::move(submission->program));
+			} catch (...) {
+				submission->promise.set_exception(std::current_exception());
+			}
+			{
+				std::lock_guard<std::mutex> lock(m_submission_mutex);
+				m_programs_in_flight--;
+			}
+			m_submission_changed.notify_all();
+		}
+	}
+
+	/**
+	 * Enqueue program for asynchronous execution, start submission thread if not yet running.
+	 * @param submission Program to enqueue
+	 */
+	void submit(Submission&& submission)
+	{
+		std::unique_lock<std::mutex> lock(m_submission_mutex);
+		m_submission_changed.wait(
+		    lock, [this]() { return m_programs_in_flight < m_max_programs_in_flight; });
+		m_submissions.push_back(std::move(submission));
+		m_programs_in_flight++;
+		if (!m_submission_thread.joinable()) {
+			m_stop_submission = false;
+			m_submission_thread = std::thread(&Impl::submission_loop, this);
+		}
+		lock.unlock();
+		m_submission_changed.notify_all();
+	}
+
+	/**
+	 * Block until all enqueued programs are executed.
+	 */
+	void wait_all()
+	{
+		std::unique_lock<std::mutex> lock(m_submission_mutex);
+		m_submission_changed.wait(lock, [this]() { return m_programs_in_flight == 0; });
+	}
+
+	/**
+	 * Execute all enqueued programs and stop submission thread.
+	 */
+	void stop_submission()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_submission_mutex);
+			m_stop_submission = true;
+		}
+		m_submission_changed.notify_all();
+		if (m_submission_thread.joinable()) {
+			m_submission_thread.join();
+		}
+	}
 
 	std::unique_ptr<executor_variant_type> m_fisch_executor;
+
+	/** Serializes synchronous and asynchronous execution on the fisch executor. */
+	std::mutex m_run_mutex;
+
+	/** Accumulated timings, guarded by the run mutex. */
+	Timings m_timings;
+
+	/** Stream receiving results of executed programs, guarded by the run mutex. */
+	std::shared_ptr<ResultStream> m_result_stream;
+
+	/** Serializes pushes into the result stream, acquired before releasing the run mutex. */
+	std::mutex m_push_mutex;
+
+	std::deque<Submission> m_submissions;
+	std::mutex m_submission_mutex;
+	std::condition_variable m_submission_changed;
+	size_t m_max_programs_in_flight;
+	size_t m_programs_in_flight;
+	bool m_stop_submission;
+	std::thread m_submission_thread;
 };
 
 PlaybackProgramExecutor::PlaybackProgramExecutor() : m_impl(std::make_unique<Impl>()) {}
@@ -73,6 +293,19 @@ void PlaybackProgramExecutor::connect_simulator()
 	}
 }
 
+void PlaybackProgramExecutor::connect_mock()
+{
+	if (!m_impl) {
+		throw std::logic_error("Unexpected access to moved-from object.");
+	}
+
+	if (m_impl->m_fisch_executor) {
+		throw std::logic_error("Trying to connect an already connected executor to mock.");
+	}
+	m_impl->m_fisch_executor = std::make_unique<Impl::executor_variant_type>(
+	    std::in_place_type_t<MockExecutor>());
+}
+
 void PlaybackProgramExecutor::connect()
 {
 	if (!m_impl) {
@@ -91,7 +324,8 @@ void PlaybackProgramExecutor::connect()
 	if (fpga_ip_list.size() == 1) {
 		connect_hardware(fpga_ip_list.front());
 	} else if (fpga_ip_list.size() > 1) {
-		throw std::runtime_error("Found more than one FPGA IP in environment to connect to.");
+		throw std::runtime_error(
+		    "Found more than one FPGA IP in environment to connect to, use ExecutorPool.");
 	} else if (env_sim_port != nullptr) {
 		connect_simulator(env_sim_host, static_cast<uint16_t>(atoi(env_sim_port)));
 	} else {
@@ -108,30 +342,55 @@ void PlaybackProgramExecutor::disconnect()
 	if (!m_impl->m_fisch_executor) {
 		throw std::logic_error("Trying to disconnect an executor without connection to a backend.");
 	}
+	m_impl->stop_submission();
+	std::lock_guard<std::mutex> lock(m_impl->m_run_mutex);
 	m_impl->m_fisch_executor.reset(nullptr);
 }
 
+std::optional<ExecutorBackend> PlaybackProgramExecutor::get_backend() const
+{
+	if (!m_impl) {
+		throw std::logic_error("Unexpected access to moved-from object.");
+	}
+
+	if (!m_impl->m_fisch_executor) {
+		return std::nullopt;
+	}
+	if (std::holds_alternative<fisch::vx::PlaybackProgramARQExecutor>(
+	        *(m_impl->m_fisch_executor))) {
+		return ExecutorBackend::hardware;
+	} else if (std::holds_alternative<fisch::vx::PlaybackProgramSimExecutor>(
+	               *(m_impl->m_fisch_executor))) {
+		return ExecutorBackend::simulation;
+	}
+	return ExecutorBackend::mock;
+}
+
 PlaybackProgramExecutor::~PlaybackProgramExecutor() = default;
 
 void PlaybackProgramExecutor::run(PlaybackProgram& program)
 {
-	if (program.get_executable_restriction()) {
-		if (((*(program.get_executable_restriction()) == ExecutorBackend::simulation) &&
-		     std::holds_alternative<fisch::vx::PlaybackProgramARQExecutor>(
-		         *(m_impl->m_fisch_executor))) ||
-		    ((*(program.get_executable_restriction()) == ExecutorBackend::hardware) &&
-		     std::holds_alternative<fisch::vx::PlaybackProgramSimExecutor>(
-		         *(m_impl->m_fisch_executor)))) {
-			throw std::runtime_error(
-			    "Trying to execute program with non-matching executable restriction.");
-		}
+	if (!m_impl) {
+		throw std::logic_error("Unexpected access to moved-from object.");
 	}
-	run(program.m_program_impl);
+
+	if (!m_impl->m_fisch_executor) {
+		throw std::logic_error(
+		    "Trying to call run on an executor without open connection to backend.");
+	}
+
+	check_executable_restriction(program);
+	m_impl->run(program);
 }
 
 void PlaybackProgramExecutor::run(PlaybackProgram&& program)
 {
-	run(program.m_program_impl);
+	if (!m_impl) {
+		throw std::logic_error("Unexpected access to moved-from object.");
+	}
+
+	// the executable restriction is not checked for temporary programs
+	m_impl->run(program);
 }
 
 void PlaybackProgramExecutor::run(std::shared_ptr<fisch::vx::PlaybackProgram> const& program)
@@ -140,14 +399,123 @@ void PlaybackProgramExecutor::run(std::shared_ptr<fisch::vx::PlaybackProgram> co
 		throw std::logic_error("Unexpected access to moved-from object.");
 	}
 
+	m_impl->run(program);
+}
+
+std::future<PlaybackProgram> PlaybackProgramExecutor::run_async(PlaybackProgram const& program)
+{
+	if (!m_impl) {
+		throw std::logic_error("Unexpected access to moved-from object.");
+	}
+
 	if (!m_impl->m_fisch_executor) {
 		throw std::logic_error(
-		    "Trying to call run on an executor without open connection to backend.");
+		    "Trying to call run_async on an executor without open connection to backend.");
+	}
+
+	check_executable_restriction(program);
+
+	Impl::Submission submission{program, {}};
+	auto future = submission.promise.get_future();
+	m_impl->submit(std::move(submission));
+	return future;
+}
+
+void PlaybackProgramExecutor::set_max_programs_in_flight(size_t const value)
+{
+	if (!m_impl) {
+		throw std::logic_error("Unexpected access to moved-from object.");
+	}
+
+	if (value == 0) {
+		throw std::invalid_argument("Maximal number of programs in flight has to be non-zero.");
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_impl->m_submission_mutex);
+		m_impl->m_max_programs_in_flight = value;
+	}
+	m_impl->m_submission_changed.notify_all();
+}
+
+size_t PlaybackProgramExecutor::get_max_programs_in_flight() const
+{
+	if (!m_impl) {
+		throw std::logic_error("Unexpected access to moved-from object.");
+	}
+
+	std::lock_guard<std::mutex> lock(m_impl->m_submission_mutex);
+	return m_impl->m_max_programs_in_flight;
+}
+
+void PlaybackProgramExecutor::wait_all()
+{
+	if (!m_impl) {
+		throw std::logic_error("Unexpected access to moved-from object.");
 	}
 
-	std::visit(
-	    [&program](auto& fisch_executor) { fisch_executor.run(program); },
-	    *(m_impl->m_fisch_executor));
+	m_impl->wait_all();
+}
+
+typename PlaybackProgramExecutor::Timings PlaybackProgramExecutor::get_timings() const
+{
+	if (!m_impl) {
+		throw std::logic_error("Unexpected access to moved-from object.");
+	}
+
+	std::lock_guard<std::mutex> lock(m_impl->m_run_mutex);
+	return m_impl->m_timings;
+}
+
+void PlaybackProgramExecutor::reset_timings()
+{
+	if (!m_impl) {
+		throw std::logic_error("Unexpected access to moved-from object.");
+	}
+
+	std::lock_guard<std::mutex> lock(m_impl->m_run_mutex);
+	m_impl->m_timings = Timings();
+}
+
+void PlaybackProgramExecutor::set_result_stream(std::shared_ptr<ResultStream> const& stream)
+{
+	if (!m_impl) {
+		throw std::logic_error("Unexpected access to moved-from object.");
+	}
+
+	std::lock_guard<std::mutex> run_lock(m_impl->m_run_mutex);
+	std::lock_guard<std::mutex> push_lock(m_impl->m_push_mutex);
+	if (stream == m_impl->m_result_stream) {
+		return;
+	}
+	if (stream) {
+		stream->attach_producer();
+	}
+	if (m_impl->m_result_stream) {
+		m_impl->m_result_stream->detach_producer();
+	}
+	m_impl->m_result_stream = stream;
+}
+
+std::shared_ptr<ResultStream> PlaybackProgramExecutor::get_result_stream() const
+{
+	if (!m_impl) {
+		throw std::logic_error("Unexpected access to moved-from object.");
+	}
+
+	std::lock_guard<std::mutex> lock(m_impl->m_run_mutex);
+	return m_impl->m_result_stream;
+}
+
+void PlaybackProgramExecutor::check_executable_restriction(PlaybackProgram const& program) const
+{
+	auto const restriction = program.get_executable_restriction();
+	auto const backend = get_backend();
+	// the mock backend is able to execute all programs
+	if (restriction && (backend != ExecutorBackend::mock) && (restriction != backend)) {
+		throw std::runtime_error(
+		    "Trying to execute program with non-matching executable restriction.");
+	}
 }
 
 } // namespace stadls::vx
@@ -0,0 +1,86 @@
+#include "stadls/vx/result_columns.h"
+
+#include <stdexcept>
+
+namespace stadls::vx {
+
+SpikeColumns::SpikeColumns() : m_storage(std::make_shared<Storage const>()) {}
+
+SpikeColumns::SpikeColumns(std::shared_ptr<Storage const> const& storage) : m_storage(storage)
+{
+	if (!m_storage) {
+		throw std::logic_error("SpikeColumns requires column storage.");
+	}
+	if ((m_storage->fpga_times.size() != m_storage->labels.size()) ||
+	    (m_storage->chip_times.size() != m_storage->labels.size())) {
+		throw std::logic_error("Spike column sizes do not match.");
+	}
+}
+
+size_t SpikeColumns::size() const
+{
+	return m_storage->labels.size();
+}
+
+bool SpikeColumns::empty() const
+{
+	return m_storage->labels.empty();
+}
+
+std::vector<typename SpikeColumns::label_type> const& SpikeColumns::get_labels() const
+{
+	return m_storage->labels;
+}
+
+std::vector<typename SpikeColumns::time_type> const& SpikeColumns::get_fpga_times() const
+{
+	return m_storage->fpga_times;
+}
+
+std::vector<typename SpikeColumns::time_type> const& SpikeColumns::get_chip_times() const
+{
+	return m_storage->chip_times;
+}
+
+MADCSampleColumns::MADCSampleColumns() : m_storage(std::make_shared<Storage const>()) {}
+
+MADCSampleColumns::MADCSampleColumns(std::shared_ptr<Storage const> const& storage) :
+    m_storage(storage)
+{
+	if (!m_storage) {
+		throw std::logic_error("MADCSampleColumns requires column storage.");
+	}
+	if ((m_storage->fpga_times.size() != m_storage->values.size()) ||
+	    (m_storage->chip_times.size() != m_storage->values.size())) {
+		throw std::logic_error("MADC sample column sizes do not match.");
+	}
+}
+
+size_t MADCSampleColumns::size() const
+{
+	return m_storage->values.size();
+}
+
+bool MADCSampleColumns::empty() const
+{
+	return m_storage->values.empty();
+}
+
+std::vector<typename MADCSampleColumns::value_type> const& MADCSampleColumns::get_values() const
+{
+	return m_storage->values;
+}
+
+std::vector<typename MADCSampleColumns::time_type> const& MADCSampleColumns::get_fpga_times()
+    const
+{
+	return m_storage->fpga_times;
+}
+
+std::vector<typename MADCSampleColumns::time_type> const& MADCSampleColumns::get_chip_times()
+    const
+{
+	return m_storage->chip_times;
+}
+
+} // namespace stadls::vx
@@ -0,0 +1,219 @@
+#include "stadls/vx/result_stream.h"
+
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+namespace stadls::vx {
+
+namespace {
+
+/**
+ * Back-off while waiting for the other side of the ring, first yielding, then sleeping to not
+ * occupy a core during long waits.
+ */
+class Backoff
+{
+public:
+	Backoff() : m_count(0) {}
+
+	void operator()()
+	{
+		if (m_count < spin_count) {
+			m_count++;
+			std::this_thread::yield();
+		} else {
+			std::this_thread::sleep_for(std::chrono::microseconds(100));
+		}
+	}
+
+private:
+	static constexpr size_t spin_count = 1000;
+	size_t m_count;
+};
+
+} // namespace
+
+ResultStream::ResultStream(
+    size_t const capacity, size_t const chunk_size, OverflowPolicy const overflow_policy) :
+    m_chunk_size(chunk_size),
+    m_overflow_policy(overflow_policy),
+    m_slots(),
+    m_head(0),
+    m_tail(0),
+    m_closed(false),
+    m_has_producer(false),
+    m_pushed_chunks(0),
+    m_popped_chunks(0),
+    m_dropped_chunks(0),
+    m_blocked_pushes(0),
+    m_max_fill(0),
+    m_spikes(0),
+    m_madc_samples(0)
+{
+	if (capacity == 0) {
+		throw std::invalid_argument("ResultStream capacity has to be larger than zero.");
+	}
+	if (chunk_size == 0) {
+		throw std::invalid_argument("ResultStream chunk size has to be larger than zero.");
+	}
+	m_slots.resize(capacity + 1);
+}
+
+size_t ResultStream::get_capacity() const
+{
+	return m_slots.size() - 1;
+}
+
+size_t ResultStream::get_chunk_size() const
+{
+	return m_chunk_size;
+}
+
+typename ResultStream::OverflowPolicy ResultStream::get_overflow_policy() const
+{
+	return m_overflow_policy;
+}
+
+bool ResultStream::push(Chunk&& chunk)
+{
+	size_t const tail = m_tail.load(std::memory_order_relaxed);
+	size_t const next = (tail + 1) % m_slots.size();
+
+	if (next == m_head.load(std::memory_order_acquire)) {
+		if (m_overflow_policy == OverflowPolicy::drop) {
+			m_dropped_chunks++;
+			return false;
+		}
+		m_blocked_pushes++;
+		Backoff backoff;
+		while ((next == m_head.load(std::memory_order_acquire)) && !m_closed) {
+			backoff();
+		}
+	}
+	if (m_closed) {
+		m_dropped_chunks++;
+		return false;
+	}
+
+	size_t const num_spikes = chunk.spikes.size();
+	size_t const num_madc_samples = chunk.madc_samples.size();
+	m_slots[tail] = std::move(chunk);
+	m_tail.store(next, std::memory_order_release);
+
+	m_pushed_chunks++;
+	m_spikes += num_spikes;
+	m_madc_samples += num_madc_samples;
+	size_t const fill = size();
+	size_t max_fill = m_max_fill;
+	while ((fill > max_fill) && !m_max_fill.compare_exchange_weak(max_fill, fill)) {
+	}
+	return true;
+}
+
+void ResultStream::push(SpikeView const& spikes, madc_samples_type const& madc_samples)
+{
+	push_chunked(spikes, madc_samples);
+}
+
+void ResultStream::push(
+    fisch::vx::PlaybackProgram::spikes_type const& spikes, madc_samples_type const& madc_samples)
+{
+	push_chunked(spikes, madc_samples);
+}
+
+template <typename Spikes>
+void ResultStream::push_chunked(Spikes const& spikes, madc_samples_type const& madc_samples)
+{
+	size_t spike_offset = 0;
+	size_t madc_sample_offset = 0;
+	while ((spike_offset < spikes.size()) || (madc_sample_offset < madc_samples.size())) {
+		size_t const num_spikes = std::min(m_chunk_size, spikes.size() - spike_offset);
+		size_t const num_madc_samples =
+		    std::min(m_chunk_size, madc_samples.size() - madc_sample_offset);
+
+		Chunk chunk;
+		chunk.spikes.assign(
+		    spikes.begin() + spike_offset, spikes.begin() + spike_offset + num_spikes);
+		chunk.madc_samples.assign(
+		    madc_samples.begin() + madc_sample_offset,
+		    madc_samples.begin() + madc_sample_offset + num_madc_samples);
+		push(std::move(chunk));
+
+		spike_offset += num_spikes;
+		madc_sample_offset += num_madc_samples;
+	}
+}
+
+std::optional<typename ResultStream::Chunk> ResultStream::try_pop()
+{
+	size_t const head = m_head.load(std::memory_order_relaxed);
+	if (head == m_tail.load(std::memory_order_acquire)) {
+		return std::nullopt;
+	}
+	std::optional<Chunk> chunk(std::move(m_slots[head]));
+	// release slot memory on consumer side
+	m_slots[head] = Chunk();
+	m_head.store((head + 1) % m_slots.size(), std::memory_order_release);
+	m_popped_chunks++;
+	return chunk;
+}
+
+std::optional<typename ResultStream::Chunk> ResultStream::pop()
+{
+	Backoff backoff;
+	while (true) {
+		// check closed before popping to not miss chunks pushed before close
+		bool const closed = m_closed;
+		auto chunk = try_pop();
+		if (chunk || closed) {
+			return chunk;
+		}
+		backoff();
+	}
+}
+
+void ResultStream::close()
+{
+	m_closed = true;
+}
+
+bool ResultStream::get_closed() const
+{
+	return m_closed;
+}
+
+size_t ResultStream::size() const
+{
+	size_t const head = m_head.load(std::memory_order_acquire);
+	size_t const tail = m_tail.load(std::memory_order_acquire);
+	return (tail + m_slots.size() - head) % m_slots.size();
+}
+
+typename ResultStream::Statistics ResultStream::get_statistics() const
+{
+	Statistics statistics;
+	statistics.pushed_chunks = m_pushed_chunks;
+	statistics.popped_chunks = m_popped_chunks;
+	statistics.dropped_chunks = m_dropped_chunks;
+	statistics.blocked_pushes = m_blocked_pushes;
+	statistics.max_fill = m_max_fill;
+	statistics.spikes = m_spikes;
+	statistics.madc_samples = m_madc_samples;
+	return statistics;
+}
+
+void ResultStream::attach_producer()
+{
+	if (m_has_producer.exchange(true)) {
+		throw std::logic_error("Trying to attach ResultStream already having a producer.");
+	}
+}
+
+void ResultStream::detach_producer()
+{
+	m_has_producer = false;
+}
+
+} // namespace stadls::vx
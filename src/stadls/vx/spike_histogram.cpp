@@ -0,0 +1,109 @@
+#include "stadls/vx/spike_histogram.h"
+
+#include <stdexcept>
+
+namespace stadls::vx {
+
+SpikeHistogram::SpikeHistogram(labels_type const& labels, bin_edges_type const& bin_edges) :
+    m_labels(labels),
+    m_bin_edges(bin_edges),
+    m_edge_values(),
+    m_bin_width(0),
+    m_rows(static_cast<size_t>(std::numeric_limits<haldls::vx::SpikeLabel::value_type>::max()) + 1,
+           untracked_row),
+    m_counts(),
+    m_num_ignored(0),
+    m_mutex()
+{
+	if (m_labels.empty()) {
+		throw std::invalid_argument("SpikeHistogram requires at least one label.");
+	}
+	if (m_bin_edges.size() < 2) {
+		throw std::invalid_argument("SpikeHistogram requires at least two bin edges.");
+	}
+
+	for (size_t row = 0; row < m_labels.size(); ++row) {
+		auto& label_row = m_rows.at(m_labels[row].value());
+		if (label_row != untracked_row) {
+			throw std::invalid_argument("SpikeHistogram labels are not unique.");
+		}
+		label_row = static_cast<row_type>(row);
+	}
+
+	m_edge_values.reserve(m_bin_edges.size());
+	for (auto const& edge : m_bin_edges) {
+		if (!m_edge_values.empty() && (edge.value() <= m_edge_values.back())) {
+			throw std::invalid_argument("SpikeHistogram bin edges are not strictly increasing.");
+		}
+		m_edge_values.push_back(edge.value());
+	}
+
+	// equidistant bins allow computing the bin instead of searching it
+	auto const width = m_edge_values.at(1) - m_edge_values.at(0);
+	bool equidistant = true;
+	for (size_t i = 1; i < m_edge_values.size(); ++i) {
+		equidistant = equidistant && ((m_edge_values[i] - m_edge_values[i - 1]) == width);
+	}
+	if (equidistant) {
+		m_bin_width = width;
+	}
+
+	m_counts.resize(get_num_labels() * get_num_bins(), 0);
+}
+
+typename SpikeHistogram::labels_type const& SpikeHistogram::get_labels() const
+{
+	return m_labels;
+}
+
+typename SpikeHistogram::bin_edges_type const& SpikeHistogram::get_bin_edges() const
+{
+	return m_bin_edges;
+}
+
+size_t SpikeHistogram::get_num_labels() const
+{
+	return m_labels.size();
+}
+
+size_t SpikeHistogram::get_num_bins() const
+{
+	return m_bin_edges.size() - 1;
+}
+
+void SpikeHistogram::add(haldls::vx::SpikeLabel const& label, haldls::vx::FPGATime const& time)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	add_unlocked(label.value(), time.value());
+}
+
+typename SpikeHistogram::count_type SpikeHistogram::get_count(
+    size_t const label_index, size_t const bin) const
+{
+	if ((label_index >= get_num_labels()) || (bin >= get_num_bins())) {
+		throw std::out_of_range("SpikeHistogram label index or bin out of range.");
+	}
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_counts[label_index * get_num_bins() + bin];
+}
+
+std::vector<typename SpikeHistogram::count_type> SpikeHistogram::get_counts() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_counts;
+}
+
+size_t SpikeHistogram::get_num_ignored() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_num_ignored;
+}
+
+void SpikeHistogram::reset()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	std::fill(m_counts.begin(), m_counts.end(), 0);
+	m_num_ignored = 0;
+}
+
+} // namespace stadls::vx
@@ -0,0 +1,171 @@
+#include "stadls/vx/spike_train_file.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+namespace stadls::vx {
+
+namespace {
+
+/** Identifier at the beginning of files written by SpikeTrainFile::save(). */
+constexpr char spike_train_file_magic[16] = "STADLSVXSPIKES";
+
+/** Format version of files written by SpikeTrainFile::save(). */
+constexpr uint32_t spike_train_file_version = 1;
+
+/**
+ * Header of spike train files, followed by the records.
+ */
+struct SpikeTrainFileHeader
+{
+	char magic[16];
+	uint32_t version;
+	uint32_t reserved;
+	uint64_t num_records;
+};
+
+static_assert(sizeof(SpikeTrainFileHeader) == 32, "Header layout is part of the file format.");
+
+} // namespace
+
+SpikeTrainFile::SpikeTrainFile(std::string const& filename) :
+    m_mapping(filename), m_records(nullptr), m_num_records(0), m_num_spikes(0), m_builder()
+{
+	SpikeTrainFileHeader header;
+	if ((m_mapping.size() < sizeof(header)) ||
+	    (std::memcmp(
+	         m_mapping.data(), spike_train_file_magic, sizeof(spike_train_file_magic)) != 0)) {
+		throw std::runtime_error(filename + " does not contain a saved SpikeTrainFile.");
+	}
+	std::memcpy(&header, m_mapping.data(), sizeof(header));
+	if (header.version != spike_train_file_version) {
+		throw std::runtime_error(
+		    filename + " contains unsupported SpikeTrainFile format version " +
+		    std::to_string(header.version) + ".");
+	}
+	size_t const records_size = m_mapping.size() - sizeof(header);
+	if ((records_size % sizeof(Record) != 0) ||
+	    (records_size / sizeof(Record) != header.num_records)) {
+		throw std::runtime_error(filename + " is truncated or has trailing data.");
+	}
+
+	// the mapping is page-aligned and the header size a multiple of the record alignment
+	m_records = reinterpret_cast<Record const*>(m_mapping.data() + sizeof(header));
+	m_num_records = header.num_records;
+
+	using namespace haldls::vx;
+	for (auto record = begin(); record != end(); ++record) {
+		if ((record->num_labels == 0) || (record->num_labels > 3)) {
+			throw std::runtime_error(filename + " contains spike pack of invalid size.");
+		}
+		if (record->time > Timer::Value::max) {
+			throw std::runtime_error(filename + " contains time exceeding range of timer value.");
+		}
+		if ((record != begin()) && (record->time < (record - 1)->time)) {
+			throw std::runtime_error(filename + " contains unsorted spike times.");
+		}
+
+		if ((record == begin()) || (record->time != (record - 1)->time)) {
+			m_builder.wait_until(Timer::coordinate_type(), Timer::Value(record->time));
+		}
+		if (record->num_labels == 3) {
+			m_builder.write(
+			    SpikePack3ToChip::coordinate_type(),
+			    SpikePack3ToChip(SpikePack3ToChip::labels_type{
+			        SpikeLabel(record->labels[0]), SpikeLabel(record->labels[1]),
+			        SpikeLabel(record->labels[2])}));
+		} else if (record->num_labels == 2) {
+			m_builder.write(
+			    SpikePack2ToChip::coordinate_type(),
+			    SpikePack2ToChip(SpikePack2ToChip::labels_type{
+			        SpikeLabel(record->labels[0]), SpikeLabel(record->labels[1])}));
+		} else {
+			m_builder.write(
+			    SpikePack1ToChip::coordinate_type(),
+			    SpikePack1ToChip(SpikePack1ToChip::labels_type{SpikeLabel(record->labels[0])}));
+		}
+		m_num_spikes += record->num_labels;
+	}
+}
+
+void SpikeTrainFile::save(
+    std::string const& filename, times_type const& times, labels_type const& labels)
+{
+	if (times.size() != labels.size()) {
+		throw std::runtime_error("Number of spike times and labels do not match.");
+	}
+	for (size_t i = 1; i < times.size(); ++i) {
+		if (times[i] < times[i - 1]) {
+			throw std::runtime_error("Spike times are not sorted.");
+		}
+	}
+
+	// same packing as PlaybackProgramBuilder::write_spike_train()
+	std::vector<Record> records;
+	size_t begin = 0;
+	while (begin < times.size()) {
+		size_t end = begin + 1;
+		while ((end < times.size()) && (times[end] == times[begin])) {
+			++end;
+		}
+		while (begin < end) {
+			Record record{};
+			record.time = times[begin].value();
+			record.num_labels = static_cast<uint16_t>(std::min(end - begin, size_t(3)));
+			for (size_t i = 0; i < record.num_labels; ++i) {
+				record.labels[i] = labels[begin + i].value();
+			}
+			records.push_back(record);
+			begin += record.num_labels;
+		}
+	}
+
+	SpikeTrainFileHeader header{};
+	std::memcpy(header.magic, spike_train_file_magic, sizeof(spike_train_file_magic));
+	header.version = spike_train_file_version;
+	header.num_records = records.size();
+
+	std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+	if (!file) {
+		throw std::runtime_error("Failed to open " + filename + " for writing.");
+	}
+	file.write(reinterpret_cast<char const*>(&header), sizeof(header));
+	file.write(
+	    reinterpret_cast<char const*>(records.data()), records.size() * sizeof(Record));
+	if (!file) {
+		throw std::runtime_error("Failed to write " + filename + ".");
+	}
+}
+
+size_t SpikeTrainFile::get_num_spikes() const
+{
+	return m_num_spikes;
+}
+
+size_t SpikeTrainFile::get_num_packs() const
+{
+	return m_num_records;
+}
+
+haldls::vx::Timer::Value SpikeTrainFile::get_end_time() const
+{
+	if (m_num_records == 0) {
+		return haldls::vx::Timer::Value();
+	}
+	return haldls::vx::Timer::Value(m_records[m_num_records - 1].time);
+}
+
+typename SpikeTrainFile::Record const* SpikeTrainFile::begin() const
+{
+	return m_records;
+}
+
+typename SpikeTrainFile::Record const* SpikeTrainFile::end() const
+{
+	return m_records + m_num_records;
+}
+
+} // namespace stadls::vx
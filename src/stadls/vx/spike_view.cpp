@@ -0,0 +1,57 @@
+#include "stadls/vx/spike_view.h"
+
+#include <stdexcept>
+#include <string>
+
+namespace stadls::vx {
+
+SpikeView::SpikeView() : m_storage(std::make_shared<storage_type const>()) {}
+
+SpikeView::SpikeView(std::shared_ptr<storage_type const> const& storage) : m_storage(storage)
+{
+	if (!m_storage) {
+		throw std::logic_error("SpikeView requires spike storage.");
+	}
+}
+
+size_t SpikeView::size() const
+{
+	return m_storage->size();
+}
+
+bool SpikeView::empty() const
+{
+	return m_storage->empty();
+}
+
+typename SpikeView::value_type const* SpikeView::data() const
+{
+	return m_storage->data();
+}
+
+typename SpikeView::const_iterator SpikeView::begin() const
+{
+	return data();
+}
+
+typename SpikeView::const_iterator SpikeView::end() const
+{
+	return data() + size();
+}
+
+typename SpikeView::value_type const& SpikeView::operator[](size_t const index) const
+{
+	return (*m_storage)[index];
+}
+
+typename SpikeView::value_type const& SpikeView::at(size_t const index) const
+{
+	if (index >= size()) {
+		throw std::out_of_range(
+		    "Spike index " + std::to_string(index) + " out of range for view of size " +
+		    std::to_string(size()) + ".");
+	}
+	return (*m_storage)[index];
+}
+
+} // namespace stadls::vx
@@ -21,7 +21,7 @@ pthread_t setup_signal_handler_thread()
 
 	// set dummy function that ignores all signals to avoid crashing if a
 	// signal is received in the short amount of time until the
-	// QuickQueueServer is running
+	// QuickQueueBatchServer is running
 	quiggeldy::signal_handler = [](int sig) {
 		auto log = log4cxx::Logger::getLogger(__func__);
 		if (log->isEnabledFor(log4cxx::Level::getDebug())) {
@@ -95,6 +95,7 @@ int main(int argc, const char* argv[])
 	size_t num_threads_input;
 	size_t num_threads_output;
 	bool mock_mode;
+	bool reuse_static_config;
 
 	po::options_description desc("Allowed options");
 	desc.add_options()("help,h", "produce help message")(
@@ -113,7 +114,10 @@ int main(int argc, const char* argv[])
 		"num-threads-outputs,m", po::value<size_t>(&num_threads_output)->default_value(8),
 		"Number of threads handling distribution of results.")(
 		"mock-mode", po::bool_switch(&mock_mode)->default_value(false),
-		"Operate in mock-mode, i.e., accept connections but return empty results.");
+		"Operate in mock-mode, i.e., accept connections but return empty results.")(
+		"reuse-static-config", po::bool_switch(&reuse_static_config)->default_value(false),
+		"Skip loading the static configuration if it equals the one loaded by the previous "
+		"experiment. Only valid if experiments do not alter the static configuration.");
 
 	// populate vm variable
 	po::variables_map vm;
@@ -130,10 +134,10 @@ int main(int argc, const char* argv[])
 
 	LOG4CXX_INFO(log, "Starting up..");
 
-	// has to be called prior to QuickQueueServer
+	// has to be called prior to QuickQueueBatchServer
 	auto sig_thread = quiggeldy::setup_signal_handler_thread();
 
-	std::unique_ptr<stadls::v2::QuickQueueServer> server;
+	std::unique_ptr<stadls::v2::QuickQueueBatchServer> server;
 
 	{
 		auto worker = stadls::v2::QuickQueueWorker(usb_serial);
@@ -141,7 +145,11 @@ int main(int argc, const char* argv[])
 			LOG4CXX_INFO(log, "Setting mock-mode.");
 		}
 		worker.set_mock_mode(mock_mode);
-		server.reset(new stadls::v2::QuickQueueServer(
+		if (reuse_static_config) {
+			LOG4CXX_INFO(log, "Reusing unchanged static configuration.");
+		}
+		worker.set_reuse_static_config(reuse_static_config);
+		server.reset(new stadls::v2::QuickQueueBatchServer(
 			RCF::TcpEndpoint(ip, port), std::move(worker), num_threads_input, num_threads_output));
 	}
 
@@ -0,0 +1,45 @@
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "fisch/vx/omnibus.h"
+#include "lola/vx/synapse.h"
+
+#include "benchmark-helper.h"
+#include "synapse_matrix-helper.h"
+
+using namespace lola::vx;
+
+namespace {
+
+constexpr size_t repetitions = 10;
+
+template <typename F>
+double matrices_per_second(F&& f)
+{
+	double const duration = measure_duration([&]() {
+		for (size_t i = 0; i < repetitions; ++i) {
+			f();
+		}
+	});
+	return static_cast<double>(repetitions) / duration;
+}
+
+} // namespace
+
+TEST(SynapseMatrix, EncodeDecodeThroughput)
+{
+	SynapseMatrix config;
+
+	auto const per_quad_encode = matrices_per_second([&]() { encode_per_quad(config); });
+
+	std::vector<fisch::vx::OmnibusChip> words;
+	auto const bulk_encode =
+	    matrices_per_second([&]() { words = config.encode<fisch::vx::OmnibusChip>(); });
+
+	auto const bulk_decode = matrices_per_second([&]() { config.decode(words.data()); });
+
+	RecordProperty("per_quad_encode_matrices_per_second", std::to_string(per_quad_encode));
+	RecordProperty("bulk_encode_matrices_per_second", std::to_string(bulk_encode));
+	RecordProperty("bulk_decode_matrices_per_second", std::to_string(bulk_decode));
+}
@@ -0,0 +1,185 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <SF/IBinaryStream.hpp>
+#include <SF/OBinaryStream.hpp>
+#include <SF/string.hpp>
+#include <SF/vector.hpp>
+#include <cereal/archives/binary.hpp>
+
+#include "stadls/v2/quick_queue.h"
+#include "stadls/v2/wire_format.h"
+
+#include "benchmark-helper.h"
+
+using namespace stadls::v2;
+
+namespace {
+
+constexpr size_t repetitions = 10;
+constexpr size_t program_size = 16 * 1024 * 1024;
+
+/**
+ * Synthetic program bytes resembling playback instructions: 32-bit words of few distinct opcodes
+ * with slowly varying payload, split into blocks of the SDRAM allocation granularity.
+ */
+FlatProgramBytes synthetic_program()
+{
+	FlatProgramBytes::blocks_type blocks(program_size / (1024 * 1024));
+	for (size_t block = 0; block < blocks.size(); ++block) {
+		for (uint32_t word = 0; word < (1024 * 1024) / 4; ++word) {
+			uint32_t const value = ((word % 3) << 28) | ((word / 16) & 0xfff);
+			for (size_t byte = 0; byte < 4; ++byte) {
+				blocks.at(block).push_back((value >> (8 * (3 - byte))) & 0xff);
+			}
+		}
+	}
+	return FlatProgramBytes(blocks);
+}
+
+/**
+ * Synthetic result bytes resembling recorded spikes: 64-bit events of increasing time and few
+ * distinct addresses.
+ */
+std::vector<haldls::v2::instruction_word_type> synthetic_result()
+{
+	std::vector<haldls::v2::instruction_word_type> result;
+	result.reserve(program_size);
+	for (uint64_t event = 0; event < program_size / 8; ++event) {
+		uint64_t const value = ((event % 32) << 56) | (event * 17);
+		for (size_t byte = 0; byte < 8; ++byte) {
+			result.push_back((value >> (8 * (7 - byte))) & 0xff);
+		}
+	}
+	return result;
+}
+
+double throughput_mib_per_s(size_t const bytes, double const duration)
+{
+	return static_cast<double>(bytes * repetitions) / (1024. * 1024.) / duration;
+}
+
+/**
+ * Binary streams of SF as used by the remote calls to quiggeldy.
+ */
+struct SFArchives
+{
+	template <typename T>
+	static void save(std::ostream& stream, T& object)
+	{
+		SF::OBinaryStream archive(stream);
+		archive << object;
+	}
+
+	template <typename T>
+	static void load(std::istream& stream, T& object)
+	{
+		SF::IBinaryStream archive(stream);
+		archive >> object;
+	}
+};
+
+/**
+ * Binary archives of cereal.
+ */
+struct CerealArchives
+{
+	template <typename T>
+	static void save(std::ostream& stream, T& object)
+	{
+		cereal::BinaryOutputArchive archive(stream);
+		archive(object);
+	}
+
+	template <typename T>
+	static void load(std::istream& stream, T& object)
+	{
+		cereal::BinaryInputArchive archive(stream);
+		archive(object);
+	}
+};
+
+/**
+ * Transmit program bytes to a worker in mock mode and result bytes back through the archives and
+ * record the throughput of the whole round trip for every supported compression.
+ * The mock worker does not record results, the synthetic result is therefore attached to its
+ * response before serialization.
+ */
+template <typename Archives>
+void record_round_trip(std::string const& archive_name)
+{
+	QuickQueueWorker worker("mock");
+	worker.set_mock_mode(true);
+	worker.setup();
+
+	auto const program = synthetic_program();
+	auto const result = synthetic_result();
+
+	std::vector<WireCompression> compressions{WireCompression::none};
+	if (negotiate_wire_compression(local_wire_capabilities()) == WireCompression::lz4) {
+		compressions.push_back(WireCompression::lz4);
+	}
+
+	for (auto const compression : compressions) {
+		std::string const name =
+		    archive_name + "_" + ((compression == WireCompression::lz4) ? "lz4" : "none");
+
+		QuickQueueBatchRequest batch;
+		batch.requests.resize(1);
+		batch.requests.front().playback_program_bytes = program;
+		batch.requests.front().compression = compression;
+		batch.accepted_compressions = (compression == WireCompression::lz4)
+		                                  ? local_wire_capabilities()
+		                                  : wire_capabilities_type(1);
+
+		double duration = 0.;
+		size_t request_size = 0;
+		size_t response_size = 0;
+		for (size_t i = 0; i < repetitions; ++i) {
+			auto result_bytes = result;
+			QuickQueueBatchResponse received;
+			duration += measure_duration([&]() {
+				std::stringstream request_stream;
+				Archives::save(request_stream, batch);
+				request_size = static_cast<size_t>(request_stream.tellp());
+
+				QuickQueueBatchRequest received_batch;
+				Archives::load(request_stream, received_batch);
+				auto response = worker.work(received_batch);
+				response.responses.front().result_bytes.swap(result_bytes);
+
+				std::stringstream response_stream;
+				Archives::save(response_stream, response);
+				response_size = static_cast<size_t>(response_stream.tellp());
+				Archives::load(response_stream, received);
+			});
+			EXPECT_TRUE(received.error_messages.front().empty());
+			EXPECT_EQ(received.responses.front().result_bytes.size(), result.size());
+		}
+
+		::testing::Test::RecordProperty(
+		    "round_trip_mib_per_s_" + name,
+		    std::to_string(throughput_mib_per_s(program.bytes.size() + result.size(), duration)));
+		::testing::Test::RecordProperty("request_size_" + name, std::to_string(request_size));
+		::testing::Test::RecordProperty("response_size_" + name, std::to_string(response_size));
+	}
+
+	worker.teardown();
+}
+
+} // namespace
+
+TEST(QuickQueueWorker, MockRoundTripThroughputSF)
+{
+	record_round_trip<SFArchives>("sf");
+}
+
+TEST(QuickQueueWorker, MockRoundTripThroughputCereal)
+{
+	record_round_trip<CerealArchives>("cereal");
+}
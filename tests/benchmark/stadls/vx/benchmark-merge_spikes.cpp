@@ -0,0 +1,60 @@
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "haldls/vx/event.h"
+#include "stadls/vx/merge_spikes.h"
+
+#include "benchmark-helper.h"
+
+using namespace haldls::vx;
+using namespace stadls::vx;
+
+TEST(merge_spikes, Benchmark)
+{
+	constexpr size_t num_sequences = 8;
+	constexpr size_t sequence_size = 1 << 19;
+	constexpr uint64_t sequence_duration = 1 << 24;
+
+	std::mt19937 gen(1234);
+	std::uniform_int_distribution<uint64_t> time_distribution(0, sequence_duration);
+	std::vector<SpikeView> spikes;
+	std::vector<FPGATime> offsets;
+	for (size_t i = 0; i < num_sequences; ++i) {
+		std::vector<uint64_t> times(sequence_size);
+		std::generate(times.begin(), times.end(), [&]() { return time_distribution(gen); });
+		std::sort(times.begin(), times.end());
+		auto storage = std::make_shared<SpikeView::storage_type>();
+		storage->reserve(sequence_size);
+		for (auto const time : times) {
+			storage->push_back(SpikeFromChip(SpikeLabel(i), FPGATime(time), ChipTime(time)));
+		}
+		spikes.push_back(SpikeView(storage));
+		// overlapping chunks
+		offsets.push_back(FPGATime(i * sequence_duration / 2));
+	}
+
+	auto const naive = measure_duration([&]() {
+		std::vector<SpikeFromChip> concatenated;
+		concatenated.reserve(num_sequences * sequence_size);
+		for (size_t i = 0; i < num_sequences; ++i) {
+			for (auto spike : spikes[i]) {
+				spike.set_fpga_time(FPGATime(spike.get_fpga_time().value() + offsets[i].value()));
+				concatenated.push_back(spike);
+			}
+		}
+		std::stable_sort(
+		    concatenated.begin(), concatenated.end(), [](auto const& a, auto const& b) {
+			    return a.get_fpga_time() < b.get_fpga_time();
+		    });
+	});
+
+	auto const heap = measure_duration([&]() { merge_spikes(spikes, offsets, 1); });
+	auto const heap_parallel = measure_duration([&]() { merge_spikes(spikes, offsets); });
+
+	RecordProperty("concatenate_sort_duration", std::to_string(naive));
+	RecordProperty("heap_merge_duration", std::to_string(heap));
+	RecordProperty("parallel_heap_merge_duration", std::to_string(heap_parallel));
+}
@@ -0,0 +1,145 @@
+#include <string>
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "fisch/vx/playback_program_builder.h"
+#include "halco/common/iter_all.h"
+#include "haldls/vx/capmem.h"
+#include "haldls/vx/neuron.h"
+#include "haldls/vx/pll.h"
+#include "lola/vx/synapse.h"
+#include "stadls/visitors.h"
+#include "stadls/vx/encode_cache.h"
+#include "stadls/vx/playback_program_builder.h"
+
+#include "benchmark-helper.h"
+
+using namespace stadls::vx;
+using namespace haldls::vx;
+using namespace halco::common;
+using namespace halco::hicann_dls::vx;
+
+namespace {
+
+/**
+ * Encode and write a container the way the builder did prior to reusing encode buffers, i.e. with
+ * freshly allocated address and word vectors per write.
+ */
+template <typename T>
+void write_allocating(
+    fisch::vx::PlaybackProgramBuilder& builder,
+    typename T::coordinate_type const& coord,
+    T const& config)
+{
+	typedef typename haldls::vx::detail::BackendContainerTrait<T>::default_container word_type;
+	typedef std::vector<typename word_type::coordinate_type> addresses_type;
+	typedef std::vector<word_type> words_type;
+
+	addresses_type addresses;
+	visit_preorder(config, coord, stadls::WriteAddressVisitor<addresses_type>{addresses});
+	words_type words;
+	visit_preorder(config, coord, stadls::EncodeVisitor<words_type>{words});
+	builder.write(addresses, words);
+}
+
+template <typename F>
+double containers_per_second(size_t const num_containers, F&& f)
+{
+	return static_cast<double>(num_containers) / measure_duration(std::forward<F>(f));
+}
+
+constexpr size_t repetitions = 10;
+
+} // namespace
+
+TEST(PlaybackProgramBuilder, WriteThroughputNeuronConfig)
+{
+	NeuronConfig const config;
+	size_t const num_containers = repetitions * NeuronConfigOnDLS::size;
+
+	auto const allocating = containers_per_second(num_containers, [&]() {
+		fisch::vx::PlaybackProgramBuilder builder;
+		for (size_t i = 0; i < repetitions; ++i) {
+			for (auto const coord : iter_all<NeuronConfigOnDLS>()) {
+				write_allocating(builder, coord, config);
+			}
+		}
+		EXPECT_FALSE(builder.empty());
+	});
+
+	auto const reusing = containers_per_second(num_containers, [&]() {
+		PlaybackProgramBuilder builder;
+		for (size_t i = 0; i < repetitions; ++i) {
+			for (auto const coord : iter_all<NeuronConfigOnDLS>()) {
+				builder.write(coord, config);
+			}
+		}
+		EXPECT_FALSE(builder.empty());
+	});
+
+	RecordProperty("allocating_containers_per_second", std::to_string(allocating));
+	RecordProperty("reusing_containers_per_second", std::to_string(reusing));
+}
+
+TEST(PlaybackProgramBuilder, WriteThroughputSynapseMatrix)
+{
+	lola::vx::SynapseMatrix const config;
+	size_t const num_containers = repetitions * SynramOnDLS::size;
+
+	auto const allocating = containers_per_second(num_containers, [&]() {
+		fisch::vx::PlaybackProgramBuilder builder;
+		for (size_t i = 0; i < repetitions; ++i) {
+			for (auto const coord : iter_all<SynramOnDLS>()) {
+				write_allocating(builder, coord, config);
+			}
+		}
+		EXPECT_FALSE(builder.empty());
+	});
+
+	auto const reusing = containers_per_second(num_containers, [&]() {
+		PlaybackProgramBuilder builder;
+		for (size_t i = 0; i < repetitions; ++i) {
+			for (auto const coord : iter_all<SynramOnDLS>()) {
+				builder.write(coord, config);
+			}
+		}
+		EXPECT_FALSE(builder.empty());
+	});
+
+	RecordProperty("allocating_containers_per_second", std::to_string(allocating));
+	RecordProperty("reusing_containers_per_second", std::to_string(reusing));
+}
+
+TEST(PlaybackProgramBuilder, WriteThroughputEncodeCache)
+{
+	// small configuration containers written repeatedly, e.g. by the InitGenerator
+	size_t const num_programs = 1000;
+	size_t const num_containers =
+	    num_programs * (ADPLLOnDLS::size + CapMemBlockConfigOnDLS::size);
+
+	auto const build = [&]() {
+		for (size_t i = 0; i < num_programs; ++i) {
+			PlaybackProgramBuilder builder;
+			for (auto const coord : iter_all<ADPLLOnDLS>()) {
+				builder.write(coord, ADPLL());
+			}
+			for (auto const coord : iter_all<CapMemBlockConfigOnDLS>()) {
+				builder.write(coord, CapMemBlockConfig());
+			}
+			EXPECT_FALSE(builder.empty());
+		}
+	};
+
+	EncodeCache::set_enabled(false);
+	auto const uncached = containers_per_second(num_containers, build);
+
+	EncodeCache::clear();
+	EncodeCache::set_enabled(true);
+	auto const cached = containers_per_second(num_containers, build);
+	EncodeCache::set_enabled(false);
+	EncodeCache::clear();
+
+	RecordProperty("uncached_containers_per_second", std::to_string(uncached));
+	RecordProperty("cached_containers_per_second", std::to_string(cached));
+}
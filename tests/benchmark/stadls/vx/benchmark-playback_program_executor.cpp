@@ -0,0 +1,74 @@
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "halco/common/iter_all.h"
+#include "haldls/vx/capmem.h"
+#include "lola/vx/synapse.h"
+#include "stadls/vx/playback_program.h"
+#include "stadls/vx/playback_program_builder.h"
+#include "stadls/vx/playback_program_executor.h"
+
+#include "benchmark-helper.h"
+
+using namespace stadls::vx;
+using namespace haldls::vx;
+using namespace halco::common;
+using namespace halco::hicann_dls::vx;
+
+namespace {
+
+constexpr size_t repetitions = 10;
+
+/**
+ * Build, execute on the mock backend and decode programs reading all locations of a container and
+ * record the duration of each phase.
+ */
+template <typename T>
+void benchmark_mock_roundtrip()
+{
+	PlaybackProgramExecutor executor;
+	executor.connect_mock();
+
+	double build_duration = 0.;
+	double decode_duration = 0.;
+	for (size_t i = 0; i < repetitions; ++i) {
+		PlaybackProgramBuilder builder;
+		std::vector<PlaybackProgram::ContainerTicket<T>> tickets;
+		build_duration += measure_duration([&]() {
+			for (auto const coord : iter_all<typename T::coordinate_type>()) {
+				builder.write(coord, T());
+				tickets.push_back(builder.read(coord));
+			}
+		});
+		auto program = builder.done();
+
+		executor.run(program);
+
+		decode_duration += measure_duration([&]() {
+			for (auto const& ticket : tickets) {
+				ticket.get();
+			}
+		});
+	}
+
+	auto const timings = executor.get_timings();
+	::testing::Test::RecordProperty("build_duration", std::to_string(build_duration));
+	::testing::Test::RecordProperty(
+	    "execution_duration", std::to_string(timings.execution_duration));
+	::testing::Test::RecordProperty(
+	    "mock_response_duration", std::to_string(timings.mock_response_duration));
+	::testing::Test::RecordProperty("get_duration", std::to_string(decode_duration));
+}
+
+} // namespace
+
+TEST(PlaybackProgramExecutor, MockRoundtripCapMemCell)
+{
+	benchmark_mock_roundtrip<CapMemCell>();
+}
+
+TEST(PlaybackProgramExecutor, MockRoundtripSynapseMatrix)
+{
+	benchmark_mock_roundtrip<lola::vx::SynapseMatrix>();
+}
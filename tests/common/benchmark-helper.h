@@ -0,0 +1,18 @@
+#pragma once
+
+#include <chrono>
+
+/**
+ * Measure wall-clock duration of the execution of a callable.
+ * @tparam F Callable type
+ * @param f Callable to execute
+ * @return Duration [s]
+ */
+template <typename F>
+double measure_duration(F&& f)
+{
+	auto const begin = std::chrono::steady_clock::now();
+	f();
+	auto const end = std::chrono::steady_clock::now();
+	return std::chrono::duration<double>(end - begin).count();
+}
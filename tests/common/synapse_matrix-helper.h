@@ -0,0 +1,39 @@
+#pragma once
+
+#include <vector>
+
+#include "fisch/vx/omnibus.h"
+#include "halco/common/iter_all.h"
+#include "haldls/vx/synapse.h"
+#include "lola/vx/synapse.h"
+
+/**
+ * Encode matrix quad by quad via haldls::vx::SynapseQuad.
+ * @param config Matrix to encode
+ * @return Encoded words in order of the quads
+ */
+inline std::vector<fisch::vx::OmnibusChip> encode_per_quad(lola::vx::SynapseMatrix const& config)
+{
+	using namespace halco::hicann_dls::vx;
+	using halco::common::iter_all;
+
+	std::vector<fisch::vx::OmnibusChip> words;
+	words.reserve(lola::vx::SynapseMatrix::config_size_in_words);
+	for (auto const row : iter_all<SynapseRowOnSynram>()) {
+		for (auto const quad : iter_all<SynapseQuadColumnOnDLS>()) {
+			haldls::vx::SynapseQuad quad_config;
+			for (auto const entry : iter_all<EntryOnQuad>()) {
+				SynapseOnSynapseRow const syn(entry, quad);
+				haldls::vx::SynapseQuad::Synapse synapse;
+				synapse.set_weight(config.weights[row][syn]);
+				synapse.set_address(config.addresses[row][syn]);
+				synapse.set_time_calib(config.time_calibs[row][syn]);
+				synapse.set_amp_calib(config.amp_calibs[row][syn]);
+				quad_config.set_synapse(entry, synapse);
+			}
+			auto const quad_words = quad_config.encode<fisch::vx::OmnibusChip>();
+			words.insert(words.end(), quad_words.begin(), quad_words.end());
+		}
+	}
+	return words;
+}
@@ -110,4 +110,184 @@ TEST_F(PlaybackTest, InvalidFPGA)
 	EXPECT_THROW(ctrl.run(program), haldls::exception::InvalidConfiguration);
 }
 
+TEST_F(PlaybackTest, AdaptiveExecute)
+{
+	PlaybackProgramBuilder builder;
+	builder.set_time(0);
+	builder.wait_until(96 * 5000); // ~ 5 ms
+	builder.halt();
+	auto program = builder.done();
+
+	LocalBoardControl ctrl(test_board);
+	ctrl.configure_static(Board(), Chip());
+	ctrl.reset_execute_statistics();
+
+	size_t const num_runs = 10;
+	for (size_t i = 0; i < num_runs; ++i) {
+		ctrl.run(program);
+	}
+
+	auto const& statistics = ctrl.get_execute_statistics();
+	EXPECT_EQ(statistics.num_executions, num_runs);
+	EXPECT_GT(statistics.last_predicted_runtime.count(), 0);
+	EXPECT_GE(statistics.last_observed_runtime.count(), 5000);
+	// end of program observed within the continuous checks around the learnt prediction
+	EXPECT_LT(statistics.last_latency.count(), 1000);
+}
+
+TEST_F(PlaybackTest, RunMany)
+{
+	std::vector<std::shared_ptr<PlaybackProgram> > programs;
+	std::vector<PlaybackProgram::ContainerTicket<CapMemCell> > tickets;
+	for (size_t i = 0; i < 5; ++i) {
+		CapMemCellOnDLS const cell(Enum(i));
+		PlaybackProgramBuilder builder;
+		builder.write(cell, CapMemCell(CapMemCell::Value(100 + i)));
+		builder.wait_until(1000);
+		tickets.push_back(builder.read(cell));
+		builder.halt();
+		programs.push_back(builder.done());
+	}
+
+	LocalBoardControl ctrl(test_board);
+	ctrl.configure_static(Board(), Chip());
+	ctrl.run_many(programs);
+
+	for (size_t i = 0; i < tickets.size(); ++i) {
+		EXPECT_EQ(tickets.at(i).get().get_value(), CapMemCell::Value(100 + i));
+	}
+}
+
+namespace {
+
+// programs writing and reading back a distinct CapMem cell each
+std::vector<std::shared_ptr<PlaybackProgram> > capmem_programs(
+	size_t const num, std::vector<PlaybackProgram::ContainerTicket<CapMemCell> >& tickets)
+{
+	std::vector<std::shared_ptr<PlaybackProgram> > programs;
+	tickets.clear();
+	for (size_t i = 0; i < num; ++i) {
+		CapMemCellOnDLS const cell(Enum(i));
+		PlaybackProgramBuilder builder;
+		builder.write(cell, CapMemCell(CapMemCell::Value(200 + i)));
+		builder.wait_until(1000 * (i + 1));
+		tickets.push_back(builder.read(cell));
+		builder.halt();
+		programs.push_back(builder.done());
+	}
+	return programs;
+}
+
+} // namespace
+
+TEST_F(PlaybackTest, RunManyEqualsSequentialRuns)
+{
+	LocalBoardControl ctrl(test_board);
+	ctrl.configure_static(Board(), Chip());
+
+	// single program, odd and even number of programs alternating between both SDRAM regions
+	for (size_t const num : {1, 2, 3, 4, 7}) {
+		std::vector<PlaybackProgram::ContainerTicket<CapMemCell> > tickets;
+		auto const programs = capmem_programs(num, tickets);
+		std::vector<FlatProgramBytes> program_bytes;
+		std::vector<hate::optional<hardware_time_type> > runtime_estimates;
+		for (auto const& program : programs) {
+			program_bytes.emplace_back(program->instruction_byte_blocks());
+			runtime_estimates.push_back(program->get_runtime_estimate());
+		}
+
+		std::vector<std::vector<instruction_word_type> > expected;
+		for (size_t i = 0; i < num; ++i) {
+			expected.push_back(ctrl.run(program_bytes.at(i), runtime_estimates.at(i)));
+		}
+
+		std::vector<FlatProgramBytes const*> program_ptrs;
+		for (auto const& bytes : program_bytes) {
+			program_ptrs.push_back(&bytes);
+		}
+		std::vector<std::vector<instruction_word_type> > results;
+		ctrl.run_many(program_ptrs, runtime_estimates, results);
+		EXPECT_EQ(results, expected) << "number of programs: " << num;
+	}
+}
+
+TEST_F(PlaybackTest, RunManyEqualsSequentialRunsDecoded)
+{
+	LocalBoardControl ctrl(test_board);
+	ctrl.configure_static(Board(), Chip());
+
+	for (size_t const num : {1, 3, 4}) {
+		std::vector<PlaybackProgram::ContainerTicket<CapMemCell> > sequential_tickets;
+		auto const sequential = capmem_programs(num, sequential_tickets);
+		for (auto const& program : sequential) {
+			ctrl.run(program);
+		}
+		std::vector<PlaybackProgram::ContainerTicket<CapMemCell> > pipelined_tickets;
+		auto const pipelined = capmem_programs(num, pipelined_tickets);
+		ctrl.run_many(pipelined);
+
+		for (size_t i = 0; i < num; ++i) {
+			EXPECT_EQ(pipelined_tickets.at(i).get(), sequential_tickets.at(i).get())
+				<< "program " << i << " of " << num;
+		}
+		// results of the last program are fetched again
+		EXPECT_NO_THROW(ctrl.fetch(pipelined.back()));
+	}
+}
+
+TEST_F(PlaybackTest, RunManyFlatInvalidatesTransferredProgram)
+{
+	LocalBoardControl ctrl(test_board);
+	ctrl.configure_static(Board(), Chip());
+
+	std::vector<PlaybackProgram::ContainerTicket<CapMemCell> > tickets;
+	auto const programs = capmem_programs(3, tickets);
+	ctrl.run(programs.front());
+
+	std::vector<FlatProgramBytes> program_bytes;
+	for (auto const& program : programs) {
+		program_bytes.emplace_back(program->instruction_byte_blocks());
+	}
+	std::vector<FlatProgramBytes const*> program_ptrs;
+	for (auto const& bytes : program_bytes) {
+		program_ptrs.push_back(&bytes);
+	}
+	std::vector<std::vector<instruction_word_type> > results;
+	ctrl.run_many(
+		program_ptrs, std::vector<hate::optional<hardware_time_type> >(program_ptrs.size()),
+		results);
+	EXPECT_EQ(results.size(), programs.size());
+
+	// SDRAM holds the results of the last flat program, not of the previously run program
+	EXPECT_THROW(ctrl.fetch(programs.front()), std::runtime_error);
+}
+
+TEST_F(PlaybackTest, RunManyOverlappedNotLearnt)
+{
+	std::vector<std::shared_ptr<PlaybackProgram> > programs;
+	for (size_t i = 0; i < 3; ++i) {
+		PlaybackProgramBuilder builder;
+		builder.set_time(0);
+		builder.wait_until(96 * 1000); // ~ 1 ms
+		builder.halt();
+		programs.push_back(builder.done());
+	}
+
+	LocalBoardControl ctrl(test_board);
+	ctrl.configure_static(Board(), Chip());
+	ctrl.reset_execute_statistics();
+
+	// transfers during execution are not learnt as instruction overhead
+	ctrl.run_many(programs);
+	auto const& statistics = ctrl.get_execute_statistics();
+	EXPECT_EQ(statistics.num_executions, programs.size());
+	EXPECT_EQ(statistics.runtime_correction.count(), 0);
+	EXPECT_EQ(statistics.total_latency.count(), 0);
+
+	// a single program is not overlapped
+	ctrl.run_many({programs.front()});
+	EXPECT_EQ(statistics.num_executions, programs.size() + 1);
+	EXPECT_NE(statistics.runtime_correction.count(), 0);
+}
+
 #endif
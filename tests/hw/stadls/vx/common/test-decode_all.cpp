@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+#include "haldls/vx/capmem.h"
+#include "haldls/vx/timer.h"
+#include "stadls/vx/init_generator.h"
+#include "stadls/vx/playback_program.h"
+#include "stadls/vx/playback_program_builder.h"
+
+#include "executor.h"
+#include "test-helper.h"
+
+using namespace halco::common;
+using namespace halco::hicann_dls::vx;
+using namespace haldls::vx;
+using namespace stadls::vx;
+
+extern std::optional<size_t> const max_words_per_reduced_test;
+
+/**
+ * Read CapMemCells and compare serial decoding on get() to parallel decoding via decode_all().
+ */
+TEST(PlaybackProgram, DecodeAll)
+{
+	auto sequence = DigitalInit();
+	sequence.enable_highspeed_link = false;
+	auto [builder, _] = generate(sequence);
+
+	std::vector<PlaybackProgram::ContainerTicket<CapMemCell>> tickets;
+	for (auto const cell : iter_sparse<CapMemCellOnDLS>(max_words_per_reduced_test)) {
+		tickets.push_back(builder.read(cell, Backend::OmnibusChipOverJTAG));
+	}
+
+	builder.write(TimerOnDLS(), Timer());
+	builder.wait_until(TimerOnDLS(), Timer::Value(40000));
+	auto program = builder.done();
+
+	auto executor = generate_playback_program_test_executor();
+	executor.run(program);
+
+	auto const serial_begin = std::chrono::steady_clock::now();
+	std::vector<CapMemCell> serial;
+	for (auto const& ticket : tickets) {
+		serial.push_back(ticket.get());
+	}
+	auto const serial_end = std::chrono::steady_clock::now();
+
+	auto const parallel_begin = std::chrono::steady_clock::now();
+	program.decode_all();
+	std::vector<CapMemCell> parallel;
+	for (auto const& ticket : tickets) {
+		parallel.push_back(ticket.get());
+	}
+	auto const parallel_end = std::chrono::steady_clock::now();
+
+	EXPECT_EQ(serial, parallel);
+
+	std::chrono::duration<double> const serial_duration = serial_end - serial_begin;
+	std::chrono::duration<double> const parallel_duration = parallel_end - parallel_begin;
+	std::cout << "Decoding " << tickets.size() << " tickets [s]: serial get() "
+	          << serial_duration.count() << ", decode_all() and get() "
+	          << parallel_duration.count() << std::endl;
+}
@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+
+#include <future>
+#include <vector>
+
+#include "haldls/vx/jtag.h"
+#include "haldls/vx/timer.h"
+#include "stadls/vx/init_generator.h"
+#include "stadls/vx/executor_pool.h"
+#include "stadls/vx/playback_program.h"
+#include "stadls/vx/playback_program_builder.h"
+
+#include "executor.h"
+
+using namespace halco::hicann_dls::vx;
+using namespace haldls::vx;
+using namespace stadls::vx;
+
+/**
+ * Distribute programs onto a pool with the test executor as single backend and check that all
+ * programs are executed and accounted for in the utilization statistics.
+ */
+TEST(ExecutorPool, Run)
+{
+	constexpr size_t num_programs = 4;
+
+	ExecutorPool pool;
+	pool.add(generate_playback_program_test_executor());
+	EXPECT_EQ(pool.size(), 1u);
+
+	std::vector<PlaybackProgram::ContainerTicket<JTAGIdCode>> tickets;
+	std::vector<PlaybackProgram> programs;
+	for (size_t i = 0; i < num_programs; ++i) {
+		auto [builder, _] = generate(DigitalInit());
+		tickets.push_back(builder.read(JTAGIdCodeOnDLS()));
+		builder.write(TimerOnDLS(), Timer());
+		builder.wait_until(TimerOnDLS(), Timer::Value(1000));
+		programs.push_back(builder.done());
+	}
+
+	pool.run(programs);
+
+	for (auto const& ticket : tickets) {
+		EXPECT_TRUE(ticket.valid());
+		EXPECT_EQ(ticket.get(), tickets.front().get());
+	}
+
+	PlaybackProgramBuilder restricted_builder(
+	    pool.get_utilization().at(0).backend == ExecutorBackend::hardware
+	        ? ExecutorBackend::simulation
+	        : ExecutorBackend::hardware);
+	EXPECT_THROW(pool.run_async(restricted_builder.done()), std::runtime_error);
+
+	pool.wait_all();
+	auto const utilization = pool.get_utilization();
+	ASSERT_EQ(utilization.size(), 1u);
+	EXPECT_EQ(utilization.at(0).programs, num_programs);
+	EXPECT_GT(utilization.at(0).busy_time, 0.);
+	EXPECT_LE(utilization.at(0).busy_time, utilization.at(0).total_time);
+}
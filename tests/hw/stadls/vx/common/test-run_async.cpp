@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+
+#include <future>
+#include <vector>
+
+#include "haldls/vx/capmem.h"
+#include "haldls/vx/timer.h"
+#include "stadls/vx/init_generator.h"
+#include "stadls/vx/playback_program.h"
+#include "stadls/vx/playback_program_builder.h"
+
+#include "executor.h"
+#include "test-helper.h"
+
+using namespace halco::common;
+using namespace halco::hicann_dls::vx;
+using namespace haldls::vx;
+using namespace stadls::vx;
+
+/**
+ * Enqueue more programs than allowed in flight and check that all are executed in order.
+ */
+TEST(PlaybackProgramExecutor, RunAsync)
+{
+	constexpr size_t num_programs = 5;
+
+	auto executor = generate_playback_program_test_executor();
+	executor.set_max_programs_in_flight(2);
+	EXPECT_EQ(executor.get_max_programs_in_flight(), 2u);
+	EXPECT_THROW(executor.set_max_programs_in_flight(0), std::invalid_argument);
+
+	std::vector<PlaybackProgram::ContainerTicket<CapMemCell>> tickets;
+	std::vector<CapMemCell> configs;
+	std::vector<std::future<PlaybackProgram>> futures;
+	for (size_t i = 0; i < num_programs; ++i) {
+		auto sequence = DigitalInit();
+		sequence.enable_highspeed_link = false;
+		auto [builder, _] = generate(sequence);
+
+		CapMemCell const config(draw_ranged_non_default_value<CapMemCell::Value>());
+		builder.write(CapMemCellOnDLS(), config, Backend::OmnibusChipOverJTAG);
+		tickets.push_back(builder.read(CapMemCellOnDLS(), Backend::OmnibusChipOverJTAG));
+		configs.push_back(config);
+
+		builder.write(TimerOnDLS(), Timer());
+		builder.wait_until(TimerOnDLS(), Timer::Value(1000));
+		futures.push_back(executor.run_async(builder.done()));
+	}
+
+	for (size_t i = 0; i < num_programs; ++i) {
+		auto const program = futures.at(i).get();
+		EXPECT_TRUE(tickets.at(i).valid());
+		EXPECT_EQ(tickets.at(i).get(), configs.at(i));
+	}
+
+	executor.wait_all();
+}
@@ -52,3 +52,39 @@ TEST(CapMemCell, WROverHighspeed)
 		EXPECT_EQ(ticket.get(), cells.at(cell)) << cell;
 	}
 }
+
+/**
+ * Enable Highspeed omnibus connection and write and read all CapMemCells in batches for
+ * verification.
+ */
+TEST(CapMemCell, WRManyOverHighspeed)
+{
+	auto sequence = DigitalInit();
+	sequence.highspeed_link.enable_systime = false;
+	auto [builder, _] = generate(sequence);
+
+	std::vector<CapMemCellOnDLS> coords;
+	std::vector<CapMemCell> cells;
+	for (auto const cell : iter_sparse<CapMemCellOnDLS>(max_words_per_reduced_test)) {
+		coords.push_back(cell);
+		cells.push_back(CapMemCell(draw_ranged_non_default_value<CapMemCell::Value>()));
+	}
+	builder.write_many(coords, cells);
+
+	PlaybackProgramBuilder read_builder;
+	auto const ticket = read_builder.read_many(coords);
+	EXPECT_EQ(ticket.size(), coords.size());
+	EXPECT_FALSE(ticket.valid());
+	builder.merge_back(read_builder);
+
+	builder.write(TimerOnDLS(), Timer());
+	builder.wait_until(TimerOnDLS(), Timer::Value(40000));
+	auto program = builder.done();
+
+	auto executor = generate_playback_program_test_executor();
+	executor.run(program);
+
+	EXPECT_TRUE(ticket.valid());
+	EXPECT_EQ(ticket.get_coordinates(), coords);
+	EXPECT_EQ(ticket.get(), cells);
+}
@@ -0,0 +1,25 @@
+#include <gtest/gtest.h>
+
+#include "haldls/v2/playback.h"
+
+using namespace haldls::v2;
+
+TEST(PlaybackProgram, RuntimeEstimate)
+{
+	PlaybackProgramBuilder builder;
+	EXPECT_EQ(builder.done()->get_runtime_estimate(), 0);
+
+	builder.set_time(0);
+	builder.wait_until(100);
+	// waiting for a time already passed does not take time
+	builder.wait_until(50);
+	builder.wait_for(20);
+	builder.set_time(10);
+	builder.wait_until(40);
+	builder.halt();
+	auto const program = builder.done();
+	EXPECT_EQ(program->get_runtime_estimate(), 100 + 20 + 30);
+
+	// builder is reset
+	EXPECT_EQ(builder.done()->get_runtime_estimate(), 0);
+}
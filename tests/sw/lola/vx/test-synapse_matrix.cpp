@@ -1,12 +1,17 @@
+#include <random>
+#include <vector>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
 #include "fisch/vx/omnibus.h"
 #include "halco/common/cerealization_geometry.h"
+#include "halco/common/cerealization_typed_array.h"
 #include "halco/common/cerealization_typed_heap_array.h"
+#include "halco/common/iter_all.h"
 #include "lola/vx/cerealization.h"
 #include "lola/vx/synapse.h"
 #include "stadls/visitors.h"
+#include "synapse_matrix-helper.h"
 #include "test-helper.h"
 
 using namespace lola::vx;
@@ -70,6 +75,25 @@ TEST(SynapseMatrix, General)
 	ASSERT_FALSE(config != config_eq);
 }
 
+TEST(SynapseMatrix, RowMajorStorage)
+{
+	auto config_ptr = std::make_unique<SynapseMatrix>();
+	SynapseMatrix const& config = *config_ptr;
+
+	// all rows share a single contiguous allocation
+	auto const* const first = &config.weights[SynapseRowOnSynram(0)][SynapseOnSynapseRow(0)];
+	for (auto const row : iter_all<SynapseRowOnSynram>()) {
+		for (auto const column : iter_all<SynapseOnSynapseRow>()) {
+			EXPECT_EQ(
+			    &config.weights[row][column],
+			    first + row.toEnum() * SynapseOnSynapseRow::size + column.toEnum());
+		}
+	}
+	static_assert(
+	    sizeof(SynapseMatrix::Weight) == sizeof(SynapseMatrix::Weight::value_type),
+	    "Weights need to be layout-compatible to their raw value.");
+}
+
 TEST(SynapseMatrix, CerealizeCoverage)
 {
 	auto obj1_ptr = std::make_unique<SynapseMatrix>();
@@ -155,3 +179,66 @@ TEST(SynapseMatrix, EncodeDecode)
 	visit_preorder(config_copy, coord, stadls::DecodeVisitor<words_type>{std::move(data)});
 	ASSERT_EQ(config, config_copy);
 }
+
+namespace {
+
+/**
+ * Fill all synapses of matrix with random values.
+ */
+void randomize(SynapseMatrix& config, std::mt19937& gen)
+{
+	std::uniform_int_distribution<uintmax_t> weight(0, SynapseMatrix::Weight::max);
+	std::uniform_int_distribution<uintmax_t> address(0, SynapseMatrix::Address::max);
+	std::uniform_int_distribution<uintmax_t> time_calib(0, SynapseMatrix::TimeCalib::max);
+	std::uniform_int_distribution<uintmax_t> amp_calib(0, SynapseMatrix::AmpCalib::max);
+	for (auto const row : iter_all<SynapseRowOnSynram>()) {
+		for (auto const syn : iter_all<SynapseOnSynapseRow>()) {
+			config.weights[row][syn] = SynapseMatrix::Weight(weight(gen));
+			config.addresses[row][syn] = SynapseMatrix::Address(address(gen));
+			config.time_calibs[row][syn] = SynapseMatrix::TimeCalib(time_calib(gen));
+			config.amp_calibs[row][syn] = SynapseMatrix::AmpCalib(amp_calib(gen));
+		}
+	}
+}
+
+} // namespace
+
+TEST(SynapseMatrix, EncodeDecodeEquivalentToQuads)
+{
+	std::mt19937 gen(1234);
+
+	SynapseMatrix config;
+	randomize(config, gen);
+	auto const words = config.encode<fisch::vx::OmnibusChip>();
+	EXPECT_EQ(words, encode_per_quad(config));
+
+	// decode arbitrary words, which includes all bit patterns of every entry
+	std::uniform_int_distribution<uint32_t> word(0, 0xffff'ffff);
+	std::vector<fisch::vx::OmnibusChip> random_words;
+	for (size_t i = 0; i < SynapseMatrix::config_size_in_words; ++i) {
+		random_words.push_back(fisch::vx::OmnibusChip(fisch::vx::OmnibusData(word(gen))));
+	}
+	SynapseMatrix decoded;
+	decoded.decode(random_words.data());
+
+	auto random_word = random_words.begin();
+	for (auto const row : iter_all<SynapseRowOnSynram>()) {
+		for (auto const quad : iter_all<SynapseQuadColumnOnDLS>()) {
+			SynapseQuad quad_config;
+			quad_config.decode<fisch::vx::OmnibusChip>({*random_word, *(random_word + 1)});
+			random_word += SynapseQuad::config_size_in_words;
+			for (auto const entry : iter_all<EntryOnQuad>()) {
+				SynapseOnSynapseRow const syn(entry, quad);
+				auto const synapse = quad_config.get_synapse(entry);
+				EXPECT_EQ(decoded.weights[row][syn], synapse.get_weight());
+				EXPECT_EQ(decoded.addresses[row][syn], synapse.get_address());
+				EXPECT_EQ(decoded.time_calibs[row][syn], synapse.get_time_calib());
+				EXPECT_EQ(decoded.amp_calibs[row][syn], synapse.get_amp_calib());
+			}
+		}
+	}
+
+	SynapseMatrix roundtrip;
+	roundtrip.decode(words.data());
+	EXPECT_EQ(roundtrip, config);
+}
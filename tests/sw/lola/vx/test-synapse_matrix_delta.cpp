@@ -0,0 +1,178 @@
+#include <random>
+#include <sstream>
+#include <vector>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "fisch/vx/omnibus.h"
+#include "halco/common/cerealization_geometry.h"
+#include "halco/common/iter_all.h"
+#include "haldls/cerealization.h"
+#include "lola/vx/synapse.h"
+#include "stadls/visitors.h"
+
+using namespace lola::vx;
+using namespace haldls::vx;
+using namespace halco::hicann_dls::vx;
+using namespace halco::common;
+
+TEST(SynapseMatrixDelta, General)
+{
+	auto base_ptr = std::make_unique<SynapseMatrix>();
+	SynapseMatrix const& base = *base_ptr;
+
+	SynapseMatrixDelta delta;
+	EXPECT_TRUE(delta.empty());
+	EXPECT_EQ(delta.size(), 0);
+	EXPECT_THROW(delta.get(SynapseQuadOnSynram()), std::out_of_range);
+
+	SynapseQuad::Synapse synapse;
+	synapse.set_weight(SynapseQuad::Synapse::Weight(42));
+	delta.set(base, SynapseRowOnSynram(12), SynapseOnSynapseRow(23), synapse);
+	synapse.set_weight(SynapseQuad::Synapse::Weight(43));
+	delta.set(base, SynapseRowOnSynram(2), SynapseOnSynapseRow(7), synapse);
+	// same quad as first change
+	synapse.set_address(SynapseQuad::Synapse::Address(5));
+	delta.set(base, SynapseRowOnSynram(12), SynapseOnSynapseRow(22), synapse);
+
+	EXPECT_FALSE(delta.empty());
+	EXPECT_EQ(delta.size(), 2);
+
+	// affected quads are sorted
+	auto const quads = delta.get_quads();
+	ASSERT_EQ(quads.size(), 2);
+	EXPECT_EQ(
+	    quads.at(0),
+	    SynapseQuadOnSynram(
+	        SynapseOnSynapseRow(7).toSynapseQuadColumnOnDLS(), SynapseRowOnSynram(2)));
+	EXPECT_EQ(
+	    quads.at(1),
+	    SynapseQuadOnSynram(
+	        SynapseOnSynapseRow(23).toSynapseQuadColumnOnDLS(), SynapseRowOnSynram(12)));
+
+	auto const quad = delta.get(quads.at(1));
+	EXPECT_EQ(
+	    quad.get_synapse(SynapseOnSynapseRow(23).toEntryOnQuad()).get_weight(),
+	    SynapseQuad::Synapse::Weight(42));
+	EXPECT_EQ(quad.get_synapse(SynapseOnSynapseRow(22).toEntryOnQuad()), synapse);
+
+	SynapseMatrixDelta delta_copy = delta;
+	EXPECT_EQ(delta, delta_copy);
+	delta_copy.clear();
+	EXPECT_NE(delta, delta_copy);
+	EXPECT_TRUE(delta_copy.empty());
+}
+
+TEST(SynapseMatrixDelta, FromMatrices)
+{
+	std::mt19937 gen(1234);
+	std::uniform_int_distribution<size_t> row(SynapseRowOnSynram::min, SynapseRowOnSynram::max);
+	std::uniform_int_distribution<size_t> column(
+	    SynapseOnSynapseRow::min, SynapseOnSynapseRow::max);
+	std::uniform_int_distribution<uintmax_t> weight(0, SynapseMatrix::Weight::max);
+
+	auto base_ptr = std::make_unique<SynapseMatrix>();
+	auto target_ptr = std::make_unique<SynapseMatrix>();
+	auto& base = *base_ptr;
+	auto& target = *target_ptr;
+
+	for (size_t i = 0; i < 300; ++i) {
+		target.weights[SynapseRowOnSynram(row(gen))][SynapseOnSynapseRow(column(gen))] =
+		    SynapseMatrix::Weight(weight(gen));
+	}
+
+	SynapseMatrixDelta const delta(base, target);
+	EXPECT_FALSE(delta.empty());
+	EXPECT_LE(delta.size(), 300);
+
+	// quads are sorted and unique
+	auto const quads = delta.get_quads();
+	for (size_t i = 1; i < quads.size(); ++i) {
+		EXPECT_LT(quads.at(i - 1).toEnum(), quads.at(i).toEnum());
+	}
+
+	delta.apply(base);
+	EXPECT_EQ(base, target);
+
+	EXPECT_TRUE(SynapseMatrixDelta(base, target).empty());
+}
+
+TEST(SynapseMatrixDelta, EncodeDecode)
+{
+	typedef std::vector<halco::hicann_dls::vx::OmnibusChipAddress> addresses_type;
+	typedef std::vector<fisch::vx::OmnibusChip> words_type;
+
+	SynapseMatrixDeltaOnDLS const coord(1);
+
+	auto base_ptr = std::make_unique<SynapseMatrix>();
+	SynapseMatrix const& base = *base_ptr;
+
+	SynapseMatrixDelta config;
+	SynapseQuad::Synapse synapse;
+	synapse.set_weight(SynapseQuad::Synapse::Weight(63));
+	config.set(base, SynapseRowOnSynram(12), SynapseOnSynapseRow(23), synapse);
+	config.set(base, SynapseRowOnSynram(3), SynapseOnSynapseRow(100), synapse);
+
+	// only words of affected quads in ascending order
+	addresses_type ref_addresses;
+	words_type ref_data;
+	for (auto const quad : config.get_quads()) {
+		SynapseQuad const quad_config = config.get(quad);
+		auto const quad_addresses = quad_config.addresses<addresses_type::value_type>(
+		    SynapseQuadOnDLS(quad, coord.toSynramOnDLS()));
+		ref_addresses.insert(ref_addresses.end(), quad_addresses.begin(), quad_addresses.end());
+		auto const quad_data = quad_config.encode<fisch::vx::OmnibusChip>();
+		ref_data.insert(ref_data.end(), quad_data.begin(), quad_data.end());
+	}
+	EXPECT_EQ(ref_addresses.size(), 2 * SynapseQuad::config_size_in_words);
+
+	{
+		addresses_type write_addresses;
+		visit_preorder(config, coord, stadls::WriteAddressVisitor<addresses_type>{write_addresses});
+		EXPECT_THAT(write_addresses, ::testing::ElementsAreArray(ref_addresses));
+	}
+
+	words_type data;
+	visit_preorder(config, coord, stadls::EncodeVisitor<words_type>{data});
+	EXPECT_THAT(data, ::testing::ElementsAreArray(ref_data));
+
+	// decoding alters the affected quads
+	SynapseMatrixDelta config_copy = config;
+	SynapseQuad::Synapse other;
+	other.set_weight(SynapseQuad::Synapse::Weight(1));
+	config_copy.set(base, SynapseRowOnSynram(12), SynapseOnSynapseRow(23), other);
+	ASSERT_NE(config, config_copy);
+	visit_preorder(config_copy, coord, stadls::DecodeVisitor<words_type>{std::move(data)});
+	ASSERT_EQ(config, config_copy);
+
+	// empty delta has no words
+	SynapseMatrixDelta const empty;
+	words_type empty_data;
+	visit_preorder(empty, coord, stadls::EncodeVisitor<words_type>{empty_data});
+	EXPECT_TRUE(empty_data.empty());
+}
+
+TEST(SynapseMatrixDelta, CerealizeCoverage)
+{
+	auto base_ptr = std::make_unique<SynapseMatrix>();
+	SynapseMatrix const& base = *base_ptr;
+
+	SynapseMatrixDelta obj1;
+	SynapseMatrixDelta obj2;
+	SynapseQuad::Synapse synapse;
+	synapse.set_amp_calib(SynapseQuad::Synapse::AmpCalib(2));
+	obj1.set(base, SynapseRowOnSynram(15), SynapseOnSynapseRow(26), synapse);
+
+	std::ostringstream ostream;
+	{
+		cereal::JSONOutputArchive oa(ostream);
+		oa(obj1);
+	}
+
+	std::istringstream istream(ostream.str());
+	{
+		cereal::JSONInputArchive ia(istream);
+		ia(obj2);
+	}
+	ASSERT_EQ(obj1, obj2);
+}
@@ -0,0 +1,321 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include <SF/IBinaryStream.hpp>
+#include <SF/OBinaryStream.hpp>
+#include <SF/string.hpp>
+#include <SF/vector.hpp>
+#include <cereal/archives/binary.hpp>
+
+#include "haldls/v2/board.h"
+#include "haldls/v2/chip.h"
+#include "haldls/v2/playback.h"
+#include "stadls/v2/quick_queue.h"
+
+using namespace stadls::v2;
+
+namespace {
+
+QuickQueueRequest example_request(
+	uint32_t const board_word, FlatProgramBytes::blocks_type const& chip_program_blocks)
+{
+	QuickQueueRequest req;
+	req.board_addresses.push_back(haldls::v2::ocp_address_type{0x8020});
+	req.board_words.push_back(haldls::v2::ocp_word_type{board_word});
+	req.chip_program_bytes = FlatProgramBytes(chip_program_blocks);
+	req.playback_program_bytes = FlatProgramBytes({{0, 1, 2, 3}});
+	return req;
+}
+
+QuickQueueRequest example_request(uint32_t const board_word)
+{
+	return example_request(board_word, {{4, 5, 6, 7}, {8, 9, 10, 11}});
+}
+
+QuickQueueBatchRequest example_batch(std::vector<uint32_t> const& board_words)
+{
+	QuickQueueBatchRequest batch;
+	for (auto const board_word : board_words) {
+		batch.requests.push_back(example_request(board_word));
+	}
+	return batch;
+}
+
+QuickQueueWorker mock_worker()
+{
+	QuickQueueWorker worker("mock");
+	worker.set_mock_mode(true);
+	worker.setup();
+	return worker;
+}
+
+void expect_success(QuickQueueBatchResponse const& response, size_t const size)
+{
+	ASSERT_EQ(response.responses.size(), size);
+	ASSERT_EQ(response.error_messages.size(), size);
+	for (auto const& message : response.error_messages) {
+		EXPECT_TRUE(message.empty()) << message;
+	}
+}
+
+} // namespace
+
+TEST(QuickQueueWorker, StaticConfigReloadedByDefault)
+{
+	auto worker = mock_worker();
+
+	expect_success(worker.work(example_batch({1, 1, 1})), 3);
+	EXPECT_EQ(worker.get_num_static_configurations(), 3);
+	expect_success(worker.work(example_batch({1})), 1);
+	EXPECT_EQ(worker.get_num_static_configurations(), 4);
+}
+
+TEST(QuickQueueWorker, StaticConfigReuse)
+{
+	auto worker = mock_worker();
+	worker.set_reuse_static_config(true);
+
+	// only changes of the configuration are loaded
+	expect_success(worker.work(example_batch({1, 1, 2, 2, 1})), 5);
+	EXPECT_EQ(worker.get_num_static_configurations(), 3);
+
+	// loaded configuration is kept across requests
+	expect_success(worker.work(example_batch({1})), 1);
+	EXPECT_EQ(worker.get_num_static_configurations(), 3);
+	expect_success(worker.work(example_batch({2})), 1);
+	EXPECT_EQ(worker.get_num_static_configurations(), 4);
+
+	// reloaded after disabling
+	worker.set_reuse_static_config(false);
+	expect_success(worker.work(example_batch({2})), 1);
+	EXPECT_EQ(worker.get_num_static_configurations(), 5);
+}
+
+TEST(QuickQueueWorker, StaticConfigFingerprint)
+{
+	auto worker = mock_worker();
+	worker.set_reuse_static_config(true);
+
+	QuickQueueBatchRequest batch;
+	batch.requests.push_back(example_request(1, {{4, 5, 6, 7}, {8, 9, 10, 11}}));
+	// equal bytes split into different blocks
+	batch.requests.push_back(example_request(1, {{4, 5, 6, 7, 8, 9, 10, 11}}));
+	// different chip configuration
+	batch.requests.push_back(example_request(1, {{4, 5, 6, 7}, {8, 9, 10, 12}}));
+	// different board configuration
+	batch.requests.push_back(example_request(2, {{4, 5, 6, 7}, {8, 9, 10, 12}}));
+	// additional board word
+	batch.requests.push_back(batch.requests.back());
+	batch.requests.back().board_addresses.push_back(haldls::v2::ocp_address_type{0x8021});
+	batch.requests.back().board_words.push_back(haldls::v2::ocp_word_type{0});
+	// unchanged static configuration with different playback program
+	batch.requests.push_back(batch.requests.back());
+	batch.requests.back().playback_program_bytes = FlatProgramBytes({{3, 2, 1, 0}});
+
+	expect_success(worker.work(batch), batch.requests.size());
+	EXPECT_EQ(worker.get_num_static_configurations(), 5);
+}
+
+TEST(QuickQueueWorker, StaticConfigReloadedAfterFailure)
+{
+	auto worker = mock_worker();
+	worker.set_reuse_static_config(true);
+
+	expect_success(worker.work(example_batch({1})), 1);
+	EXPECT_EQ(worker.get_num_static_configurations(), 1);
+
+	// experiment fails after the unchanged configuration was skipped
+	auto batch = example_batch({1});
+	batch.requests.front().playback_program_bytes = FlatProgramBytes();
+	auto const response = worker.work(batch);
+	ASSERT_EQ(response.error_messages.size(), 1);
+	EXPECT_FALSE(response.error_messages.front().empty());
+	EXPECT_EQ(worker.get_num_static_configurations(), 1);
+
+	// state of the hardware is unknown after the failure
+	expect_success(worker.work(example_batch({1})), 1);
+	EXPECT_EQ(worker.get_num_static_configurations(), 2);
+	expect_success(worker.work(example_batch({1})), 1);
+	EXPECT_EQ(worker.get_num_static_configurations(), 2);
+}
+
+TEST(QuickQueueWorker, StaticConfigReloadedAfterPipelineFailure)
+{
+	auto worker = mock_worker();
+	worker.set_reuse_static_config(true);
+
+	auto batch = example_batch({1, 1, 1});
+	batch.requests.at(1).playback_program_bytes = FlatProgramBytes();
+	auto const response = worker.work(batch);
+	ASSERT_EQ(response.error_messages.size(), 3);
+	// experiments preceding the failed one are not affected
+	EXPECT_TRUE(response.error_messages.at(0).empty());
+	EXPECT_FALSE(response.error_messages.at(1).empty());
+	EXPECT_FALSE(response.error_messages.at(2).empty());
+	EXPECT_EQ(worker.get_num_static_configurations(), 1);
+
+	expect_success(worker.work(example_batch({1})), 1);
+	EXPECT_EQ(worker.get_num_static_configurations(), 2);
+}
+
+TEST(QuickQueueWorker, BatchEmpty)
+{
+	auto worker = mock_worker();
+
+	expect_success(worker.work(QuickQueueBatchRequest()), 0);
+	EXPECT_EQ(worker.get_num_static_configurations(), 0);
+}
+
+TEST(QuickQueueWorker, BatchErrorsPerItem)
+{
+	for (bool const reuse : {false, true}) {
+		auto worker = mock_worker();
+		worker.set_reuse_static_config(reuse);
+
+		// pipelines of equal configuration are interrupted by failures and changes
+		auto batch = example_batch({1, 1, 1, 2, 2, 3, 1});
+		std::vector<bool> const fails{false, true, false, true, false, false, true};
+		for (size_t i = 0; i < fails.size(); ++i) {
+			if (fails.at(i)) {
+				batch.requests.at(i).playback_program_bytes = FlatProgramBytes();
+			}
+		}
+
+		auto const response = worker.work(batch);
+		ASSERT_EQ(response.responses.size(), batch.requests.size());
+		ASSERT_EQ(response.error_messages.size(), batch.requests.size());
+		for (size_t i = 0; i < fails.size(); ++i) {
+			// failures of a pipeline also affect its subsequent experiments
+			bool const expect_failure = fails.at(i) || (reuse && ((i == 2) || (i == 4)));
+			EXPECT_EQ(!response.error_messages.at(i).empty(), expect_failure)
+				<< "experiment " << i << " with reuse " << reuse;
+		}
+	}
+}
+
+TEST(QuickQueueWorker, BatchOrder)
+{
+	auto worker = mock_worker();
+
+	// errors are reported at the position of the failed request
+	for (size_t failed = 0; failed < 5; ++failed) {
+		auto batch = example_batch({1, 2, 3, 4, 5});
+		batch.requests.at(failed).playback_program_bytes = FlatProgramBytes();
+
+		auto const response = worker.work(batch);
+		ASSERT_EQ(response.error_messages.size(), batch.requests.size());
+		for (size_t i = 0; i < batch.requests.size(); ++i) {
+			EXPECT_EQ(response.error_messages.at(i).empty(), i != failed)
+				<< "experiment " << i << " with failed experiment " << failed;
+		}
+	}
+}
+
+TEST(QuickQueueWorker, BatchCompression)
+{
+	auto worker = mock_worker();
+
+	auto batch = example_batch({1, 2});
+	batch.accepted_compressions = 0;
+	auto const response = worker.work(batch);
+	expect_success(response, 2);
+	for (auto const& single_response : response.responses) {
+		EXPECT_EQ(single_response.compression, WireCompression::none);
+	}
+}
+
+TEST(QuickQueueRequest, RuntimeEstimate)
+{
+	QuickQueueRequest req;
+	EXPECT_FALSE(req.get_playback_program_runtime_estimate());
+
+	req.playback_program_runtime_estimate = 1000;
+	ASSERT_TRUE(req.get_playback_program_runtime_estimate());
+	EXPECT_EQ(*req.get_playback_program_runtime_estimate(), 1000);
+
+	// zero is the value of clients not estimating the runtime
+	req.playback_program_runtime_estimate = 0;
+	EXPECT_FALSE(req.get_playback_program_runtime_estimate());
+}
+
+TEST(QuickQueueRequest, RuntimeEstimateOfProgram)
+{
+	{
+		haldls::v2::PlaybackProgramBuilder builder;
+		builder.halt();
+		auto const req =
+			create_request(haldls::v2::Board(), haldls::v2::Chip(), builder.done());
+		EXPECT_FALSE(req.get_playback_program_runtime_estimate());
+	}
+	{
+		haldls::v2::PlaybackProgramBuilder builder;
+		builder.wait_for(1000);
+		builder.halt();
+		auto const program = builder.done();
+		auto const req = create_request(haldls::v2::Board(), haldls::v2::Chip(), program);
+		ASSERT_TRUE(req.get_playback_program_runtime_estimate());
+		EXPECT_EQ(*req.get_playback_program_runtime_estimate(), program->get_runtime_estimate());
+	}
+}
+
+TEST(QuickQueueBatchRequest, Serialization)
+{
+	auto batch = example_batch({1, 2});
+	batch.requests.at(1).playback_program_runtime_estimate = 1000;
+	for (auto const compression : {WireCompression::none, WireCompression::lz4}) {
+		for (auto& req : batch.requests) {
+			req.compression = compression;
+		}
+
+		std::stringstream sf_stream;
+		{
+			SF::OBinaryStream archive(sf_stream);
+			archive << batch;
+		}
+		std::stringstream cereal_stream;
+		{
+			cereal::BinaryOutputArchive archive(cereal_stream);
+			archive(batch);
+		}
+
+		for (auto const sf : {true, false}) {
+			auto& stream = sf ? sf_stream : cereal_stream;
+			auto const serialized = stream.str();
+
+			QuickQueueBatchRequest received;
+			if (sf) {
+				SF::IBinaryStream archive(stream);
+				archive >> received;
+			} else {
+				cereal::BinaryInputArchive archive(stream);
+				archive(received);
+			}
+			ASSERT_EQ(received.requests.size(), batch.requests.size());
+			for (size_t i = 0; i < batch.requests.size(); ++i) {
+				auto const& expected = batch.requests.at(i);
+				auto const& actual = received.requests.at(i);
+				EXPECT_EQ(actual.board_words, expected.board_words);
+				EXPECT_EQ(actual.chip_program_bytes, expected.chip_program_bytes);
+				EXPECT_EQ(actual.playback_program_bytes, expected.playback_program_bytes);
+				EXPECT_EQ(
+					actual.playback_program_runtime_estimate,
+					expected.playback_program_runtime_estimate);
+			}
+			EXPECT_EQ(received.accepted_compressions, batch.accepted_compressions);
+
+			// frames are read straight from the stream, which must not end within them
+			std::stringstream truncated(serialized.substr(0, serialized.size() / 2));
+			if (sf) {
+				SF::IBinaryStream archive(truncated);
+				EXPECT_ANY_THROW(archive >> received);
+			} else {
+				cereal::BinaryInputArchive archive(truncated);
+				EXPECT_ANY_THROW(archive(received));
+			}
+		}
+	}
+}
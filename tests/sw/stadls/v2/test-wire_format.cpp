@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <vector>
+
+#include "stadls/v2/wire_format.h"
+
+using namespace stadls::v2;
+
+namespace {
+
+std::vector<WireCompression> supported_compressions()
+{
+	std::vector<WireCompression> compressions{WireCompression::none};
+	if (negotiate_wire_compression(~wire_capabilities_type(0)) == WireCompression::lz4) {
+		compressions.push_back(WireCompression::lz4);
+	}
+	return compressions;
+}
+
+FlatProgramBytes::blocks_type example_blocks()
+{
+	FlatProgramBytes::blocks_type blocks(3);
+	for (size_t i = 0; i < 4096; ++i) {
+		blocks.at(0).push_back(i % 7);
+	}
+	for (size_t i = 0; i < 12; ++i) {
+		blocks.at(2).push_back(i);
+	}
+	return blocks;
+}
+
+} // namespace
+
+TEST(FlatProgramBytes, Blocks)
+{
+	auto const blocks = example_blocks();
+	FlatProgramBytes const program(blocks);
+
+	EXPECT_EQ(program.num_blocks(), 3);
+	EXPECT_EQ(program.bytes.size(), 4096 + 12);
+	EXPECT_EQ(program.block_size(0), 4096);
+	EXPECT_EQ(program.block_size(1), 0);
+	EXPECT_EQ(program.block_size(2), 12);
+	EXPECT_EQ(program.block_data(2), program.bytes.data() + 4096);
+	EXPECT_EQ(program.to_blocks(), blocks);
+
+	FlatProgramBytes const empty;
+	EXPECT_EQ(empty.num_blocks(), 0);
+	EXPECT_TRUE(empty.to_blocks().empty());
+	EXPECT_NE(empty, program);
+}
+
+TEST(WireFormat, Negotiation)
+{
+	EXPECT_TRUE(local_wire_capabilities() & 1);
+	EXPECT_EQ(negotiate_wire_compression(1), WireCompression::none);
+	EXPECT_EQ(negotiate_wire_compression(0), WireCompression::none);
+	EXPECT_EQ(
+	    negotiate_wire_compression(local_wire_capabilities()), supported_compressions().back());
+}
+
+TEST(WireFormat, RoundTrip)
+{
+	FlatProgramBytes const program(example_blocks());
+	for (auto const compression : supported_compressions()) {
+		auto const frame = encode_wire_frame(program, compression);
+		if (compression == WireCompression::lz4) {
+			EXPECT_LT(frame.size(), program.bytes.size());
+		}
+
+		FlatProgramBytes decoded;
+		decode_wire_frame(frame, decoded);
+		EXPECT_EQ(decoded, program);
+
+		std::vector<uint8_t> bytes;
+		decode_wire_frame(frame, bytes);
+		EXPECT_EQ(bytes, program.bytes);
+
+		FlatProgramBytes empty;
+		decode_wire_frame(encode_wire_frame(FlatProgramBytes(), compression), empty);
+		EXPECT_EQ(empty, FlatProgramBytes());
+
+		bytes.clear();
+		decoded = FlatProgramBytes();
+		decode_wire_frame(encode_wire_frame(program.bytes, compression), decoded);
+		EXPECT_EQ(decoded.num_blocks(), 1);
+		EXPECT_EQ(decoded.bytes, program.bytes);
+	}
+}
+
+TEST(WireFormat, Malformed)
+{
+	FlatProgramBytes const program(example_blocks());
+	for (auto const compression : supported_compressions()) {
+		auto const frame = encode_wire_frame(program, compression);
+		FlatProgramBytes decoded;
+
+		EXPECT_THROW(decode_wire_frame(std::vector<uint8_t>(), decoded), std::runtime_error);
+
+		auto truncated = frame;
+		truncated.pop_back();
+		EXPECT_THROW(decode_wire_frame(truncated, decoded), std::runtime_error);
+
+		auto trailing = frame;
+		trailing.push_back(0);
+		EXPECT_THROW(decode_wire_frame(trailing, decoded), std::runtime_error);
+
+		auto wrong_magic = frame;
+		wrong_magic.at(0) ^= 0xff;
+		EXPECT_THROW(decode_wire_frame(wrong_magic, decoded), std::runtime_error);
+
+		// size of first block stored after the 32 byte header
+		auto wrong_block_size = frame;
+		wrong_block_size.at(32) ^= 0x01;
+		EXPECT_THROW(decode_wire_frame(wrong_block_size, decoded), std::runtime_error);
+	}
+}
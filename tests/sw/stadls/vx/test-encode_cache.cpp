@@ -0,0 +1,136 @@
+#include <thread>
+#include <gtest/gtest.h>
+
+#include "haldls/vx/capmem.h"
+#include "haldls/vx/pll.h"
+#include "stadls/vx/encode_cache.h"
+#include "stadls/vx/playback_program.h"
+#include "stadls/vx/playback_program_builder.h"
+
+using namespace halco::hicann_dls::vx;
+using namespace haldls::vx;
+using namespace stadls::vx;
+
+class EncodeCacheTest : public ::testing::Test
+{
+protected:
+	void SetUp() override
+	{
+		EncodeCache::set_enabled(true);
+		EncodeCache::set_max_size(EncodeCache::default_max_size);
+		EncodeCache::clear();
+		EncodeCache::reset_statistics();
+	}
+
+	void TearDown() override
+	{
+		EncodeCache::set_enabled(false);
+		EncodeCache::set_max_size(EncodeCache::default_max_size);
+		EncodeCache::clear();
+		EncodeCache::reset_statistics();
+	}
+};
+
+TEST(EncodeCache, DisabledByDefault)
+{
+	EXPECT_FALSE(EncodeCache::get_enabled());
+
+	EncodeCache::reset_statistics();
+	PlaybackProgramBuilder builder;
+	builder.write(ADPLLOnDLS(), ADPLL());
+	builder.write(ADPLLOnDLS(), ADPLL());
+	EXPECT_EQ(EncodeCache::get_statistics().misses, 0u);
+	EXPECT_EQ(EncodeCache::get_statistics().hits, 0u);
+}
+
+TEST_F(EncodeCacheTest, HitsAndMisses)
+{
+	PlaybackProgramBuilder builder;
+	builder.write(ADPLLOnDLS(), ADPLL());
+	builder.write(ADPLLOnDLS(), ADPLL());
+	builder.write(CapMemBlockConfigOnDLS(), CapMemBlockConfig());
+
+	auto statistics = EncodeCache::get_statistics();
+	EXPECT_EQ(statistics.misses, 2u);
+	EXPECT_EQ(statistics.hits, 1u);
+	EXPECT_EQ(statistics.size, 2u);
+
+	// different content is a different entry
+	ADPLL adpll;
+	adpll.set_enable(!adpll.get_enable());
+	builder.write(ADPLLOnDLS(), adpll);
+	statistics = EncodeCache::get_statistics();
+	EXPECT_EQ(statistics.misses, 3u);
+	EXPECT_EQ(statistics.size, 3u);
+
+	// containers not in the cacheable list are not counted
+	builder.write(CapMemCellOnDLS(), CapMemCell());
+	EXPECT_EQ(EncodeCache::get_statistics().misses, 3u);
+
+	EncodeCache::clear();
+	EXPECT_EQ(EncodeCache::get_statistics().size, 0u);
+}
+
+TEST_F(EncodeCacheTest, EqualProgram)
+{
+	auto const build = []() {
+		PlaybackProgramBuilder builder;
+		builder.write(ADPLLOnDLS(), ADPLL());
+		builder.write(CapMemBlockConfigOnDLS(), CapMemBlockConfig());
+		builder.write(ADPLLOnDLS(), ADPLL());
+		return builder.done();
+	};
+
+	EncodeCache::set_enabled(false);
+	auto const uncached = build();
+	EXPECT_EQ(EncodeCache::get_statistics().misses, 0u);
+
+	EncodeCache::set_enabled(true);
+	auto const cached = build();
+	EXPECT_EQ(cached, uncached);
+	EXPECT_EQ(EncodeCache::get_statistics().hits, 1u);
+}
+
+TEST_F(EncodeCacheTest, MaxSize)
+{
+	EncodeCache::set_max_size(1);
+	EXPECT_EQ(EncodeCache::get_max_size(), 1u);
+
+	PlaybackProgramBuilder builder;
+	builder.write(ADPLLOnDLS(), ADPLL());
+	builder.write(CapMemBlockConfigOnDLS(), CapMemBlockConfig());
+	builder.write(CapMemBlockConfigOnDLS(), CapMemBlockConfig());
+
+	auto const statistics = EncodeCache::get_statistics();
+	EXPECT_EQ(statistics.size, 1u);
+	EXPECT_EQ(statistics.misses, 3u);
+	EXPECT_EQ(statistics.hits, 0u);
+}
+
+TEST_F(EncodeCacheTest, PerThread)
+{
+	auto const write_twice = []() {
+		PlaybackProgramBuilder builder;
+		builder.write(ADPLLOnDLS(), ADPLL());
+		builder.write(ADPLLOnDLS(), ADPLL());
+	};
+
+	write_twice();
+	std::thread(write_twice).join();
+
+	// entries are not shared between threads
+	auto statistics = EncodeCache::get_statistics();
+	EXPECT_EQ(statistics.misses, 2u);
+	EXPECT_EQ(statistics.hits, 2u);
+	// entries of finished threads are released
+	EXPECT_EQ(statistics.size, 1u);
+
+	// clear drops entries of all threads
+	EncodeCache::clear();
+	EncodeCache::reset_statistics();
+	write_twice();
+	statistics = EncodeCache::get_statistics();
+	EXPECT_EQ(statistics.misses, 1u);
+	EXPECT_EQ(statistics.hits, 1u);
+	EXPECT_EQ(statistics.size, 1u);
+}
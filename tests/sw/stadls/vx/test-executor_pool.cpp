@@ -0,0 +1,33 @@
+#include <gtest/gtest.h>
+
+#include "stadls/vx/executor_pool.h"
+#include "stadls/vx/playback_program.h"
+
+using namespace stadls::vx;
+
+TEST(ExecutorPool, WithoutBackends)
+{
+	ExecutorPool pool;
+	EXPECT_EQ(pool.size(), 0u);
+	EXPECT_TRUE(pool.get_utilization().empty());
+
+	PlaybackProgram program;
+	EXPECT_THROW(pool.run_async(program), std::runtime_error);
+	EXPECT_NO_THROW(pool.wait_all());
+}
+
+TEST(ExecutorPool, AddUnconnectedExecutor)
+{
+	ExecutorPool pool;
+	EXPECT_THROW(pool.add(PlaybackProgramExecutor()), std::runtime_error);
+	EXPECT_EQ(pool.size(), 0u);
+}
+
+TEST(ExecutorPool, UtilizationFraction)
+{
+	ExecutorPool::Utilization utilization{ExecutorBackend::simulation, 2, 0.5, 2.};
+	EXPECT_DOUBLE_EQ(utilization.get_fraction(), 0.25);
+
+	utilization.total_time = 0.;
+	EXPECT_DOUBLE_EQ(utilization.get_fraction(), 0.);
+}
@@ -0,0 +1,100 @@
+#include <algorithm>
+#include <random>
+#include <gtest/gtest.h>
+
+#include "haldls/vx/event.h"
+#include "stadls/vx/merge_spikes.h"
+#include "stadls/vx/playback_program.h"
+
+using namespace haldls::vx;
+using namespace stadls::vx;
+
+namespace {
+
+SpikeView make_spikes(std::vector<std::pair<uint16_t, uint64_t>> const& spikes)
+{
+	auto storage = std::make_shared<SpikeView::storage_type>();
+	for (auto const& [label, time] : spikes) {
+		storage->push_back(SpikeFromChip(SpikeLabel(label), FPGATime(time), ChipTime(time)));
+	}
+	return SpikeView(storage);
+}
+
+} // namespace
+
+TEST(merge_spikes, General)
+{
+	auto const a = make_spikes({{1, 0}, {1, 10}, {1, 20}});
+	auto const b = make_spikes({{2, 5}, {2, 10}});
+
+	auto const merged = merge_spikes({a, b});
+	EXPECT_EQ(merged.get_labels(), (std::vector<SpikeColumns::label_type>{1, 2, 1, 2, 1}));
+	EXPECT_EQ(merged.get_fpga_times(), (std::vector<SpikeColumns::time_type>{0, 5, 10, 10, 20}));
+	EXPECT_EQ(merged.get_chip_times(), (std::vector<SpikeColumns::time_type>{0, 5, 10, 10, 20}));
+
+	// second sequence shifted behind the first one
+	auto const shifted = merge_spikes({a, b}, {FPGATime(0), FPGATime(100)});
+	EXPECT_EQ(shifted.get_labels(), (std::vector<SpikeColumns::label_type>{1, 1, 1, 2, 2}));
+	EXPECT_EQ(
+	    shifted.get_fpga_times(), (std::vector<SpikeColumns::time_type>{0, 10, 20, 105, 110}));
+
+	EXPECT_TRUE(merge_spikes(std::vector<SpikeView>{}).empty());
+	EXPECT_TRUE(merge_spikes({SpikeView(), SpikeView()}, {}, 4).empty());
+	EXPECT_THROW(merge_spikes({a, b}, {FPGATime(0)}), std::invalid_argument);
+	EXPECT_THROW(merge_spikes({make_spikes({{1, 10}, {1, 0}})}), std::invalid_argument);
+	EXPECT_THROW(
+	    merge_spikes(std::vector<PlaybackProgram const*>{nullptr}), std::invalid_argument);
+
+	PlaybackProgram const program;
+	EXPECT_TRUE(merge_spikes(std::vector<PlaybackProgram const*>{&program, &program}).empty());
+}
+
+TEST(merge_spikes, Parallel)
+{
+	constexpr size_t num_sequences = 7;
+	constexpr size_t sequence_size = 10000;
+
+	std::mt19937 gen(1234);
+	std::uniform_int_distribution<uint64_t> time_distribution(0, 1000);
+	std::vector<SpikeView> spikes;
+	std::vector<FPGATime> offsets;
+	for (size_t i = 0; i < num_sequences; ++i) {
+		std::vector<std::pair<uint16_t, uint64_t>> sequence;
+		for (size_t j = 0; j < sequence_size; ++j) {
+			sequence.emplace_back(i, time_distribution(gen));
+		}
+		std::sort(sequence.begin(), sequence.end(), [](auto const& a, auto const& b) {
+			return a.second < b.second;
+		});
+		spikes.push_back(make_spikes(sequence));
+		offsets.push_back(FPGATime(i * 100));
+	}
+
+	auto const expected = merge_spikes(spikes, offsets, 1);
+	EXPECT_EQ(expected.size(), num_sequences * sequence_size);
+	EXPECT_TRUE(std::is_sorted(expected.get_fpga_times().begin(), expected.get_fpga_times().end()));
+
+	// equal to concatenation and stable sort, i.e. co-temporal spikes ordered by sequence
+	std::vector<SpikeFromChip> concatenated;
+	for (size_t i = 0; i < num_sequences; ++i) {
+		for (auto spike : spikes[i]) {
+			spike.set_fpga_time(FPGATime(spike.get_fpga_time().value() + offsets[i].value()));
+			concatenated.push_back(spike);
+		}
+	}
+	std::stable_sort(concatenated.begin(), concatenated.end(), [](auto const& a, auto const& b) {
+		return a.get_fpga_time() < b.get_fpga_time();
+	});
+	ASSERT_EQ(expected.size(), concatenated.size());
+	for (size_t i = 0; i < concatenated.size(); ++i) {
+		ASSERT_EQ(expected.get_fpga_times()[i], concatenated[i].get_fpga_time().value());
+		ASSERT_EQ(expected.get_labels()[i], concatenated[i].get_label().value());
+	}
+
+	for (size_t thread_count : {2, 3, 8, 64}) {
+		auto const merged = merge_spikes(spikes, offsets, thread_count);
+		EXPECT_EQ(merged.get_labels(), expected.get_labels()) << thread_count;
+		EXPECT_EQ(merged.get_fpga_times(), expected.get_fpga_times()) << thread_count;
+		EXPECT_EQ(merged.get_chip_times(), expected.get_chip_times()) << thread_count;
+	}
+}
@@ -0,0 +1,180 @@
+#include <gtest/gtest.h>
+
+#include "haldls/vx/capmem.h"
+#include "haldls/vx/event.h"
+#include "haldls/vx/timer.h"
+#include "stadls/vx/executor_pool.h"
+#include "stadls/vx/playback_program.h"
+#include "stadls/vx/playback_program_builder.h"
+#include "stadls/vx/playback_program_executor.h"
+
+#include "halco/common/iter_all.h"
+
+using namespace halco::common;
+using namespace halco::hicann_dls::vx;
+using namespace haldls::vx;
+using namespace stadls::vx;
+
+TEST(PlaybackProgramExecutor, MockReads)
+{
+	PlaybackProgramExecutor executor;
+	executor.connect_mock();
+	EXPECT_EQ(executor.get_backend(), ExecutorBackend::mock);
+
+	PlaybackProgramBuilder builder;
+	builder.write(TimerOnDLS(), Timer());
+	builder.wait_until(TimerOnDLS(), Timer::Value(100));
+	auto const ticket = builder.read(CapMemCellOnDLS());
+	auto const batch_ticket =
+	    builder.read_many(std::vector<CapMemCellOnDLS>{CapMemCellOnDLS(), CapMemCellOnDLS()});
+	auto program = builder.done();
+
+	EXPECT_FALSE(ticket.valid());
+	executor.run(program);
+	EXPECT_TRUE(ticket.valid());
+	EXPECT_TRUE(batch_ticket.valid());
+	EXPECT_EQ(ticket.get_fpga_time(), FPGATime(100));
+	EXPECT_EQ(batch_ticket.get().size(), 2u);
+
+	// mocked data is deterministic
+	auto const first = ticket.get();
+	executor.run(program);
+	EXPECT_EQ(ticket.get(), first);
+
+	auto const timings = executor.get_timings();
+	EXPECT_EQ(timings.program_count, 2u);
+	EXPECT_GE(timings.mock_response_duration, 0.);
+
+	executor.reset_timings();
+	EXPECT_EQ(executor.get_timings().program_count, 0u);
+}
+
+TEST(PlaybackProgramExecutor, MockRunAsyncSameProgram)
+{
+	PlaybackProgramExecutor executor;
+	executor.connect_mock();
+
+	PlaybackProgramBuilder builder;
+	auto const ticket = builder.read(CapMemCellOnDLS());
+	auto const program = builder.done();
+
+	executor.run(program);
+	auto const expected = ticket.get();
+
+	// enqueueing the program again doesn't reset results of executions in flight, results are
+	// only reset by the submission thread right before the next execution
+	std::vector<std::future<PlaybackProgram>> futures;
+	for (size_t i = 0; i < 10; ++i) {
+		futures.push_back(executor.run_async(program));
+	}
+	for (auto& future : futures) {
+		EXPECT_NO_THROW(future.get());
+	}
+	EXPECT_TRUE(ticket.valid());
+	EXPECT_EQ(ticket.get(), expected);
+	EXPECT_EQ(executor.get_timings().program_count, futures.size() + 1);
+}
+
+TEST(PlaybackProgramExecutor, MockSpikeEcho)
+{
+	PlaybackProgramExecutor executor;
+	executor.connect_mock();
+
+	PlaybackProgramBuilder builder(ExecutorBackend::mock);
+	builder.write(TimerOnDLS(), Timer());
+	builder.wait_until(TimerOnDLS(), Timer::Value(10));
+	builder.write(
+	    SpikePack1ToChipOnDLS(), SpikePack1ToChip(SpikePack1ToChip::labels_type{SpikeLabel(1)}));
+	builder.wait_until(TimerOnDLS(), Timer::Value(20));
+	builder.write(
+	    SpikePack2ToChipOnDLS(),
+	    SpikePack2ToChip(SpikePack2ToChip::labels_type{SpikeLabel(2), SpikeLabel(3)}));
+	auto program = builder.done();
+	EXPECT_EQ(program.get_executable_restriction(), ExecutorBackend::mock);
+
+	executor.run(program);
+
+	auto const spikes = program.get_spikes();
+	ASSERT_EQ(spikes.size(), 3u);
+	EXPECT_EQ(spikes.at(0).get_label(), SpikeLabel(1));
+	EXPECT_EQ(spikes.at(0).get_fpga_time(), FPGATime(10));
+	EXPECT_EQ(spikes.at(1).get_label(), SpikeLabel(2));
+	EXPECT_EQ(spikes.at(2).get_label(), SpikeLabel(3));
+	EXPECT_EQ(spikes.at(2).get_fpga_time(), FPGATime(20));
+
+	// views share the spike storage
+	EXPECT_EQ(program.get_spikes().data(), spikes.data());
+
+	auto const columns = program.get_spike_columns();
+	ASSERT_EQ(columns.size(), spikes.size());
+	for (size_t i = 0; i < spikes.size(); ++i) {
+		EXPECT_EQ(columns.get_labels().at(i), spikes.at(i).get_label().value());
+		EXPECT_EQ(columns.get_fpga_times().at(i), spikes.at(i).get_fpga_time().value());
+		EXPECT_EQ(columns.get_chip_times().at(i), spikes.at(i).get_chip_time().value());
+	}
+	EXPECT_EQ(program.get_spike_columns().get_labels().data(), columns.get_labels().data());
+	EXPECT_TRUE(program.get_madc_sample_columns().empty());
+}
+
+TEST(ExecutorPool, Mock)
+{
+	constexpr size_t num_backends = 3;
+	constexpr size_t num_programs = 10;
+
+	ExecutorPool pool;
+	for (size_t i = 0; i < num_backends; ++i) {
+		pool.connect_mock();
+	}
+	EXPECT_EQ(pool.size(), num_backends);
+
+	std::vector<PlaybackProgram::ContainerTicket<CapMemCell>> tickets;
+	std::vector<PlaybackProgram> programs;
+	for (size_t i = 0; i < num_programs; ++i) {
+		PlaybackProgramBuilder builder(
+		    (i % 2) ? ExecutorBackend::hardware : ExecutorBackend::simulation);
+		tickets.push_back(builder.read(CapMemCellOnDLS()));
+		programs.push_back(builder.done());
+	}
+
+	pool.run(programs);
+
+	for (auto const& ticket : tickets) {
+		EXPECT_TRUE(ticket.valid());
+	}
+
+	size_t executed = 0;
+	for (auto const& utilization : pool.get_utilization()) {
+		EXPECT_EQ(utilization.backend, ExecutorBackend::mock);
+		executed += utilization.programs;
+	}
+	EXPECT_EQ(executed, num_programs);
+}
+
+TEST(ExecutorPool, MockSameProgram)
+{
+	ExecutorPool pool;
+	pool.connect_mock();
+	pool.connect_mock();
+
+	PlaybackProgramBuilder builder;
+	auto const ticket = builder.read(CapMemCellOnDLS());
+	auto const program = builder.done();
+	auto const copy = program;
+
+	// submissions sharing the program data are executed one after another
+	std::vector<std::future<PlaybackProgram>> futures;
+	futures.push_back(pool.run_async(program));
+	futures.push_back(pool.run_async(program));
+	futures.push_back(pool.run_async(copy));
+	for (auto& future : futures) {
+		EXPECT_NO_THROW(future.get());
+	}
+	pool.wait_all();
+
+	EXPECT_TRUE(ticket.valid());
+	size_t executed = 0;
+	for (auto const& utilization : pool.get_utilization()) {
+		executed += utilization.programs;
+	}
+	EXPECT_EQ(executed, futures.size());
+}
@@ -0,0 +1,51 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+#include "haldls/vx/capmem.h"
+#include "haldls/vx/timer.h"
+#include "stadls/vx/playback_program.h"
+#include "stadls/vx/playback_program_builder.h"
+
+using namespace halco::hicann_dls::vx;
+using namespace haldls::vx;
+using namespace stadls::vx;
+
+TEST(PlaybackProgram, SaveLoad)
+{
+	std::string const filename = ::testing::TempDir() + "stadls_vx_playback_program.bin";
+
+	PlaybackProgramBuilder builder(ExecutorBackend::simulation);
+	builder.write(CapMemCellOnDLS(), CapMemCell(CapMemCell::Value(123)));
+	builder.write(TimerOnDLS(), Timer());
+	builder.wait_until(TimerOnDLS(), Timer::Value(100));
+	auto const program = builder.done();
+
+	program.save(filename);
+	auto const loaded = PlaybackProgram::load(filename);
+	EXPECT_EQ(loaded, program);
+	EXPECT_EQ(loaded.get_executable_restriction(), ExecutorBackend::simulation);
+
+	PlaybackProgram const unrestricted;
+	unrestricted.save(filename);
+	EXPECT_EQ(PlaybackProgram::load(filename).get_executable_restriction(), std::nullopt);
+
+	std::remove(filename.c_str());
+}
+
+TEST(PlaybackProgram, LoadInvalid)
+{
+	std::string const filename = ::testing::TempDir() + "stadls_vx_playback_program_invalid.bin";
+
+	EXPECT_THROW(PlaybackProgram::load(filename), std::runtime_error);
+
+	{
+		std::ofstream file(filename, std::ios::binary);
+		file << "no program";
+	}
+	EXPECT_THROW(PlaybackProgram::load(filename), std::runtime_error);
+
+	std::remove(filename.c_str());
+}
@@ -2,8 +2,13 @@
 
 #include "stadls/vx/playback_program_builder.h"
 
+#include "halco/common/iter_all.h"
 #include "haldls/vx/capmem.h"
+#include "haldls/vx/event.h"
 #include "haldls/vx/padi.h"
+#include "haldls/vx/reset.h"
+#include "haldls/vx/timer.h"
+#include "lola/vx/synapse.h"
 
 using namespace stadls::vx;
 using namespace haldls::vx;
@@ -70,3 +75,220 @@ TEST(PlaybackProgramBuilder, ExecutableRestriction)
 		EXPECT_EQ(*(program.get_executable_restriction()), ExecutorBackend::simulation);
 	}
 }
+
+TEST(PlaybackProgramBuilder, WriteMany)
+{
+	std::vector<CapMemCellOnDLS> coords;
+	std::vector<CapMemCell> configs;
+	PlaybackProgramBuilder builder;
+	size_t i = 0;
+	for (auto const coord : halco::common::iter_all<CapMemCellOnDLS>()) {
+		CapMemCell const config(CapMemCell::Value(i++ % CapMemCell::Value::size));
+		coords.push_back(coord);
+		configs.push_back(config);
+		builder.write(coord, config);
+	}
+	auto const program = builder.done();
+
+	PlaybackProgramBuilder builder_many;
+	builder_many.write_many(coords, configs);
+	auto const program_many = builder_many.done();
+
+	EXPECT_EQ(program, program_many);
+
+	coords.pop_back();
+	EXPECT_THROW(builder_many.write_many(coords, configs), std::runtime_error);
+}
+
+TEST(PlaybackProgramBuilder, ReadManyExecutableRestriction)
+{
+	PlaybackProgramBuilder builder;
+	auto const ticket =
+	    builder.read_many(std::vector<CrossbarNodeOnDLS>{CrossbarNodeOnDLS(), CrossbarNodeOnDLS()});
+	EXPECT_EQ(ticket.size(), 2u);
+	EXPECT_FALSE(ticket.valid());
+	auto const program = builder.done();
+	EXPECT_TRUE(program.get_executable_restriction());
+	EXPECT_EQ(*(program.get_executable_restriction()), ExecutorBackend::simulation);
+}
+
+TEST(PlaybackProgramBuilder, ReadManyEmpty)
+{
+	PlaybackProgramBuilder builder;
+	auto const ticket = builder.read_many(std::vector<CapMemCellOnDLS>{});
+	EXPECT_TRUE(builder.empty());
+	EXPECT_EQ(ticket.size(), 0u);
+	EXPECT_TRUE(ticket.valid());
+	EXPECT_TRUE(ticket.get().empty());
+	EXPECT_EQ(builder.done(), PlaybackProgramBuilder().done());
+	EXPECT_TRUE(ticket.valid());
+}
+
+TEST(PlaybackProgramBuilder, DecodeAllWithoutResults)
+{
+	PlaybackProgramBuilder builder;
+	auto const ticket = builder.read(CapMemCellOnDLS());
+	auto program = builder.done();
+
+	EXPECT_NO_THROW(program.decode_all(2));
+	EXPECT_FALSE(ticket.valid());
+	EXPECT_THROW(ticket.get(), std::runtime_error);
+}
+
+TEST(PlaybackProgramBuilder, ShadowState)
+{
+	PlaybackProgramBuilder builder;
+	EXPECT_FALSE(builder.get_enable_shadow_state());
+	builder.set_enable_shadow_state(true);
+	EXPECT_TRUE(builder.get_enable_shadow_state());
+
+	CapMemBlock block;
+	builder.write(CapMemBlockOnDLS(), block);
+	auto const program_full = builder.done();
+	EXPECT_NE(program_full, PlaybackProgramBuilder().done());
+
+	// unchanged data is not written again, also over program boundaries
+	builder.write(CapMemBlockOnDLS(), block);
+	EXPECT_TRUE(builder.empty());
+
+	// only changed words are written, equal to an explicit differential write
+	auto changed_block = block;
+	changed_block.set_cell(CapMemCellOnCapMemBlock(), CapMemCell::Value(123));
+	builder.write(CapMemBlockOnDLS(), changed_block);
+	auto const program_shadowed = builder.done();
+
+	PlaybackProgramBuilder builder_differential;
+	builder_differential.write(CapMemBlockOnDLS(), changed_block, block);
+	EXPECT_EQ(program_shadowed, builder_differential.done());
+
+	// chip reset invalidates the shadow state
+	builder.write(ResetChipOnDLS(), ResetChip());
+	builder.write(CapMemBlockOnDLS(), changed_block);
+	auto const program_reset = builder.done();
+
+	PlaybackProgramBuilder builder_reset;
+	builder_reset.write(ResetChipOnDLS(), ResetChip());
+	builder_reset.write(CapMemBlockOnDLS(), changed_block);
+	EXPECT_EQ(program_reset, builder_reset.done());
+
+	// explicit reset of shadow state leads to complete write
+	builder.reset_shadow_state();
+	builder.write(CapMemBlockOnDLS(), changed_block);
+	EXPECT_FALSE(builder.empty());
+	builder.done();
+
+	builder.set_enable_shadow_state(false);
+	builder.write(CapMemBlockOnDLS(), changed_block);
+	builder.write(CapMemBlockOnDLS(), changed_block);
+	PlaybackProgramBuilder builder_unshadowed;
+	builder_unshadowed.write(CapMemBlockOnDLS(), changed_block);
+	builder_unshadowed.write(CapMemBlockOnDLS(), changed_block);
+	EXPECT_EQ(builder.done(), builder_unshadowed.done());
+}
+
+TEST(PlaybackProgramBuilder, ShadowStateAliasingBackends)
+{
+	PlaybackProgramBuilder builder;
+	builder.set_enable_shadow_state(true);
+
+	CapMemCell const cell(CapMemCell::Value(123));
+	CapMemCell const other_cell(CapMemCell::Value(321));
+	builder.write(CapMemCellOnDLS(), cell, Backend::OmnibusChip);
+	builder.done();
+
+	// the write via JTAG changes the location also for the omnibus backend
+	builder.write(CapMemCellOnDLS(), other_cell, Backend::OmnibusChipOverJTAG);
+	builder.done();
+
+	// writing the initial value via omnibus again is therefore not dropped
+	builder.write(CapMemCellOnDLS(), cell, Backend::OmnibusChip);
+	EXPECT_FALSE(builder.empty());
+	auto const program = builder.done();
+
+	PlaybackProgramBuilder builder_unshadowed;
+	builder_unshadowed.write(CapMemCellOnDLS(), cell, Backend::OmnibusChip);
+	EXPECT_EQ(program, builder_unshadowed.done());
+
+	// same in the other direction
+	builder.write(CapMemCellOnDLS(), other_cell, Backend::OmnibusChipOverJTAG);
+	builder.done();
+	builder.write(CapMemCellOnDLS(), cell, Backend::OmnibusChip);
+	builder.done();
+	builder.write(CapMemCellOnDLS(), other_cell, Backend::OmnibusChipOverJTAG);
+	EXPECT_FALSE(builder.empty());
+}
+
+TEST(PlaybackProgramBuilder, WriteSynapseMatrixDelta)
+{
+	auto base_ptr = std::make_unique<lola::vx::SynapseMatrix>();
+	auto target_ptr = std::make_unique<lola::vx::SynapseMatrix>();
+	auto const& base = *base_ptr;
+	auto& target = *target_ptr;
+
+	// empty delta adds no instructions
+	PlaybackProgramBuilder builder;
+	builder.write(lola::vx::SynapseMatrixDeltaOnDLS(), lola::vx::SynapseMatrixDelta());
+	EXPECT_TRUE(builder.empty());
+
+	target.weights[SynapseRowOnSynram(12)][SynapseOnSynapseRow(23)] =
+	    lola::vx::SynapseMatrix::Weight(42);
+	target.addresses[SynapseRowOnSynram(200)][SynapseOnSynapseRow(5)] =
+	    lola::vx::SynapseMatrix::Address(17);
+	lola::vx::SynapseMatrixDelta const delta(base, target);
+	EXPECT_EQ(delta.size(), 2);
+
+	// delta is equal to writing the affected quads
+	builder.write(lola::vx::SynapseMatrixDeltaOnDLS(), delta);
+	PlaybackProgramBuilder builder_quads;
+	for (auto const quad : delta.get_quads()) {
+		builder_quads.write(SynapseQuadOnDLS(quad, SynramOnDLS()), delta.get(quad));
+	}
+	EXPECT_EQ(builder.done(), builder_quads.done());
+
+	// delta is not readable
+	EXPECT_THROW(builder.read(lola::vx::SynapseMatrixDeltaOnDLS()), std::runtime_error);
+}
+
+TEST(PlaybackProgramBuilder, WriteSpikeTrain)
+{
+	std::vector<Timer::Value> const times{
+	    Timer::Value(10), Timer::Value(10), Timer::Value(10), Timer::Value(10), Timer::Value(20),
+	    Timer::Value(30), Timer::Value(30)};
+	std::vector<SpikeLabel> const labels{SpikeLabel(1), SpikeLabel(2), SpikeLabel(3), SpikeLabel(4),
+	                                     SpikeLabel(5), SpikeLabel(6), SpikeLabel(7)};
+
+	PlaybackProgramBuilder builder;
+	builder.write_spike_train(times, labels);
+	auto const program = builder.done();
+
+	PlaybackProgramBuilder expected_builder;
+	expected_builder.wait_until(TimerOnDLS(), Timer::Value(10));
+	expected_builder.write(
+	    SpikePack3ToChipOnDLS(), SpikePack3ToChip(SpikePack3ToChip::labels_type{
+	                                 SpikeLabel(1), SpikeLabel(2), SpikeLabel(3)}));
+	expected_builder.write(
+	    SpikePack1ToChipOnDLS(), SpikePack1ToChip(SpikePack1ToChip::labels_type{SpikeLabel(4)}));
+	expected_builder.wait_until(TimerOnDLS(), Timer::Value(20));
+	expected_builder.write(
+	    SpikePack1ToChipOnDLS(), SpikePack1ToChip(SpikePack1ToChip::labels_type{SpikeLabel(5)}));
+	expected_builder.wait_until(TimerOnDLS(), Timer::Value(30));
+	expected_builder.write(
+	    SpikePack2ToChipOnDLS(),
+	    SpikePack2ToChip(SpikePack2ToChip::labels_type{SpikeLabel(6), SpikeLabel(7)}));
+	EXPECT_EQ(program, expected_builder.done());
+
+	std::vector<uint64_t> const raw_times{10, 10, 10, 10, 20, 30, 30};
+	std::vector<uint16_t> const raw_labels{1, 2, 3, 4, 5, 6, 7};
+	builder.write_spike_train(raw_times.data(), raw_labels.data(), raw_times.size());
+	EXPECT_EQ(builder.done(), program);
+
+	EXPECT_THROW(
+	    builder.write_spike_train(times, std::vector<SpikeLabel>{SpikeLabel(1)}),
+	    std::runtime_error);
+	EXPECT_THROW(
+	    builder.write_spike_train(
+	        std::vector<Timer::Value>{Timer::Value(20), Timer::Value(10)},
+	        std::vector<SpikeLabel>{SpikeLabel(1), SpikeLabel(2)}),
+	    std::runtime_error);
+	EXPECT_TRUE(builder.empty());
+}
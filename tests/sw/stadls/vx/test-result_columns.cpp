@@ -0,0 +1,48 @@
+#include <gtest/gtest.h>
+
+#include "stadls/vx/result_columns.h"
+
+using namespace stadls::vx;
+
+TEST(SpikeColumns, General)
+{
+	SpikeColumns const empty_columns;
+	EXPECT_TRUE(empty_columns.empty());
+	EXPECT_EQ(empty_columns.size(), 0);
+
+	auto storage = std::make_shared<SpikeColumns::Storage>();
+	storage->labels = {1, 2, 3};
+	storage->fpga_times = {10, 20, 30};
+	storage->chip_times = {4, 5, 6};
+
+	SpikeColumns const columns(storage);
+	EXPECT_FALSE(columns.empty());
+	EXPECT_EQ(columns.size(), 3);
+	EXPECT_EQ(columns.get_labels().data(), storage->labels.data());
+	EXPECT_EQ(columns.get_fpga_times().at(1), 20);
+	EXPECT_EQ(columns.get_chip_times().at(2), 6);
+
+	storage->chip_times.pop_back();
+	EXPECT_THROW(SpikeColumns{storage}, std::logic_error);
+	EXPECT_THROW(SpikeColumns{nullptr}, std::logic_error);
+}
+
+TEST(MADCSampleColumns, General)
+{
+	MADCSampleColumns const empty_columns;
+	EXPECT_TRUE(empty_columns.empty());
+	EXPECT_EQ(empty_columns.size(), 0);
+
+	auto storage = std::make_shared<MADCSampleColumns::Storage>();
+	storage->values = {100, 200};
+	storage->fpga_times = {10, 20};
+	storage->chip_times = {4, 5};
+
+	MADCSampleColumns const columns(storage);
+	EXPECT_EQ(columns.size(), 2);
+	EXPECT_EQ(columns.get_values().at(1), 200);
+	EXPECT_EQ(columns.get_fpga_times().data(), storage->fpga_times.data());
+
+	storage->values.push_back(300);
+	EXPECT_THROW(MADCSampleColumns{storage}, std::logic_error);
+}
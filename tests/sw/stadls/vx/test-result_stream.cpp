@@ -0,0 +1,184 @@
+#include <thread>
+#include <gtest/gtest.h>
+
+#include "haldls/vx/event.h"
+#include "haldls/vx/timer.h"
+#include "stadls/vx/playback_program.h"
+#include "stadls/vx/playback_program_builder.h"
+#include "stadls/vx/playback_program_executor.h"
+#include "stadls/vx/result_stream.h"
+
+using namespace halco::hicann_dls::vx;
+using namespace haldls::vx;
+using namespace stadls::vx;
+
+namespace {
+
+ResultStream::Chunk make_chunk(size_t const num_spikes)
+{
+	ResultStream::Chunk chunk;
+	for (size_t i = 0; i < num_spikes; ++i) {
+		chunk.spikes.push_back(SpikeFromChip(SpikeLabel(i), FPGATime(i), ChipTime(i)));
+	}
+	return chunk;
+}
+
+} // namespace
+
+TEST(ResultStream, General)
+{
+	EXPECT_THROW(ResultStream(0), std::invalid_argument);
+	EXPECT_THROW(ResultStream(1, 0), std::invalid_argument);
+
+	ResultStream stream(2);
+	EXPECT_EQ(stream.get_capacity(), 2);
+	EXPECT_EQ(stream.get_overflow_policy(), ResultStream::OverflowPolicy::block);
+	EXPECT_FALSE(stream.try_pop());
+
+	EXPECT_TRUE(stream.push(make_chunk(1)));
+	EXPECT_TRUE(stream.push(make_chunk(2)));
+	EXPECT_EQ(stream.size(), 2);
+
+	auto const first = stream.try_pop();
+	ASSERT_TRUE(first);
+	EXPECT_EQ(first->spikes.size(), 1);
+	auto const second = stream.pop();
+	ASSERT_TRUE(second);
+	EXPECT_EQ(second->spikes.size(), 2);
+	EXPECT_EQ(stream.size(), 0);
+
+	stream.close();
+	EXPECT_TRUE(stream.get_closed());
+	EXPECT_FALSE(stream.pop());
+	EXPECT_FALSE(stream.push(make_chunk(1)));
+
+	auto const statistics = stream.get_statistics();
+	EXPECT_EQ(statistics.pushed_chunks, 2);
+	EXPECT_EQ(statistics.popped_chunks, 2);
+	EXPECT_EQ(statistics.dropped_chunks, 1);
+	EXPECT_EQ(statistics.max_fill, 2);
+	EXPECT_EQ(statistics.spikes, 3);
+}
+
+TEST(ResultStream, Drop)
+{
+	ResultStream stream(1, ResultStream::default_chunk_size, ResultStream::OverflowPolicy::drop);
+	EXPECT_TRUE(stream.push(make_chunk(1)));
+	EXPECT_FALSE(stream.push(make_chunk(1)));
+	EXPECT_EQ(stream.get_statistics().dropped_chunks, 1);
+	EXPECT_EQ(stream.get_statistics().blocked_pushes, 0);
+}
+
+TEST(ResultStream, Block)
+{
+	constexpr size_t num_chunks = 1000;
+
+	ResultStream stream(4);
+	std::thread producer([&stream]() {
+		for (size_t i = 0; i < num_chunks; ++i) {
+			stream.push(make_chunk(i % 5));
+		}
+		stream.close();
+	});
+
+	size_t num_popped = 0;
+	size_t num_spikes = 0;
+	while (auto const chunk = stream.pop()) {
+		num_popped++;
+		num_spikes += chunk->spikes.size();
+	}
+	producer.join();
+
+	auto const statistics = stream.get_statistics();
+	EXPECT_EQ(num_popped, num_chunks);
+	EXPECT_EQ(statistics.dropped_chunks, 0);
+	EXPECT_EQ(statistics.spikes, num_spikes);
+	EXPECT_LE(statistics.max_fill, 4);
+}
+
+TEST(ResultStream, Executor)
+{
+	PlaybackProgramExecutor executor;
+	executor.connect_mock();
+	auto const stream = std::make_shared<ResultStream>(8, 2);
+	executor.set_result_stream(stream);
+	EXPECT_EQ(executor.get_result_stream(), stream);
+
+	PlaybackProgramBuilder builder(ExecutorBackend::mock);
+	builder.write(TimerOnDLS(), Timer());
+	builder.write(
+	    SpikePack3ToChipOnDLS(), SpikePack3ToChip(SpikePack3ToChip::labels_type{
+	                                 SpikeLabel(1), SpikeLabel(2), SpikeLabel(3)}));
+	auto program = builder.done();
+	executor.run(program);
+
+	// three spikes are split into chunks of at most two spikes
+	auto const first = stream->try_pop();
+	ASSERT_TRUE(first);
+	EXPECT_EQ(first->spikes.size(), 2);
+	auto const second = stream->try_pop();
+	ASSERT_TRUE(second);
+	ASSERT_EQ(second->spikes.size(), 1);
+	EXPECT_EQ(second->spikes.at(0).get_label(), SpikeLabel(3));
+	EXPECT_FALSE(stream->try_pop());
+
+	executor.set_result_stream(nullptr);
+	executor.run(program);
+	EXPECT_FALSE(stream->try_pop());
+}
+
+TEST(ResultStream, SingleProducer)
+{
+	auto const stream = std::make_shared<ResultStream>();
+
+	PlaybackProgramExecutor first;
+	first.connect_mock();
+	PlaybackProgramExecutor second;
+	second.connect_mock();
+
+	first.set_result_stream(stream);
+	// attaching the same stream again is a no-op
+	EXPECT_NO_THROW(first.set_result_stream(stream));
+	EXPECT_THROW(second.set_result_stream(stream), std::logic_error);
+	EXPECT_FALSE(second.get_result_stream());
+
+	first.set_result_stream(nullptr);
+	EXPECT_NO_THROW(second.set_result_stream(stream));
+	EXPECT_THROW(first.set_result_stream(stream), std::logic_error);
+}
+
+TEST(ResultStream, ExecutorBlocking)
+{
+	constexpr size_t num_programs = 10;
+
+	PlaybackProgramExecutor executor;
+	executor.connect_mock();
+	// results of a single program exceed the ring capacity
+	auto const stream = std::make_shared<ResultStream>(1, 1);
+	executor.set_result_stream(stream);
+
+	PlaybackProgramBuilder builder(ExecutorBackend::mock);
+	builder.write(TimerOnDLS(), Timer());
+	builder.write(
+	    SpikePack3ToChipOnDLS(), SpikePack3ToChip(SpikePack3ToChip::labels_type{
+	                                 SpikeLabel(1), SpikeLabel(2), SpikeLabel(3)}));
+	auto program = builder.done();
+
+	std::thread producer([&]() {
+		for (size_t i = 0; i < num_programs; ++i) {
+			executor.run(program);
+		}
+		stream->close();
+	});
+
+	size_t num_spikes = 0;
+	while (auto const chunk = stream->pop()) {
+		ASSERT_EQ(chunk->spikes.size(), 1);
+		EXPECT_EQ(chunk->spikes.at(0).get_label(), SpikeLabel(num_spikes % 3 + 1));
+		num_spikes++;
+	}
+	producer.join();
+
+	EXPECT_EQ(num_spikes, 3 * num_programs);
+	EXPECT_EQ(stream->get_statistics().dropped_chunks, 0);
+}
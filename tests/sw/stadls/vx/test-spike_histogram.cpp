@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+
+#include "haldls/vx/event.h"
+#include "haldls/vx/timer.h"
+#include "stadls/vx/playback_program.h"
+#include "stadls/vx/playback_program_builder.h"
+#include "stadls/vx/playback_program_executor.h"
+#include "stadls/vx/spike_histogram.h"
+
+using namespace halco::hicann_dls::vx;
+using namespace haldls::vx;
+using namespace stadls::vx;
+
+TEST(SpikeHistogram, General)
+{
+	typedef SpikeHistogram::labels_type labels_type;
+	typedef SpikeHistogram::bin_edges_type bin_edges_type;
+
+	EXPECT_THROW(
+	    SpikeHistogram(labels_type{}, bin_edges_type{FPGATime(0), FPGATime(1)}),
+	    std::invalid_argument);
+	EXPECT_THROW(
+	    SpikeHistogram(labels_type{SpikeLabel(1)}, bin_edges_type{FPGATime(0)}),
+	    std::invalid_argument);
+	EXPECT_THROW(
+	    SpikeHistogram(
+	        labels_type{SpikeLabel(1), SpikeLabel(1)}, bin_edges_type{FPGATime(0), FPGATime(1)}),
+	    std::invalid_argument);
+	EXPECT_THROW(
+	    SpikeHistogram(labels_type{SpikeLabel(1)}, bin_edges_type{FPGATime(1), FPGATime(1)}),
+	    std::invalid_argument);
+
+	// equidistant and non-equidistant bins
+	for (auto const& bin_edges :
+	     {bin_edges_type{FPGATime(10), FPGATime(20), FPGATime(30)},
+	      bin_edges_type{FPGATime(10), FPGATime(20), FPGATime(100)}}) {
+		SpikeHistogram histogram(labels_type{SpikeLabel(5), SpikeLabel(3)}, bin_edges);
+		EXPECT_EQ(histogram.get_num_labels(), 2);
+		EXPECT_EQ(histogram.get_num_bins(), 2);
+
+		histogram.add(SpikeLabel(5), FPGATime(10));
+		histogram.add(SpikeLabel(5), FPGATime(19));
+		histogram.add(SpikeLabel(3), FPGATime(20));
+		histogram.add(SpikeLabel(3), FPGATime(29));
+		// ignored
+		histogram.add(SpikeLabel(4), FPGATime(15));
+		histogram.add(SpikeLabel(5), FPGATime(9));
+		histogram.add(SpikeLabel(5), bin_edges.back());
+
+		EXPECT_EQ(histogram.get_count(0, 0), 2);
+		EXPECT_EQ(histogram.get_count(0, 1), 0);
+		EXPECT_EQ(histogram.get_count(1, 0), 0);
+		EXPECT_EQ(histogram.get_count(1, 1), 2);
+		EXPECT_EQ(histogram.get_num_ignored(), 3);
+		EXPECT_EQ(histogram.get_counts(), (std::vector<SpikeHistogram::count_type>{2, 0, 0, 2}));
+		EXPECT_THROW(histogram.get_count(2, 0), std::out_of_range);
+
+		histogram.reset();
+		EXPECT_EQ(histogram.get_counts(), (std::vector<SpikeHistogram::count_type>{0, 0, 0, 0}));
+		EXPECT_EQ(histogram.get_num_ignored(), 0);
+	}
+}
+
+TEST(SpikeHistogram, Executor)
+{
+	PlaybackProgramExecutor executor;
+	executor.connect_mock();
+
+	PlaybackProgramBuilder builder(ExecutorBackend::mock);
+	builder.write(TimerOnDLS(), Timer());
+	builder.write(
+	    SpikePack2ToChipOnDLS(),
+	    SpikePack2ToChip(SpikePack2ToChip::labels_type{SpikeLabel(1), SpikeLabel(2)}));
+	builder.wait_until(TimerOnDLS(), Timer::Value(100));
+	builder.write(
+	    SpikePack1ToChipOnDLS(), SpikePack1ToChip(SpikePack1ToChip::labels_type{SpikeLabel(1)}));
+	auto program = builder.done();
+
+	auto const histogram = std::make_shared<SpikeHistogram>(
+	    SpikeHistogram::labels_type{SpikeLabel(1), SpikeLabel(2)},
+	    SpikeHistogram::bin_edges_type{FPGATime(0), FPGATime(50), FPGATime(150)});
+	program.set_spike_histogram(histogram);
+	EXPECT_EQ(program.get_spike_histogram(), histogram);
+
+	executor.run(program);
+	EXPECT_EQ(histogram->get_counts(), (std::vector<SpikeHistogram::count_type>{1, 1, 1, 0}));
+
+	// counts accumulate over executions
+	executor.run(program);
+	EXPECT_EQ(histogram->get_counts(), (std::vector<SpikeHistogram::count_type>{2, 2, 2, 0}));
+}
@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+#include "haldls/vx/event.h"
+#include "haldls/vx/timer.h"
+#include "stadls/vx/playback_program.h"
+#include "stadls/vx/playback_program_builder.h"
+#include "stadls/vx/spike_train_file.h"
+
+using namespace halco::hicann_dls::vx;
+using namespace haldls::vx;
+using namespace stadls::vx;
+
+TEST(SpikeTrainFile, SaveLoad)
+{
+	std::string const filename = ::testing::TempDir() + "stadls_vx_spike_train_file.bin";
+
+	SpikeTrainFile::times_type const times{
+	    Timer::Value(10), Timer::Value(10), Timer::Value(10), Timer::Value(10), Timer::Value(20),
+	    Timer::Value(30), Timer::Value(30)};
+	SpikeTrainFile::labels_type const labels{SpikeLabel(1), SpikeLabel(2), SpikeLabel(3),
+	                                         SpikeLabel(4), SpikeLabel(5), SpikeLabel(6),
+	                                         SpikeLabel(7)};
+
+	SpikeTrainFile::save(filename, times, labels);
+	SpikeTrainFile const spike_train_file(filename);
+	EXPECT_EQ(spike_train_file.get_num_spikes(), times.size());
+	EXPECT_EQ(spike_train_file.get_num_packs(), 4u);
+	EXPECT_EQ(spike_train_file.get_end_time(), Timer::Value(30));
+
+	PlaybackProgramBuilder expected_builder;
+	expected_builder.write(TimerOnDLS(), Timer());
+	expected_builder.write_spike_train(times, labels);
+	auto const expected = expected_builder.done();
+
+	// splicing is repeatable and equivalent to encoding the spike train
+	for (size_t i = 0; i < 2; ++i) {
+		PlaybackProgramBuilder builder;
+		builder.write(TimerOnDLS(), Timer());
+		builder.write_spike_train(spike_train_file);
+		EXPECT_EQ(builder.done(), expected);
+	}
+
+	PlaybackProgramBuilder mock_builder(ExecutorBackend::mock);
+	mock_builder.write_spike_train(spike_train_file);
+	auto const mock_program = mock_builder.done();
+
+	PlaybackProgramBuilder expected_mock_builder(ExecutorBackend::mock);
+	expected_mock_builder.write_spike_train(times, labels);
+	auto const expected_mock_program = expected_mock_builder.done();
+	EXPECT_EQ(mock_program, expected_mock_program);
+
+	SpikeTrainFile::save(filename, {}, {});
+	SpikeTrainFile const empty(filename);
+	EXPECT_EQ(empty.get_num_spikes(), 0u);
+	PlaybackProgramBuilder empty_builder;
+	empty_builder.write_spike_train(empty);
+	EXPECT_TRUE(empty_builder.empty());
+
+	std::remove(filename.c_str());
+}
+
+TEST(SpikeTrainFile, Invalid)
+{
+	std::string const filename = ::testing::TempDir() + "stadls_vx_spike_train_file_invalid.bin";
+
+	EXPECT_THROW(
+	    SpikeTrainFile::save(filename, {Timer::Value(1)}, {SpikeLabel(1), SpikeLabel(2)}),
+	    std::runtime_error);
+	EXPECT_THROW(
+	    SpikeTrainFile::save(
+	        filename, {Timer::Value(2), Timer::Value(1)}, {SpikeLabel(1), SpikeLabel(2)}),
+	    std::runtime_error);
+
+	std::remove(filename.c_str());
+	EXPECT_THROW(SpikeTrainFile{filename}, std::runtime_error);
+
+	{
+		std::ofstream file(filename, std::ios::binary);
+		file << "no spike train";
+	}
+	EXPECT_THROW(SpikeTrainFile{filename}, std::runtime_error);
+
+	// truncated record
+	SpikeTrainFile::save(filename, {Timer::Value(1)}, {SpikeLabel(1)});
+	{
+		std::ofstream file(filename, std::ios::binary | std::ios::app);
+		file << "x";
+	}
+	EXPECT_THROW(SpikeTrainFile{filename}, std::runtime_error);
+
+	std::remove(filename.c_str());
+}
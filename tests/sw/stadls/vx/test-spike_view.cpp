@@ -0,0 +1,35 @@
+#include <algorithm>
+#include <gtest/gtest.h>
+
+#include "stadls/vx/spike_view.h"
+
+using namespace stadls::vx;
+using namespace haldls::vx;
+
+TEST(SpikeView, General)
+{
+	SpikeView const empty_view;
+	EXPECT_TRUE(empty_view.empty());
+	EXPECT_EQ(empty_view.size(), 0);
+	EXPECT_EQ(empty_view.begin(), empty_view.end());
+	EXPECT_THROW(empty_view.at(0), std::out_of_range);
+
+	auto storage = std::make_shared<SpikeView::storage_type>();
+	storage->push_back(SpikeFromChip(SpikeLabel(1), FPGATime(10), ChipTime(2)));
+	storage->push_back(SpikeFromChip(SpikeLabel(3), FPGATime(20), ChipTime(4)));
+
+	SpikeView const view(storage);
+	EXPECT_FALSE(view.empty());
+	EXPECT_EQ(view.size(), storage->size());
+	EXPECT_EQ(view.data(), storage->data());
+	EXPECT_EQ(view[1], storage->at(1));
+	EXPECT_EQ(view.at(0), storage->at(0));
+	EXPECT_THROW(view.at(2), std::out_of_range);
+	EXPECT_TRUE(std::equal(view.begin(), view.end(), storage->begin(), storage->end()));
+
+	// copies share the storage and keep it alive
+	auto const copy = view;
+	storage.reset();
+	EXPECT_EQ(copy.data(), view.data());
+	EXPECT_EQ(copy.at(1).get_label(), SpikeLabel(3));
+}